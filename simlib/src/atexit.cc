@@ -20,7 +20,7 @@ SIMLIB_IMPLEMENTATION;
 
 static const int MAX_ATEXIT = 10; // for internal use it is enough
 static int counter = 0; // internal module counter
-static SIMLIB_atexit_function_t atexit_array[MAX_ATEXIT] = { 0, };
+static thread_local SIMLIB_atexit_function_t atexit_array[MAX_ATEXIT] = { 0, };
 
 // used in SIMLIB
 void SIMLIB_atexit(SIMLIB_atexit_function_t p) {
@@ -35,13 +35,15 @@ void SIMLIB_atexit(SIMLIB_atexit_function_t p) {
        SIMLIB_internal_error();
 }
 
-// used here
-static void SIMLIB_atexit_call() {
+// used here and by ~Simulator()
+void SIMLIB_atexit_call() {
     DEBUG(DBG_ATEXIT,("ATEXIT:"));
     for(int i=0; i<MAX_ATEXIT; i++)
        if(atexit_array[i]) {
            DEBUG(DBG_ATEXIT,("ATEXIT_CALL#%d: %p ", i, atexit_array[i]));
-           atexit_array[i]();
+           SIMLIB_atexit_function_t f = atexit_array[i];
+           atexit_array[i] = 0;  // can be registered again
+           f();
     }
 }
 
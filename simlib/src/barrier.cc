@@ -9,6 +9,9 @@
 //
 //  class Barrier implementation
 //
+//  waiting entities are stored in WaitQueue (no fixed size array),
+//  all of them are activated by single calendar operation at break
+//
 // TODO add method to set activation order - FIFO/LIFO
 
 ////////////////////////////////////////////////////////////////////////////
@@ -30,7 +33,7 @@ SIMLIB_IMPLEMENTATION;
 /// constructor
 //
 Barrier::Barrier(unsigned height):
-    waiting(0), n(0), maxn(height)
+    maxn(height)
 {
     Dprintf(("Barrier::Barrier()"));
     Init();
@@ -40,7 +43,7 @@ Barrier::Barrier(unsigned height):
 /// constructor with name parameter
 //
 Barrier::Barrier(const char *name, unsigned height):
-    waiting(0), n(0), maxn(height)
+    maxn(height)
 {
     Dprintf(("Barrier::Barrier(\"%s\")", name));
     SetName(name);
@@ -53,7 +56,6 @@ Barrier::Barrier(const char *name, unsigned height):
 //
 Barrier::~Barrier() {
     Dprintf(("Barrier::~Barrier()  // \"%s\" ", Name().c_str()));
-    delete[] waiting;
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -62,9 +64,8 @@ Barrier::~Barrier() {
 void Barrier::Enter(Entity * e) //TODO without parameter: use Current?
 {
     Dprintf(("Barrier\"%s\".Enter(%s)", Name().c_str(), e->Name().c_str()));
-    if (n < maxn - 1) {         // all waiting processes
-        waiting[n++] = e;
-        e->Passivate();
+    if (waiting.size() < maxn - 1) {    // all waiting processes
+        waiting.Wait(e);
     } else {                    // last process which breaks barrier
         Break();
         Current->Activate();    // re-activation of last process - FIFO order
@@ -78,9 +79,8 @@ void Barrier::Enter(Entity * e) //TODO without parameter: use Current?
 bool Barrier::Wait()
 {
     Dprintf(("Barrier\"%s\".Wait() for %s", Name().c_str(), Current->Name().c_str()));
-    if (n < maxn - 1) {         // all waiting processes
-        waiting[n++] = Current;
-        Current->Passivate();
+    if (waiting.size() < maxn - 1) {    // all waiting processes
+        waiting.Wait(Current);
         return false;
     } else {                    // last process which breaks barrier
         Break();
@@ -95,16 +95,7 @@ bool Barrier::Wait()
 /// Warning: can be called only by process not already waiting on barrier
 //
 int Barrier::Break() {
-    int ret = n;
-    if (n == 0)         // nothing to do
-        return ret;
-    for (unsigned i = 0; i < n; i++)    // FIFO order of activation
-    {
-        waiting[i]->Activate();
-        waiting[i] = 0;
-    }
-    n = 0;
-    return ret;
+    return waiting.ReleaseAll();        // FIFO order of activation
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -114,27 +105,20 @@ void Barrier::Init() {
     Dprintf(("%s.Init()", Name().c_str()));
     if (maxn < 1)
         Error("Barrier size less than 1");
-    waiting = new Entity *[maxn];       // allocation   maxn-1 ???
-//  if(!waiting) SIMLIB_error(MemoryError);  // if without exceptions
     Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////
 /// Change the height of barrier
+/// if the new height is already reached, the barrier is broken
 //
 void Barrier::ChangeHeight(unsigned new_height) {
     Dprintf(("%s.ChangeHeight(%u)", Name().c_str(), new_height));
-    if (new_height < n || new_height < 1)
+    if (new_height < 1)
         Error("Barrier height can not be changed");
-    Entity **new_w = new Entity *[new_height];  // allocation
-//  if(!new_w) SIMLIB_error(MemoryError);  // if compiled without exceptions
-    for (unsigned i = 0; i < n; i++)    // copy
-        new_w[i] = waiting[i];
-    delete [] waiting;    // free old array
-    waiting = new_w;
     maxn = new_height;  // new size
-    for (unsigned i = n; i < maxn; i++) // zero all non-used items
-        new_w[i] = 0;
+    if (waiting.size() >= maxn)
+        Break();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -143,9 +127,7 @@ void Barrier::ChangeHeight(unsigned new_height) {
 //
 void Barrier::Clear() {
     Dprintf(("%s.Clear()", Name().c_str()));
-    for (unsigned i = 0; i < maxn; i++)
-        waiting[i] = nullptr;
-    n = 0;
+    waiting.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -153,11 +135,9 @@ void Barrier::Clear() {
 //
 void Barrier::Output() const {
     Print("Barrier: %s\n", Name().c_str());
-    for (unsigned i = 0; i < maxn; i++)
-        if (waiting[i])
-            Print("%3d: %s\n", i, waiting[i]->Name().c_str());
-        else
-            Print("%3d: empty\n", i);
+    waiting.Output();
+    for (unsigned i = waiting.size(); i < maxn; i++)
+        Print("%3d: empty\n", i);
     Print("\n");
 }
 
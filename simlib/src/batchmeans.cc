@@ -0,0 +1,306 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file batchmeans.cc  Batch means with confidence interval
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class BatchMeans implementation, run-length control
+//
+//  Non-overlapping batch means with batch size doubling: batches are
+//  stored in array of size 2*maxb; when it is full, pairs of adjacent
+//  batches are merged. Confidence interval half-width:
+//
+//     t(1-(1-level)/2, k-1) * s / sqrt(k)
+//
+//  where k is number of batches and s is std. deviation of batch means.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cmath>        // sqrt, log, tan
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+static thread_local BatchMeans *targets = 0;         // objects with target precision
+static thread_local bool precision_stop = false;     // run-length control enabled
+
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_NormalQuantile --- quantile of standard normal distribution
+//
+// rational approximation by P. J. Acklam (relative error < 1.2e-9)
+//
+double SIMLIB_NormalQuantile(double p)
+{
+  static const double a[] = { -3.969683028665376e+01,  2.209460984245205e+02,
+                              -2.759285104469687e+02,  1.383577518672690e+02,
+                              -3.066479806614716e+01,  2.506628277459239e+00 };
+  static const double b[] = { -5.447609879822406e+01,  1.615858368580409e+02,
+                              -1.556989798598866e+02,  6.680131188771972e+01,
+                              -1.328068155288572e+01 };
+  static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01,
+                              -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00,  2.938163982698783e+00 };
+  static const double d[] = {  7.784695709041462e-03,  3.224671290700398e-01,
+                               2.445134137142996e+00,  3.754408661907416e+00 };
+  const double plow = 0.02425;
+  if (p <= 0 || p >= 1)
+    SIMLIB_error(BatchMeansError);
+  if (p < plow) {               // lower tail
+    double q = sqrt(-2 * log(p));
+    return (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+           ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1);
+  }
+  if (p > 1 - plow) {           // upper tail
+    double q = sqrt(-2 * log(1 - p));
+    return -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+            ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1);
+  }
+  double q = p - 0.5;           // central region
+  double r = q * q;
+  return (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q /
+         (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_StudentQuantile --- quantile of Student's t distribution
+//
+// exact for df=1,2; Cornish-Fisher expansion (Abramowitz-Stegun 26.7.5)
+// for df>=3 (error < 0.01 for df=3, p=0.975)
+//
+double SIMLIB_StudentQuantile(double p, unsigned long df)
+{
+  if (p <= 0 || p >= 1 || df == 0)
+    SIMLIB_error(BatchMeansError);
+  if (df == 1)
+    return tan(M_PI * (p - 0.5));
+  if (df == 2)
+    return (2 * p - 1) / sqrt(2 * p * (1 - p));
+  double z = SIMLIB_NormalQuantile(p);
+  double z2 = z * z;
+  double n = double(df);
+  double g1 = (z2 + 1) * z / 4;
+  double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+  double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+  double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+  return z + (g1 + (g2 + (g3 + g4 / n) / n) / n) / n;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetPrecisionStop --- enable/disable run-length control
+//
+void SetPrecisionStop(bool on)
+{
+  Dprintf(("SetPrecisionStop(%d)", int(on)));
+  precision_stop = on;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+BatchMeans::BatchMeans(unsigned batches, double lev) :
+  bm(0), nbm(0), maxb(batches),
+  bsize(1), bn(0), bsum(0),
+  level(lev), relprec(0), next(0)
+{
+  Dprintf(("BatchMeans::BatchMeans(%u,%g)", batches, lev));
+  Init();
+}
+
+BatchMeans::BatchMeans(const char *name, unsigned batches, double lev) :
+  Stat(name),
+  bm(0), nbm(0), maxb(batches),
+  bsize(1), bn(0), bsum(0),
+  level(lev), relprec(0), next(0)
+{
+  Dprintf(("BatchMeans::BatchMeans(\"%s\",%u,%g)", name, batches, lev));
+  Init();
+}
+
+void BatchMeans::Init()
+{
+  if (maxb < 2 || level <= 0 || level >= 1)
+    SIMLIB_error(BatchMeansError);
+  bm = new double[2 * maxb];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+BatchMeans::~BatchMeans()
+{
+  Dprintf(("BatchMeans::~BatchMeans() // \"%s\" ", Name().c_str()));
+  SetTarget(0);         // remove from list of targets
+  delete [] bm;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Clear --- initialize
+//
+void BatchMeans::Clear()
+{
+  Stat::Clear();
+  nbm = 0;
+  bsize = 1;
+  bn = 0;
+  bsum = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator ()  --- record value
+//
+void BatchMeans::operator () (double x)
+{
+  Stat::operator()(x);
+  bsum += x;
+  if (++bn == bsize)
+    Batch();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Batch --- close current batch, merge batches if array is full,
+//            check target precision of all objects
+//
+void BatchMeans::Batch()
+{
+  bm[nbm++] = bsum / bsize;
+  bsum = 0;
+  bn = 0;
+  if (nbm == 2 * maxb) {        // merge pairs, double batch size
+    for (unsigned i = 0; i < maxb; i++)
+      bm[i] = (bm[2*i] + bm[2*i + 1]) / 2;
+    nbm = maxb;
+    bsize *= 2;
+  }
+  if (relprec > 0 && precision_stop && SIMLIB_Phase == SIMULATION) {
+    for (BatchMeans *p = targets; p; p = p->next)
+      if (!p->Precise())
+        return;
+    Dprintf(("BatchMeans: target precision reached"));
+    Stop();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  BatchMean --- mean of i-th complete batch
+//
+double BatchMeans::BatchMean(unsigned i) const
+{
+  if (i >= nbm)
+    SIMLIB_error(BatchMeansError);
+  return bm[i];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  GrandMean --- mean of complete batches
+//
+double BatchMeans::GrandMean() const
+{
+  if (nbm == 0)
+    SIMLIB_error(StatNoRecError);
+  double s = 0;
+  for (unsigned i = 0; i < nbm; i++)
+    s += bm[i];
+  return s / nbm;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  HalfWidth --- half-width of confidence interval of mean
+//
+double BatchMeans::HalfWidth() const
+{
+  if (nbm < 2)
+    SIMLIB_error(StatDispError);
+  double mv = GrandMean();
+  double s2 = 0;
+  for (unsigned i = 0; i < nbm; i++)
+    s2 += (bm[i] - mv) * (bm[i] - mv);
+  s2 /= nbm - 1;
+  double t = SIMLIB_StudentQuantile(1 - (1 - level) / 2, nbm - 1);
+  return t * sqrt(s2 / nbm);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetTarget --- set target relative precision (0 = no target)
+//
+void BatchMeans::SetTarget(double rp)
+{
+  Dprintf(("%s.SetTarget(%g)", Name().c_str(), rp));
+  if (rp < 0)
+    SIMLIB_error(BatchMeansError);
+  if (relprec > 0) {            // remove from list
+    BatchMeans **p = &targets;
+    while (*p != this)
+      p = &(*p)->next;
+    *p = next;
+    next = 0;
+  }
+  relprec = rp;
+  if (relprec > 0) {            // insert into list
+    next = targets;
+    targets = this;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Precise --- target precision reached (at least `batches` batches)
+//
+bool BatchMeans::Precise() const
+{
+  if (relprec <= 0 || nbm < maxb)
+    return false;
+  return HalfWidth() <= relprec * fabs(GrandMean());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print statistics and confidence interval
+//
+void BatchMeans::Output() const
+{
+  char s[100];
+  Print("+----------------------------------------------------------+\n");
+  Print("| BATCH MEANS %-44s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  if (n == 0)
+    Print("|  no record                                               |\n");
+  else
+  {
+    Print(  "|  Min = %-15g         Max = %-15g     |\n", min, max);
+    Print(  "|  Number of records = %-26ld          |\n", n);
+    Print(  "|  Average value = %-25g               |\n", MeanValue());
+    sprintf(s, " Batches = %u x %lu ", nbm, bsize);
+    Print(  "| %-56s |\n", s);
+    if (nbm >= 2) {
+      double mv = GrandMean();
+      double hw = HalfWidth();
+      sprintf(s, " Mean of batches = %g +- %g (%g%%) ", mv, hw, level * 100);
+      Print("| %-56s |\n", s);
+      if (mv != 0) {
+        sprintf(s, " Relative precision = %g ", hw / fabs(mv));
+        Print("| %-56s |\n", s);
+      }
+    }
+    if (relprec > 0) {
+      sprintf(s, " Target precision = %g (%s) ", relprec,
+              Precise() ? "reached" : "not reached");
+      Print("| %-56s |\n", s);
+    }
+  }
+  Print("+----------------------------------------------------------+\n");
+}
+
+} // namespace
+
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file branch.cc  Branching of simulation into scenarios
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  Branch, BranchNumber, WaitBranches implementation (POSIX fork)
+//
+//  The common history of scenarios is simulated once; at branching time
+//  the process is cloned by fork(), so each branch continues from the
+//  same state (memory is shared copy-on-write). Process ids of branches
+//  are kept for WaitBranches(), which is called at exit, too.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cstdio>       // fflush
+#include <cstdlib>      // atexit
+#include <vector>
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+# define SIMLIB_HAVE_FORK 1
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+static unsigned branch_number = 0;      // number of this branch
+
+#ifdef SIMLIB_HAVE_FORK
+
+static std::vector<pid_t> branches;     // children of this process
+
+static void WaitAtExit()
+{
+  WaitBranches();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Branch --- clone simulation into k branches
+//
+unsigned Branch(unsigned k, void (*fn)(unsigned b))
+{
+  Dprintf(("Branch(%u) at %g", k, double(Time)));
+  if (k == 0)
+    SIMLIB_error(BranchError);
+  static bool registered = false;
+  if (!registered) {
+    std::atexit(WaitAtExit);
+    registered = true;
+  }
+  unsigned b = 0;
+  for (unsigned i = 1; i < k; i++) {
+    fflush(0);                  // no duplicate output of buffers
+    pid_t pid = fork();
+    if (pid < 0)
+      SIMLIB_error(BranchError);
+    if (pid == 0) {             // new branch
+      branches.clear();         // siblings are not our children
+      b = i;
+      break;
+    }
+    branches.push_back(pid);
+  }
+  branch_number = b;
+  if (fn)
+    fn(b);
+  return b;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  WaitBranches --- wait for end of all branches of this process
+//
+unsigned WaitBranches()
+{
+  unsigned failed = 0;
+  for (size_t i = 0; i < branches.size(); i++) {
+    int status;
+    if (waitpid(branches[i], &status, 0) < 0 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      ++failed;
+  }
+  branches.clear();
+  return failed;
+}
+
+#else // no fork()
+
+unsigned Branch(unsigned k, void (*fn)(unsigned b))
+{
+  if (k != 1)
+    SIMLIB_error(BranchError);
+  if (fn)
+    fn(0);
+  return 0;
+}
+
+unsigned WaitBranches()
+{
+  return 0;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+//  BranchNumber --- number of current branch
+//
+unsigned BranchNumber()
+{
+  return branch_number;
+}
+
+} // namespace
+
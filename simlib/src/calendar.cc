@@ -70,6 +70,11 @@ class Calendar { // abstract base class
     unsigned Size()  const { return _size; }
     /// enqueue
     virtual void     ScheduleAt(Entity *e, double t) = 0;
+    /// enqueue n entities at the same time t (FIFO order)
+    virtual void     ScheduleBatch(Entity *const *e, unsigned n, double t) {
+        for (unsigned i = 0; i < n; ++i)
+            ScheduleAt(e[i], t);
+    }
     /// dequeue first
     virtual Entity * GetFirst() = 0;
     /// dequeue
@@ -106,7 +111,7 @@ class Calendar { // abstract base class
     virtual ~Calendar() {} //!< clear is called in derived class dtr
     static void delete_instance();      //!< destroy single instance
   private:
-    static Calendar * _instance;        //!< pointer to single instance
+    SIMLIB_CONSTINIT static thread_local Calendar * _instance;        //!< pointer to single instance
   ///////////////////////////////////////////////////////////////////////////
   friend void SetCalendar(const char *name); // sets _instance
 };
@@ -201,10 +206,8 @@ class EventNoticeAllocator {
     EventNoticeLinkBase *l; // single-linked list of freed items
     unsigned freed;
   public:
-    EventNoticeAllocator(): l(0), freed(0) {}
-    ~EventNoticeAllocator() {
-        clear();  // delete freelist
-    }
+    // trivial destructor: freelist is deleted by calendar destructor
+    constexpr EventNoticeAllocator(): l(0), freed(0) {}
 
     /// free EventNotice, add to freelist for future allocation
     void free(EventNotice *en) {
@@ -242,7 +245,9 @@ class EventNoticeAllocator {
             delete p;
         }
     }
-} allocator;  // global allocator TODO: improve -> singleton
+};
+
+SIMLIB_CONSTINIT static thread_local EventNoticeAllocator allocator;  // allocator of current thread
 
 
 
@@ -261,6 +266,10 @@ class EventNoticeAllocator {
 //
 // no checking
 //
+
+/// priority of the last item removed by remove_first()
+SIMLIB_CONSTINIT static thread_local Entity::Priority_t removed_priority = 0;
+
 class CalendarListImplementation {
     EventNoticeLinkBase l;  //!< head of circular list
   public:
@@ -314,6 +323,18 @@ public:
       evn->insert(*pos); // insert before pos
     }
 
+    /// enqueue n entities at the same time t
+    /// search is done only if priority differs from previous entity
+    void insert_batch(Entity *const *e, unsigned n, double t) {
+      iterator pos = end();
+      for (unsigned i = 0; i < n; ++i) {
+        EventNotice *evn = EventNotice::Create(e[i],t);
+        if (i == 0 || evn->priority != e[i-1]->Priority)
+          pos = search(evn);
+        evn->insert(*pos); // insert before pos (after previous one)
+      }
+    }
+
     /// special dequeue operation for rescheduling
     Entity *remove(Entity *e) {
       EventNotice::Destroy(e->GetEventNotice());   // disconnect, remove item
@@ -323,6 +344,7 @@ public:
     /// dequeue operation
     Entity *remove_first() {
       Entity *e = first()->entity;
+      removed_priority = first()->priority;    // see SQS::GetFirst(p)
       EventNotice::Destroy(first());   // disconnect, remove item
       return e;
     }
@@ -366,6 +388,7 @@ class CalendarList : public Calendar {
   public:
     /// enqueue
     virtual void ScheduleAt(Entity *p, double t) override;
+    virtual void ScheduleBatch(Entity *const *e, unsigned n, double t) override;
 
     /// dequeue
     virtual Entity *Get(Entity *p) override;              // remove process p from calendar
@@ -451,6 +474,21 @@ void CalendarList::ScheduleAt(Entity *e, double t)
       SetMinTime(l.first_time());
 }
 
+////////////////////////////////////////////////////////////////////////////
+///  schedule n entities at time t (single search for equal priorities)
+void CalendarList::ScheduleBatch(Entity *const *e, unsigned n, double t)
+{
+  if(n == 0)
+      return;
+  if(t<Time)
+      SIMLIB_error(SchedulingBeforeTime);
+  l.insert_batch(e,n,t);
+  _size += n;
+  // update mintime:
+  if(t < MinTime())
+      SetMinTime(l.first_time());
+}
+
 ////////////////////////////////////////////////////////////////////////////
 /// delete first entity
 Entity *CalendarList::GetFirst()
@@ -583,6 +621,7 @@ class CalendarQueue : public Calendar {
   public:
     /// enqueue
     virtual void ScheduleAt(Entity *p, double t) override;
+    virtual void ScheduleBatch(Entity *const *e, unsigned n, double t) override;
 
     /// dequeue
     virtual Entity *Get(Entity *p) override;              // remove process p from calendar
@@ -677,6 +716,25 @@ void CalendarQueue::ScheduleAt(Entity *e, double t)
     }
 }
 
+/// schedule n entities at time t
+void CalendarQueue::ScheduleBatch(Entity *const *e, unsigned n, double t)
+{
+    Dprintf(("CalendarQueue::ScheduleBatch(%u,%g)", n, t));
+    if(!list_impl() || _size + n > LIST_MAX) { // bucket insert for each
+        Calendar::ScheduleBatch(e,n,t);
+        return;
+    }
+    if(n == 0)
+        return;
+    if(t<Time)
+        SIMLIB_error(SchedulingBeforeTime);
+    list.insert_batch(e,n,t);
+    _size += n;
+    if (MinTime() > t) {
+        SetMinTime(t);
+    }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 ///  dequeue
@@ -1198,7 +1256,7 @@ void CalendarQueue::visualize(const char *msg)
 ////////////////////////////////////////////////////////////////////////////
 
 /// static pointer to singleton instance
-Calendar * Calendar::_instance = 0;
+SIMLIB_CONSTINIT thread_local Calendar * Calendar::_instance = 0;
 
 /// interface to singleton instance
 inline Calendar * Calendar::instance() {
@@ -1304,6 +1362,18 @@ OP_MEASURE=0;
   _SetTime(NextTime, Calendar::instance()->MinTime());
 }
 
+/// schedule n entities at the same time t (single calendar operation)
+/// @param e array of entities (activated in this order for equal priority)
+/// @param n number of entities
+/// @param t time of activation
+void SQS::ScheduleBatch(Entity *const *e, unsigned n, double t) {
+  for(unsigned i = 0; i < n; ++i)
+    if(!e[i]->Idle())
+      SIMLIB_error("ScheduleAt call if already scheduled");
+  Calendar::instance()->ScheduleBatch(e,n,t);
+  _SetTime(NextTime, Calendar::instance()->MinTime());
+}
+
 /// remove selected entity activation record from calendar
 void SQS::Get(Entity *e) {             // used by Run() only
 #ifdef MEASURE
@@ -1342,6 +1412,14 @@ OP_MEASURE=0;
   return ret;
 }
 
+/// remove entity with minimum activation time
+/// @param p  scheduling priority of removed activation record
+Entity *SQS::GetFirst(Entity::Priority_t &p) {  // used by checkpoint
+  Entity *e = GetFirst();
+  p = removed_priority;
+  return e;
+}
+
 /// remove all scheduled entities
 void SQS::Clear() {                       // remove all
   Calendar::instance()->clear(true);
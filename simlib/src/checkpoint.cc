@@ -0,0 +1,822 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file checkpoint.cc  Event-only checkpoint/restore of simulation state
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  SaveEventCheckpoint, RestoreEventCheckpoint, CheckpointRegister implementation
+//
+//  The restoring program builds the same model (objects, Init()) and the
+//  state of registered objects is loaded from file. Binary file (the same
+//  program on the same machine reads it):
+//
+//     header:   magic, format, SIMLIB version
+//     time:     StartTime, Time, EndTime, integration step variables
+//     random:   default stream, master seed
+//     samplers: on, last, step of all Samplers
+//     entities: key (registered) or class name (CheckpointClass) or
+//               Sampler number, attributes, class data; entity counter
+//     calendar: entity number, activation time, priority
+//     objects:  key, length, data of registered object
+//
+//  Entities are referenced by number in entity table. Context of started
+//  process contains stack with absolute addresses (frames, pointers to
+//  heap objects of the saving program), it can not be moved to other
+//  program instance, not even of the same binary. The checkpoint is
+//  event-only: Events and prepared (not started) Processes are saved,
+//  a started process is an error (CheckpointProcessError).
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cstdio>       // FILE
+#include <cstring>      // memcpy
+#include <map>
+#include <set>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+////////////////////////////////////////////////////////////////////////////
+//  CheckpointData
+//
+void CheckpointData::Data(void *p, size_t n)
+{
+  if (saving) {
+    buf.append(static_cast<const char*>(p), n);
+    return;
+  }
+  if (buf.size() - pos < n)
+    SIMLIB_error(CheckpointFileError);
+  std::memcpy(p, buf.data() + pos, n);
+  pos += n;
+}
+
+void CheckpointData::Value(std::string &s)
+{
+  unsigned long long n = s.size();
+  Value(n);
+  if (saving) {
+    buf.append(s);
+    return;
+  }
+  if (buf.size() - pos < n)
+    SIMLIB_error(CheckpointFileError);
+  s.assign(buf, pos, n);
+  pos += n;
+}
+
+namespace {
+
+const char MAGIC[8] = { 'S','I','M','L','I','B','C','P' };
+const unsigned FORMAT = 1;
+const unsigned long long NONE = ~0ULL;  // null entity reference
+
+enum ItemType { USER, ENTITY, QUEUE, FACILITY, STORE,
+                STAT, TSTAT, HISTOGRAM, STREAM, INTEGRATOR };
+
+struct Item {                   // registered object
+  std::string key;
+  ItemType type;
+  void *obj;
+  CheckpointFunction f;         // USER only
+};
+
+struct Class {                  // registered class of entities
+  std::string name;
+  const std::type_info *type;
+  Entity *(*create)();
+  std::function<void(CheckpointData &, Entity &)> data;
+};
+
+enum EntityKind { REGISTERED, INSTANCE, SAMPLER };
+
+struct Registry {                // registrations of current thread
+  std::vector<Item> items;
+  std::vector<Class> classes;
+};
+thread_local Registry *registry = 0;    // deleted by CheckpointClear()
+thread_local std::string pending;       // file requested during Run()
+
+// entity table of checkpoint being written/read
+thread_local std::vector<Entity*> table;
+thread_local std::map<Entity*, unsigned long long> numbers;    // writing
+
+Registry &Reg()
+{
+  if (registry == 0) {
+    registry = new Registry;
+    SIMLIB_atexit(CheckpointClear);     // at exit or end of Simulator
+  }
+  return *registry;
+}
+
+const Item *FindItem(const std::string &key)
+{
+  std::vector<Item> &items = Reg().items;
+  for (size_t i = 0; i < items.size(); i++)
+    if (items[i].key == key)
+      return &items[i];
+  return 0;
+}
+
+const Item *FindObject(void *obj)
+{
+  std::vector<Item> &items = Reg().items;
+  for (size_t i = 0; i < items.size(); i++)
+    if (items[i].obj == obj)
+      return &items[i];
+  return 0;
+}
+
+const Class *FindClass(const std::type_info &t)
+{
+  std::vector<Class> &classes = Reg().classes;
+  for (size_t i = 0; i < classes.size(); i++)
+    if (*classes[i].type == t)
+      return &classes[i];
+  return 0;
+}
+
+const Class *FindClass(const std::string &name)
+{
+  std::vector<Class> &classes = Reg().classes;
+  for (size_t i = 0; i < classes.size(); i++)
+    if (classes[i].name == name)
+      return &classes[i];
+  return 0;
+}
+
+void Register(const char *key, ItemType type, void *obj, CheckpointFunction f)
+{
+  if (key == 0 || *key == 0 || FindItem(key) || (obj && FindObject(obj)))
+    SIMLIB_error(CheckpointError);
+  Item i = { key, type, obj, f };
+  Reg().items.push_back(i);
+}
+
+struct Scheduled {              // calendar item
+  Entity *e;
+  double t;
+  Entity::Priority_t priority;
+};
+
+// Schedule --- insert entity with given priority of activation record
+void Schedule(Entity *e, double t, Entity::Priority_t priority)
+{
+  Entity::Priority_t p = e->Priority;
+  e->Priority = priority;
+  SQS::ScheduleAt(e, t);
+  e->Priority = p;
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_Checkpoint --- access to internal data of objects
+//
+struct SIMLIB_Checkpoint {
+  static bool Saved(Entity *e);
+  static void Attributes(CheckpointData &d, Entity &e);
+  static void Ref(CheckpointData &d, Entity *&e);
+  static void Entities(CheckpointData &d, Queue &q);
+  static void Object(CheckpointData &d, const Item &i);
+  template <class T> static void Stats(CheckpointData &d, T &s);
+  static void Collect(Queue &q);
+  static void Collect(const Item &i);
+  static void Discard(Queue &q, std::set<Entity*> &s);
+  static void Discard(const Item &i, std::set<Entity*> &s);
+  static void Samplers(CheckpointData &d);
+  static Sampler *SamplerAt(unsigned long long n);
+  static unsigned long long SamplerNumber(Sampler *s);
+  static void Write(const char *filename);
+  static void Read(const char *filename);
+};
+
+// Saved --- entity can be saved (Event or prepared Process)
+bool SIMLIB_Checkpoint::Saved(Entity *e)
+{
+  Process *p = dynamic_cast<Process*>(e);
+  return p == 0 || p->isPrepared();
+}
+
+// add entity to table
+static void Add(Entity *e)
+{
+  if (numbers.count(e))
+    return;
+  if (!SIMLIB_Checkpoint::Saved(e))
+    SIMLIB_error(CheckpointProcessError);
+  numbers[e] = table.size();
+  table.push_back(e);
+}
+
+// attributes of entity (the union is copied as raw data)
+void SIMLIB_Checkpoint::Attributes(CheckpointData &d, Entity &e)
+{
+  d.Value(e._Ident);
+  d.Value(e.Priority);
+  d.Value(e._MarkTime);
+  d.Data(&e._RemainingTime, sizeof(e._RemainingTime));
+  d.Value(e._SPrio);
+  std::string stream;
+  if (d.Saving() && e._RandomStream) {
+    const Item *i = FindObject(e._RandomStream);
+    if (i == 0 || i->type != STREAM)
+      SIMLIB_error(CheckpointError);    // stream not registered
+    stream = i->key;
+  }
+  d.Value(stream);
+  if (!d.Saving()) {
+    e._RandomStream = 0;
+    if (!stream.empty()) {
+      const Item *i = FindItem(stream);
+      if (i == 0 || i->type != STREAM)
+        SIMLIB_error(CheckpointFileError);
+      e._RandomStream = static_cast<RandomStream*>(i->obj);
+    }
+  }
+}
+
+// reference to entity (number in table)
+void SIMLIB_Checkpoint::Ref(CheckpointData &d, Entity *&e)
+{
+  unsigned long long n = NONE;
+  if (d.Saving() && e)
+    n = numbers[e];
+  d.Value(n);
+  if (!d.Saving()) {
+    if (n != NONE && n >= table.size())
+      SIMLIB_error(CheckpointFileError);
+    e = (n == NONE) ? 0 : table[n];
+  }
+}
+
+// contents and statistics of queue
+void SIMLIB_Checkpoint::Entities(CheckpointData &d, Queue &q)
+{
+  unsigned long long n = q.size();
+  d.Value(n);
+  if (d.Saving()) {
+    for (Queue::iterator p = q.begin(); p != q.end(); ++p) {
+      Entity *e = static_cast<Entity*>(*p);
+      Ref(d, e);
+    }
+  } else {
+    for (unsigned long long k = 0; k < n; k++) {
+      Entity *e;
+      Ref(d, e);
+      if (e == 0)
+        SIMLIB_error(CheckpointFileError);
+      q.List::InsLast(e);       // no statistics, _MarkTime restored
+    }
+  }
+  Stats(d, q.StatN);
+  Stats(d, q.StatDT);
+}
+
+// statistics (SIMLIB_Snapshot data)
+template <class T> void SIMLIB_Checkpoint::Stats(CheckpointData &d, T &s)
+{
+  size_t n = SIMLIB_Snapshot::Size(s);
+  if (d.Saving()) {
+    size_t k = d.buf.size();
+    d.buf.resize(k + n);
+    char *p = &d.buf[k];
+    SIMLIB_Snapshot::Save(s, p);
+  } else {
+    if (d.buf.size() - d.pos < n)
+      SIMLIB_error(CheckpointFileError);
+    const char *p = d.buf.data() + d.pos;
+    SIMLIB_Snapshot::Load(s, p);
+    d.pos += n;
+  }
+}
+
+// data of registered object
+void SIMLIB_Checkpoint::Object(CheckpointData &d, const Item &i)
+{
+  switch (i.type) {
+    case USER:
+      i.f(d);
+      break;
+    case QUEUE:
+      Entities(d, *static_cast<Queue*>(i.obj));
+      break;
+    case FACILITY: {
+      Facility *f = static_cast<Facility*>(i.obj);
+      Ref(d, f->in);
+      if (f->OwnQueue())
+        Entities(d, *f->Q1);
+      Entities(d, *f->Q2);
+      Stats(d, f->tstat);
+      break;
+    }
+    case STORE: {
+      Store *s = static_cast<Store*>(i.obj);
+      d.Value(s->capacity);
+      d.Value(s->used);
+      if (s->OwnQueue())
+        Entities(d, *s->Q);
+      Stats(d, s->tstat);
+      break;
+    }
+    case STAT:
+      Stats(d, *static_cast<Stat*>(i.obj));
+      break;
+    case TSTAT:
+      Stats(d, *static_cast<TStat*>(i.obj));
+      break;
+    case HISTOGRAM:
+      Stats(d, *static_cast<Histogram*>(i.obj));
+      break;
+    case STREAM:
+      d.Value(*static_cast<RandomStream*>(i.obj));
+      break;
+    case INTEGRATOR: {
+      Integrator *x = static_cast<Integrator*>(i.obj);
+      double s = x->GetState(), sl = x->GetOldState();
+      double dd = x->GetDiff(), ddl = x->GetOldDiff();
+      d.Value(s);
+      d.Value(sl);
+      d.Value(dd);
+      d.Value(ddl);
+      x->SetState(s);
+      x->SetOldState(sl);
+      x->SetDiff(dd);
+      x->SetOldDiff(ddl);
+      break;
+    }
+    case ENTITY:
+      break;                    // in entity table
+  }
+}
+
+// Collect --- add entities referenced by object to table
+void SIMLIB_Checkpoint::Collect(Queue &q)
+{
+  for (Queue::iterator p = q.begin(); p != q.end(); ++p)
+    Add(static_cast<Entity*>(*p));
+}
+
+void SIMLIB_Checkpoint::Collect(const Item &i)
+{
+  switch (i.type) {
+    case ENTITY:
+      Add(static_cast<Entity*>(i.obj));
+      break;
+    case QUEUE:
+      Collect(*static_cast<Queue*>(i.obj));
+      break;
+    case FACILITY: {
+      Facility *f = static_cast<Facility*>(i.obj);
+      if (f->in)
+        Add(f->in);
+      if (f->OwnQueue())
+        Collect(*f->Q1);
+      Collect(*f->Q2);
+      break;
+    }
+    case STORE: {
+      Store *s = static_cast<Store*>(i.obj);
+      if (s->OwnQueue())
+        Collect(*s->Q);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+// Discard --- remove entities of new model from object
+void SIMLIB_Checkpoint::Discard(Queue &q, std::set<Entity*> &s)
+{
+  while (!q.empty())
+    s.insert(static_cast<Entity*>(q.List::GetFirst()));
+}
+
+void SIMLIB_Checkpoint::Discard(const Item &i, std::set<Entity*> &s)
+{
+  switch (i.type) {
+    case QUEUE:
+      Discard(*static_cast<Queue*>(i.obj), s);
+      break;
+    case FACILITY: {
+      Facility *f = static_cast<Facility*>(i.obj);
+      if (f->in)
+        s.insert(f->in);
+      f->in = 0;
+      if (f->OwnQueue())
+        Discard(*f->Q1, s);
+      Discard(*f->Q2, s);
+      break;
+    }
+    case STORE: {
+      Store *st = static_cast<Store*>(i.obj);
+      if (st->OwnQueue())
+        Discard(*st->Q, s);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+// state of all Samplers (they are not registered)
+void SIMLIB_Checkpoint::Samplers(CheckpointData &d)
+{
+  unsigned long long n = 0;
+  for (Sampler *s = Sampler::First; s; s = s->Next)
+    n++;
+  unsigned long long saved = n;
+  d.Value(saved);
+  if (saved != n)
+    SIMLIB_error(CheckpointFileError);
+  for (Sampler *s = Sampler::First; s; s = s->Next) {
+    d.Value(s->on);
+    d.Value(s->last);
+    d.Value(s->step);
+  }
+}
+
+Sampler *SIMLIB_Checkpoint::SamplerAt(unsigned long long n)
+{
+  Sampler *s = Sampler::First;
+  for (; s && n > 0; n--)
+    s = s->Next;
+  if (s == 0)
+    SIMLIB_error(CheckpointFileError);
+  return s;
+}
+
+unsigned long long SIMLIB_Checkpoint::SamplerNumber(Sampler *s)
+{
+  unsigned long long n = 0;
+  for (Sampler *i = Sampler::First; i != s; i = i->Next)
+    n++;
+  return n;
+}
+
+// common part of checkpoint (the same order for Write and Read)
+static void Header(CheckpointData &d)
+{
+  char magic[sizeof(MAGIC)];
+  std::memcpy(magic, MAGIC, sizeof(MAGIC));
+  unsigned format = FORMAT;
+  unsigned version = SIMLIB_version;
+  d.Value(magic);
+  d.Value(format);
+  d.Value(version);
+  if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      format != FORMAT || version != SIMLIB_version)
+    SIMLIB_error(CheckpointFileError);
+  d.Value(StartTime);
+  d.Value(Time);
+  d.Value(EndTime);
+  d.Value(StepSize);
+  d.Value(OptStep);
+  d.Value(MinStep);
+  d.Value(MaxStep);
+  d.Value(AbsoluteError);
+  d.Value(RelativeError);
+  d.Value(SIMLIB_RandomDefault());
+  unsigned long long master = SIMLIB_RandomMasterSeed();
+  d.Value(master);
+  SIMLIB_RandomSetMasterSeed(master);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Write --- write checkpoint file
+//
+void SIMLIB_Checkpoint::Write(const char *filename)
+{
+  std::vector<Item> &items = Reg().items;
+  Dprintf(("SaveEventCheckpoint(\"%s\") at %g", filename, double(Time)));
+  std::string buf;
+  CheckpointData d(buf, true);
+  Header(d);
+  Samplers(d);
+  // entities: registered, scheduled, waiting in queues
+  table.clear();
+  numbers.clear();
+  std::vector<Scheduled> cal;
+  while (!SQS::Empty()) {              // remove all, then the same order
+    Scheduled s;
+    s.t = NextTime;
+    s.e = SQS::GetFirst(s.priority);
+    cal.push_back(s);
+  }
+  for (size_t k = 0; k < cal.size(); k++)       // the same order
+    Schedule(cal[k].e, cal[k].t, cal[k].priority);
+  for (size_t k = 0; k < items.size(); k++)
+    if (items[k].type == ENTITY)
+      Add(static_cast<Entity*>(items[k].obj));
+  for (size_t k = 0; k < cal.size(); k++)
+    Add(cal[k].e);
+  for (size_t k = 0; k < items.size(); k++)
+    Collect(items[k]);
+  unsigned long long n = table.size();
+  d.Value(n);
+  for (size_t k = 0; k < table.size(); k++) {
+    Entity *e = table[k];
+    const Item *i = FindObject(e);
+    const Class *c = FindClass(typeid(*e));
+    Sampler *s = dynamic_cast<Sampler*>(e);
+    unsigned char kind;
+    std::string name;
+    unsigned long long number = 0;
+    if (i && i->type == ENTITY) {
+      kind = REGISTERED;
+      name = i->key;
+    } else if (s) {
+      kind = SAMPLER;
+      number = SamplerNumber(s);
+    } else if (c) {
+      kind = INSTANCE;
+      name = c->name;
+    } else
+      SIMLIB_error(CheckpointEntityError);
+    d.Value(kind);
+    if (kind == SAMPLER)
+      d.Value(number);
+    else
+      d.Value(name);
+    Attributes(d, *e);
+    if (kind != SAMPLER && c && c->data)
+      c->data(d, *e);
+  }
+  d.Value(SIMLIB_Entity_Count);
+  // calendar
+  n = cal.size();
+  d.Value(n);
+  for (size_t k = 0; k < cal.size(); k++) {
+    unsigned long long x = numbers[cal[k].e];
+    d.Value(x);
+    d.Value(cal[k].t);
+    d.Value(cal[k].priority);
+  }
+  // objects
+  n = 0;
+  for (size_t k = 0; k < items.size(); k++)
+    if (items[k].type != ENTITY)
+      n++;
+  d.Value(n);
+  for (size_t k = 0; k < items.size(); k++) {
+    if (items[k].type == ENTITY)
+      continue;
+    std::string key = items[k].key;
+    d.Value(key);
+    unsigned long long length = 0;
+    size_t at = buf.size();
+    d.Value(length);
+    Object(d, items[k]);
+    length = buf.size() - at - sizeof(length);
+    std::memcpy(&buf[at], &length, sizeof(length));
+  }
+  table.clear();
+  numbers.clear();
+  FILE *f = std::fopen(filename, "wb");
+  if (f == 0)
+    SIMLIB_error(CheckpointFileError);
+  bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+  if (std::fclose(f) != 0 || !ok)
+    SIMLIB_error(CheckpointFileError);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Read --- read checkpoint file
+//
+void SIMLIB_Checkpoint::Read(const char *filename)
+{
+  std::vector<Item> &items = Reg().items;
+  Dprintf(("RestoreEventCheckpoint(\"%s\")", filename));
+  std::string buf;
+  FILE *f = std::fopen(filename, "rb");
+  if (f == 0)
+    SIMLIB_error(CheckpointFileError);
+  char tmp[4096];
+  size_t k;
+  while ((k = std::fread(tmp, 1, sizeof(tmp), f)) > 0)
+    buf.append(tmp, k);
+  bool ok = !std::ferror(f);
+  std::fclose(f);
+  if (!ok)
+    SIMLIB_error(CheckpointFileError);
+  CheckpointData d(buf, false);
+  Header(d);
+  Samplers(d);
+  // remove entities of new model (scheduled by Init() etc.)
+  std::set<Entity*> old;
+  while (!SQS::Empty())
+    old.insert(SQS::GetFirst());
+  for (k = 0; k < items.size(); k++)
+    Discard(items[k], old);
+  for (std::set<Entity*>::iterator e = old.begin(); e != old.end(); ++e) {
+    const Item *i = FindObject(*e);
+    if ((*e)->isAllocated() && !(i && i->type == ENTITY) &&
+        !dynamic_cast<Sampler*>(*e))
+      delete *e;
+  }
+  // entities
+  table.clear();
+  unsigned long long n;
+  d.Value(n);
+  for (unsigned long long j = 0; j < n; j++) {
+    unsigned char kind;
+    d.Value(kind);
+    Entity *e = 0;
+    if (kind == SAMPLER) {
+      unsigned long long number;
+      d.Value(number);
+      e = SamplerAt(number);
+    } else {
+      std::string name;
+      d.Value(name);
+      if (kind == REGISTERED) {
+        const Item *i = FindItem(name);
+        if (i == 0 || i->type != ENTITY)
+          SIMLIB_error(CheckpointFileError);
+        e = static_cast<Entity*>(i->obj);
+      } else if (kind == INSTANCE) {
+        const Class *c = FindClass(name);
+        if (c == 0)
+          SIMLIB_error(CheckpointFileError);
+        e = c->create();
+      } else
+        SIMLIB_error(CheckpointFileError);
+    }
+    Attributes(d, *e);
+    const Class *c = FindClass(typeid(*e));
+    if (kind != SAMPLER && c && c->data)
+      c->data(d, *e);
+    table.push_back(e);
+  }
+  d.Value(SIMLIB_Entity_Count);         // after creation of entities
+  // calendar
+  d.Value(n);
+  for (unsigned long long j = 0; j < n; j++) {
+    unsigned long long x;
+    double t;
+    Entity::Priority_t p;
+    d.Value(x);
+    d.Value(t);
+    d.Value(p);
+    if (x >= table.size() || !table[x]->Idle())
+      SIMLIB_error(CheckpointFileError);
+    Schedule(table[x], t, p);
+  }
+  // objects
+  d.Value(n);
+  unsigned long long objects = 0;
+  for (k = 0; k < items.size(); k++)
+    if (items[k].type != ENTITY)
+      objects++;
+  if (n != objects)
+    SIMLIB_error(CheckpointFileError);
+  for (unsigned long long j = 0; j < n; j++) {
+    std::string key;
+    unsigned long long length;
+    d.Value(key);
+    d.Value(length);
+    const Item *i = FindItem(key);
+    if (i == 0 || i->type == ENTITY)
+      SIMLIB_error(CheckpointFileError);
+    size_t at = d.pos;
+    Object(d, *i);
+    if (d.pos - at != length)
+      SIMLIB_error(CheckpointFileError);
+  }
+  if (d.pos != buf.size())
+    SIMLIB_error(CheckpointFileError);
+  table.clear();
+  SIMLIB_Restored = true;               // Run() continues
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  CheckpointRegister --- register model object
+//
+void CheckpointRegister(const char *key, CheckpointFunction f)
+{
+  if (f == 0)
+    SIMLIB_error(CheckpointError);
+  Register(key, USER, 0, f);
+}
+
+void CheckpointRegister(const char *key, Entity &e)
+{
+  Register(key, ENTITY, &e, 0);
+}
+
+void CheckpointRegister(const char *key, Queue &q)
+{
+  Register(key, QUEUE, &q, 0);
+}
+
+void CheckpointRegister(const char *key, Facility &f)
+{
+  Register(key, FACILITY, &f, 0);
+}
+
+void CheckpointRegister(const char *key, Store &s)
+{
+  Register(key, STORE, &s, 0);
+}
+
+void CheckpointRegister(const char *key, Stat &s)
+{
+  Register(key, STAT, &s, 0);
+}
+
+void CheckpointRegister(const char *key, TStat &s)
+{
+  Register(key, TSTAT, &s, 0);
+}
+
+void CheckpointRegister(const char *key, Histogram &h)
+{
+  Register(key, HISTOGRAM, &h, 0);
+}
+
+void CheckpointRegister(const char *key, RandomStream &s)
+{
+  Register(key, STREAM, &s, 0);
+}
+
+void CheckpointRegister(const char *key, Integrator &i)
+{
+  Register(key, INTEGRATOR, &i, 0);
+}
+
+void SIMLIB_CheckpointClass(const std::type_info &t, const char *name,
+                            Entity *(*create)(),
+                            std::function<void(CheckpointData &, Entity &)> data)
+{
+  if (name == 0 || *name == 0 || FindClass(t) || FindClass(std::string(name)))
+    SIMLIB_error(CheckpointError);
+  Class c = { name, &t, create, data };
+  Reg().classes.push_back(c);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  CheckpointClear --- remove all registrations
+//
+void CheckpointClear()
+{
+  delete registry;
+  registry = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SaveEventCheckpoint --- write state (in Run(): after current event)
+//
+static void WritePending()
+{
+  INSTALL_HOOK(Checkpoint, 0);
+  std::string filename;
+  filename.swap(pending);
+  SIMLIB_Checkpoint::Write(filename.c_str());
+}
+
+void SaveEventCheckpoint(const char *filename)
+{
+  if (filename == 0 || *filename == 0)
+    SIMLIB_error(CheckpointError);
+  switch (SIMLIB_Phase) {
+    case INITIALIZATION:
+      SIMLIB_Checkpoint::Write(filename);
+      break;
+    case SIMULATION:
+      pending = filename;
+      INSTALL_HOOK(Checkpoint, WritePending);
+      break;
+    default:
+      SIMLIB_error(CheckpointError);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  RestoreEventCheckpoint --- set state of model (after Init())
+//
+void RestoreEventCheckpoint(const char *filename)
+{
+  if (filename == 0 || SIMLIB_Phase != INITIALIZATION)
+    SIMLIB_error(CheckpointError);
+  SIMLIB_Checkpoint::Read(filename);
+}
+
+} // namespace
+
@@ -27,8 +27,8 @@ namespace simlib3 {
 SIMLIB_IMPLEMENTATION;
 
 
-bool SIMLIB_ConditionFlag = false;       // condition vector changed
-aCondition *aCondition::First = 0;       // condition list
+SIMLIB_CONSTINIT thread_local bool SIMLIB_ConditionFlag = false;       // condition vector changed
+SIMLIB_CONSTINIT thread_local aCondition *aCondition::First = 0;       // condition list
 
 ////////////////////////////////////////////////////////////////////////////
 // aCondition implementation
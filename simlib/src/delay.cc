@@ -42,7 +42,7 @@ SIMLIB_IMPLEMENTATION;
 ////////////////////////////////////////////////////////////////////////////
 /// continuous delay block
 class SIMLIB_Delay {
-    static std::list<Delay *> *listptr; //!< list of delay objects -- singleton
+    static thread_local std::list<Delay *> *listptr; //!< list of delay objects -- singleton
   public:
     static void Register(Delay *p) {    //!< must be called by Delay ctr
         if( listptr == 0 ) Initialize();
@@ -83,7 +83,7 @@ class SIMLIB_Delay {
 };
 
 // static member must be initializad
-std::list<Delay *> *SIMLIB_Delay::listptr = 0;
+thread_local std::list<Delay *> *SIMLIB_Delay::listptr = 0;
 
 
 #ifndef SIMLIB_public_Delay_Buffer
@@ -0,0 +1,472 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file empirical.cc  Empirical distributions
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class EmpiricalDiscrete, EmpiricalContinuous implementation
+//
+//  EmpiricalDiscrete: alias method (A. J. Walker 1977, construction by
+//  M. D. Vose 1991) -- value i is chosen uniformly, then it is replaced by
+//  its alias with probability 1-cut[i]. One uniform number is used for
+//  both decisions.
+//
+//  EmpiricalContinuous: inverse of piecewise-linear CDF. Segment of u is
+//  found from grid index over 0..1 (grid[j] = segment of u=j/m) and short
+//  linear search, so the expected time does not depend on number of points.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <algorithm>    // sort, stable_sort
+#include <cmath>        // isfinite, isnan
+#include <cstdio>       // fopen, fgets, sscanf
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+////////////////////////////////////////////////////////////////////////////
+//  ReadColumns --- read data file with one or two columns
+//  returns: number of columns
+//
+static unsigned ReadColumns(const char *filename,
+                            std::vector<double> &a, std::vector<double> &b)
+{
+  FILE *f = std::fopen(filename, "r");
+  if (!f)
+    SIMLIB_error(EmpiricalFileError);
+  unsigned cols = 0;
+  char line[256];
+  while (std::fgets(line, sizeof(line), f)) {
+    double x, y;
+    char c;
+    int k = std::sscanf(line, " %lf %lf %c", &x, &y, &c);
+    if (k <= 0) {               // empty line or comment
+      if (std::sscanf(line, " %c", &c) == 1 && c != '#')
+        k = -1;                 // not a number
+      else
+        continue;
+    }
+    if (k < 0 || k > 2 || (cols != 0 && unsigned(k) != cols)) {
+      std::fclose(f);
+      SIMLIB_error(EmpiricalFileError);
+    }
+    cols = k;
+    a.push_back(x);
+    if (k == 2)
+      b.push_back(y);
+  }
+  std::fclose(f);
+  if (cols == 0)
+    SIMLIB_error(EmpiricalError);
+  return cols;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  EmpiricalDiscrete constructors
+//
+EmpiricalDiscrete::EmpiricalDiscrete() :
+  val(0), prob(0), cut(0), alias(0), n(0)
+{
+  Dprintf(("EmpiricalDiscrete::EmpiricalDiscrete()"));
+}
+
+EmpiricalDiscrete::EmpiricalDiscrete(const double *values,
+                                     const double *weights, unsigned k) :
+  val(0), prob(0), cut(0), alias(0), n(0)
+{
+  Dprintf(("EmpiricalDiscrete::EmpiricalDiscrete(values,weights,%u)", k));
+  Set(values, weights, k);
+}
+
+EmpiricalDiscrete::EmpiricalDiscrete(const double *samples, unsigned k) :
+  val(0), prob(0), cut(0), alias(0), n(0)
+{
+  Dprintf(("EmpiricalDiscrete::EmpiricalDiscrete(samples,%u)", k));
+  SetSamples(samples, k);
+}
+
+EmpiricalDiscrete::EmpiricalDiscrete(const char *filename) :
+  val(0), prob(0), cut(0), alias(0), n(0)
+{
+  Dprintf(("EmpiricalDiscrete::EmpiricalDiscrete(\"%s\")", filename));
+  Read(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+EmpiricalDiscrete::~EmpiricalDiscrete()
+{
+  Dprintf(("EmpiricalDiscrete::~EmpiricalDiscrete() // \"%s\" ", Name().c_str()));
+  Free();
+}
+
+void EmpiricalDiscrete::Free()
+{
+  delete [] val;
+  delete [] prob;
+  delete [] cut;
+  delete [] alias;
+  val = prob = cut = 0;
+  alias = 0;
+  n = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Set --- values with (not normalized) weights
+//  values are sorted, weights of equal values are added
+//
+void EmpiricalDiscrete::Set(const double *values, const double *weights,
+                            unsigned k)
+{
+  if (k == 0)
+    SIMLIB_error(EmpiricalError);
+  double sum = 0;
+  for (unsigned i = 0; i < k; i++) {
+    if (!(weights[i] >= 0) || !std::isfinite(weights[i]) ||
+        std::isnan(values[i]))
+      SIMLIB_error(EmpiricalError);
+    sum += weights[i];
+  }
+  if (!(sum > 0) || !std::isfinite(sum))
+    SIMLIB_error(EmpiricalError);
+  std::vector<unsigned> order(k);
+  for (unsigned i = 0; i < k; i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [values](unsigned a, unsigned b) {
+                     return values[a] < values[b];
+                   });
+  Free();
+  val = new double[k];
+  prob = new double[k];
+  cut = new double[k];
+  alias = new unsigned[k];
+  for (unsigned i = 0; i < k; i++) {
+    unsigned j = order[i];
+    if (n > 0 && val[n-1] == values[j])
+      prob[n-1] += weights[j] / sum;    // the same value again
+    else {
+      val[n] = values[j];
+      prob[n] = weights[j] / sum;
+      n++;
+    }
+  }
+  Build();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetSamples --- distinct values of samples, weights = counts
+//
+void EmpiricalDiscrete::SetSamples(const double *samples, unsigned k)
+{
+  if (k == 0)
+    SIMLIB_error(EmpiricalError);
+  std::vector<double> s(samples, samples + k);
+  std::sort(s.begin(), s.end());
+  std::vector<double> v, w;
+  for (unsigned i = 0; i < k; i++) {
+    if (v.empty() || s[i] != v.back()) {
+      v.push_back(s[i]);
+      w.push_back(0);
+    }
+    w.back() += 1;
+  }
+  Set(v.data(), w.data(), v.size());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Read --- load data: "value weight" lines or "value" lines (samples)
+//
+void EmpiricalDiscrete::Read(const char *filename)
+{
+  Dprintf(("%s.Read(\"%s\")", Name().c_str(), filename));
+  std::vector<double> a, b;
+  if (ReadColumns(filename, a, b) == 2)
+    Set(a.data(), b.data(), a.size());
+  else
+    SetSamples(a.data(), a.size());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Build --- alias table (Vose)
+//
+void EmpiricalDiscrete::Build()
+{
+  std::vector<unsigned> small, large;
+  for (unsigned i = 0; i < n; i++) {
+    cut[i] = prob[i] * n;       // scaled: average is 1
+    alias[i] = i;
+    (cut[i] < 1 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    unsigned s = small.back(); small.pop_back();
+    unsigned l = large.back(); large.pop_back();
+    alias[s] = l;               // cut[s] of s, rest of column is l
+    cut[l] -= 1 - cut[s];
+    (cut[l] < 1 ? small : large).push_back(l);
+  }
+  // remaining columns are full (rounding errors)
+  for (unsigned i = 0; i < small.size(); i++)
+    cut[small[i]] = 1;
+  for (unsigned i = 0; i < large.size(); i++)
+    cut[large[i]] = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Sample --- draw from stream s
+//
+double EmpiricalDiscrete::Sample(RandomStream &s)
+{
+  if (n == 0)
+    SIMLIB_error(EmpiricalError);
+  double u = s.Random() * n;
+  unsigned i = unsigned(u);
+  return (u - i < cut[i]) ? val[i] : val[alias[i]];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator () --- draw using Random()
+//
+double EmpiricalDiscrete::operator () ()
+{
+  if (n == 0)
+    SIMLIB_error(EmpiricalError);
+  double u = Random() * n;
+  unsigned i = unsigned(u);
+  if (i >= n)                   // user base generator can return 1
+    i = n - 1;
+  return (u - i < cut[i]) ? val[i] : val[alias[i]];
+}
+
+double EmpiricalDiscrete::Value(unsigned i) const
+{
+  if (i >= n)
+    SIMLIB_error(EmpiricalError);
+  return val[i];
+}
+
+double EmpiricalDiscrete::Probability(unsigned i) const
+{
+  if (i >= n)
+    SIMLIB_error(EmpiricalError);
+  return prob[i];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print table of values
+//
+void EmpiricalDiscrete::Output() const
+{
+  Print("+----------------------------------------------------------+\n");
+  Print("| EMPIRICAL DISCRETE %-37s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  Print("| %-56s |\n", " value               probability");
+  Print("+----------------------------------------------------------+\n");
+  for (unsigned i = 0; i < n; i++) {
+    char s[100];
+    std::sprintf(s, " %-18g  %-18g", val[i], prob[i]);
+    Print("| %-56s |\n", s);
+  }
+  Print("+----------------------------------------------------------+\n");
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  EmpiricalContinuous constructors
+//
+EmpiricalContinuous::EmpiricalContinuous() :
+  x(0), F(0), n(0), grid(0), m(0)
+{
+  Dprintf(("EmpiricalContinuous::EmpiricalContinuous()"));
+}
+
+EmpiricalContinuous::EmpiricalContinuous(const double *px, const double *pF,
+                                         unsigned k) :
+  x(0), F(0), n(0), grid(0), m(0)
+{
+  Dprintf(("EmpiricalContinuous::EmpiricalContinuous(x,F,%u)", k));
+  Set(px, pF, k);
+}
+
+EmpiricalContinuous::EmpiricalContinuous(const double *samples, unsigned k) :
+  x(0), F(0), n(0), grid(0), m(0)
+{
+  Dprintf(("EmpiricalContinuous::EmpiricalContinuous(samples,%u)", k));
+  SetSamples(samples, k);
+}
+
+EmpiricalContinuous::EmpiricalContinuous(const char *filename) :
+  x(0), F(0), n(0), grid(0), m(0)
+{
+  Dprintf(("EmpiricalContinuous::EmpiricalContinuous(\"%s\")", filename));
+  Read(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+EmpiricalContinuous::~EmpiricalContinuous()
+{
+  Dprintf(("EmpiricalContinuous::~EmpiricalContinuous() // \"%s\" ", Name().c_str()));
+  Free();
+}
+
+void EmpiricalContinuous::Free()
+{
+  delete [] x;
+  delete [] F;
+  delete [] grid;
+  x = F = 0;
+  grid = 0;
+  n = m = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Set --- CDF table, F is normalized by F[n-1]
+//
+// F[0]>0 means probability F[0] of value x[0]
+//
+void EmpiricalContinuous::Set(const double *px, const double *pF, unsigned k)
+{
+  if (k < 2 || !(pF[0] >= 0) || !(pF[k-1] > 0) || !std::isfinite(pF[k-1]))
+    SIMLIB_error(EmpiricalError);
+  for (unsigned i = 0; i < k; i++)
+    if (!std::isfinite(px[i]) ||
+        (i > 0 && (px[i] < px[i-1] || pF[i] < pF[i-1])))
+      SIMLIB_error(EmpiricalError);
+  Free();
+  n = k;
+  x = new double[n];
+  F = new double[n];
+  for (unsigned i = 0; i < n; i++) {
+    x[i] = px[i];
+    F[i] = pF[i] / pF[n-1];
+  }
+  F[n-1] = 1;
+  Build();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetSamples --- linear interpolation of empirical CDF of samples
+//
+void EmpiricalContinuous::SetSamples(const double *samples, unsigned k)
+{
+  if (k < 2)
+    SIMLIB_error(EmpiricalError);
+  std::vector<double> s(samples, samples + k);
+  std::sort(s.begin(), s.end());
+  std::vector<double> f(k);
+  for (unsigned i = 0; i < k; i++)
+    f[i] = double(i) / (k - 1);
+  Set(s.data(), f.data(), k);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Read --- load data: "x F(x)" lines or "x" lines (samples)
+//
+void EmpiricalContinuous::Read(const char *filename)
+{
+  Dprintf(("%s.Read(\"%s\")", Name().c_str(), filename));
+  std::vector<double> a, b;
+  if (ReadColumns(filename, a, b) == 2)
+    Set(a.data(), b.data(), a.size());
+  else
+    SetSamples(a.data(), a.size());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Build --- grid index
+//
+void EmpiricalContinuous::Build()
+{
+  m = n;
+  grid = new unsigned[m];
+  unsigned k = 0;
+  for (unsigned j = 0; j < m; j++) {
+    double u = double(j) / m;
+    while (k < n - 2 && F[k+1] <= u)
+      k++;
+    grid[j] = k;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Quantile --- inverse CDF (u in range 0..1)
+//
+double EmpiricalContinuous::Quantile(double u) const
+{
+  if (n == 0 || u < 0 || u > 1)
+    SIMLIB_error(EmpiricalError);
+  if (u < F[0])                 // probability of x[0]
+    return x[0];
+  if (u >= 1)
+    return x[n-1];
+  unsigned j = unsigned(u * m);
+  unsigned k = grid[j < m ? j : m - 1];
+  while (k < n - 2 && F[k+1] <= u)
+    k++;
+  return x[k] + (u - F[k]) / (F[k+1] - F[k]) * (x[k+1] - x[k]);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Sample, operator () --- draw from stream s or using Random()
+//
+double EmpiricalContinuous::Sample(RandomStream &s)
+{
+  return Quantile(s.Random());
+}
+
+double EmpiricalContinuous::operator () ()
+{
+  return Quantile(Random());
+}
+
+double EmpiricalContinuous::Low() const
+{
+  if (n == 0)
+    SIMLIB_error(EmpiricalError);
+  return x[0];
+}
+
+double EmpiricalContinuous::High() const
+{
+  if (n == 0)
+    SIMLIB_error(EmpiricalError);
+  return x[n-1];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print CDF table
+//
+void EmpiricalContinuous::Output() const
+{
+  Print("+----------------------------------------------------------+\n");
+  Print("| EMPIRICAL CONTINUOUS %-35s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  Print("| %-56s |\n", " x                   F(x)");
+  Print("+----------------------------------------------------------+\n");
+  for (unsigned i = 0; i < n; i++) {
+    char s[100];
+    std::sprintf(s, " %-18g  %-18g", x[i], F[i]);
+    Print("| %-56s |\n", s);
+  }
+  Print("+----------------------------------------------------------+\n");
+}
+
+} // namespace
+
@@ -24,9 +24,9 @@ namespace simlib3 {
 SIMLIB_IMPLEMENTATION;
 
 /// current number of entities in model
-static unsigned long SIMLIB_Entity_Count = 0L; // # of entities in model
+SIMLIB_CONSTINIT thread_local unsigned long SIMLIB_Entity_Count = 0L; // # of entities in model
 /// serial number of created entity
-unsigned long Entity::_Number = 0L;     // # of entity creations
+SIMLIB_CONSTINIT thread_local unsigned long Entity::_Number = 0L;     // # of entity creations
 
 ////////////////////////////////////////////////////////////////////////////
 ///  constructor
@@ -34,6 +34,9 @@ Entity::Entity(Priority_t p) :
   _Ident(SIMLIB_Entity_Count++), // unique identification
   _MarkTime(0.0),
   _SPrio(0),
+  _Discarded(0),
+  _Interrupted(0),
+  _RandomStream(0),
   Priority(p),
   _evn(0) // pointer to calendar item
 {
@@ -45,6 +48,8 @@ Entity::Entity(Priority_t p) :
 ///  destructor
 Entity::~Entity() {
   Dprintf(("Entity#%lu{%p}::~Entity()", _Ident, this));
+  if (_Interrupted)
+    SIMLIB_InterruptedRemove(this); // no dangling pointer in facility
   if (!Idle()) {
     SQS::Get(this);           // remove from calendar
 //  _warning(DeletingActive); // TODO:can be important? if sim SIMLIB_error else _warn
@@ -100,7 +105,7 @@ void Entity::Terminate()
   if(!Idle())
       SQS::Get(this);  // remove from calendar
 
-  if(isAllocated() && this != SIMLIB_Current)
+  if(isAllocated() && this != Current)
       delete this;     // destroy entity (if not currently running Behavior)
 }
 
@@ -25,73 +25,101 @@ static const char _Errors[] = {
 /* 11 */ "SetAccuracy: Too small relative accuracy requested\0"
 /* 12 */ "Special function called and simulation is not running\0"
 /* 13 */ "Numerical integration error greater than requested\0"
-/* 14 */ "Bad reference to list item\0"
-/* 15 */ "Deleted item is linked in some list\0"
-/* 16 */ "Removed item not in list\0"
-/* 17 */ "Calendar should be singleton\0"
-/* 18 */ "Deleting active item in calendar\0"
-/* 19 */ "Scheduling before current Time\0"
-/* 20 */ "Calendar is empty\0"
-/* 21 */ "Procesis is not initialized\0"
-/* 22 */ "Bad histogram step (step<=0)\0"
-/* 23 */ "Bad histogram interval count (max=10000)\0"
-/* 24 */ "List does not have active item\0"
-/* 25 */ "Empty list\0"
-/* 26 */ "Bad queue reference\0"
-/* 27 */ "Empty WaitUntilList - can't Get() (internal error)\0"
-/* 28 */ "Bad entity reference\0"
-/* 29 */ "Entity not scheduled\0"
-/* 30 */ "Time statistic not initialized\0"
-/* 31 */ "Can't create new integrator in dynamic section\0"
-/* 32 */ "Can't destroy integrator in dynamic section\0"
-/* 33 */ "Can't create new status variable in dynamic section\0"
-/* 34 */ "Can't destroy status variable in dynamic section\0"
-/* 35 */ "Seize(): Can't interrupt facility service\0"
-/* 36 */ "Release(): Facility is released by other than currently serviced process\0"
-/* 37 */ "Release(): Can't release empty facility\0"
-/* 38 */ "Enter() request exceeded the store capacity\0"
-/* 39 */ "Leave() leaves more than currently used\0"
-/* 40 */ "SetCapacity(): can't reduce store capacity\0"
-/* 41 */ "SetQueue(): deleted (old) queue is not empty\0"
-/* 42 */ "Weibul(): lambda<=0.0 or alfa<=1.0\0"
-/* 43 */ "Erlang(): beta<1\0"
-/* 44 */ "NegBin(): q<=0 or k<=0\0"
-/* 45 */ "NegBinM(): m<=0\0"
-/* 46 */ "NegBinM(): p not in range 0..1\0"
-/* 47 */ "Poisson(lambda): lambda<=0\0"
-/* 48 */ "Geom(): q<=0\0"
-/* 49 */ "HyperGeom(): m<=0\0"
-/* 50 */ "HyperGeom(): p not in range 0..1\0"
-/* 51 */ "Can't write output file\0"
-/* 52 */ "Output file can't be open between Init() and Run()\0"
-/* 53 */ "Can't open output file\0"
-/* 54 */ "Can't close output file\0"
-/* 55 */ "Algebraic loop detected\0"
-/* 56 */ "Parameter low>=high\0"
-/* 57 */ "Parameter of quantizer <= 0\0"
-/* 58 */ "Library and header (simlib.h) version mismatch \0"
-/* 59 */ "Semaphore::V() -- bad call\0"
-/* 60 */ "Uniform(l,h) -- bad arguments\0"
-/* 61 */ "Stat::MeanValue()  No record in statistics\0"
-/* 62 */ "Stat::Disp()  Can't compute (n<2)\0"
-/* 63 */ "AlgLoop: t_min>=t_max\0"
-/* 64 */ "AlgLoop: t0 not in  <t_min,t_max>\0"
-/* 65 */ "AlgLoop: method not convergent\0"
-/* 66 */ "AlgLoop: iteration limit exceeded\0"
-/* 67 */ "AlgLoop: iterative block is not in loop\0"
-/* 68 */ "Unknown integration method\0"
-/* 69 */ "Integration method name not unique\0"
-/* 70 */ "Integration step <=0\0"
-/* 71 */ "Start-method is not single-step\0"
-/* 72 */ "Method is not multi-step\0"
-/* 73 */ "Can't switch methods in dynamic section\0"
-/* 74 */ "Can't switch start-methods in dynamic section\0"
-/* 75 */ "Rline: argument n<2\0"
-/* 76 */ "Rline: array is not sorted\0"
-/* 77 */ "Library compiled without debugging support\0"
-/* 78 */ "Dealy is too small (<=MaxStep)\0"
-/* 79 */ "Parameter can not be changed during simulation run\0"
-/* 80 */ "General error\0"
+/* 14 */ "Simulator: second simulator in thread or destroyed in Run()\0"
+/* 15 */ "Replications: bad function, result not allocated by new or not mergeable\0"
+/* 16 */ "ForkReplications: bad result object or fork() failed\0"
+/* 17 */ "ForkReplications: replication process failed\0"
+/* 18 */ "Branch: bad number of branches or fork() failed\0"
+/* 19 */ "Checkpoint: bad use (simulation phase or registration)\0"
+/* 20 */ "Checkpoint: can not write/read file or bad file format\0"
+/* 21 */ "Checkpoint: entity not registered (CheckpointRegister/Class)\0"
+/* 22 */ "Checkpoint: started process can not be saved (event-only checkpoint)\0"
+/* 23 */ "Sweep: bad function, design or number of points/parameters\0"
+/* 24 */ "Sweep: can not write results file, or it is of other sweep or malformed\0"
+/* 25 */ "SensitivityAnalysis: bad function, options or number of parameters\0"
+/* 26 */ "SelectBest: bad function, candidates, results or options\0"
+/* 27 */ "SelectBest: budget spent before requested PCS was reached\0"
+/* 28 */ "EvaluationCache: bad quantum (must be positive) or too large parameter\0"
+/* 29 */ "EvaluationCache: can not write file or bad file format\0"
+/* 30 */ "Bad reference to list item\0"
+/* 31 */ "Deleted item is linked in some list\0"
+/* 32 */ "Removed item not in list\0"
+/* 33 */ "Calendar should be singleton\0"
+/* 34 */ "Deleting active item in calendar\0"
+/* 35 */ "Scheduling before current Time\0"
+/* 36 */ "Calendar is empty\0"
+/* 37 */ "Procesis is not initialized\0"
+/* 38 */ "Bad histogram step (step<=0)\0"
+/* 39 */ "Bad histogram interval count (max=10000)\0"
+/* 40 */ "Histogram::Merge -- different intervals\0"
+/* 41 */ "LogHistogram -- bad parameter (unit<=0, digits not 1-5, q not in [0,1])\0"
+/* 42 */ "LogHistogram::Merge -- different unit or digits\0"
+/* 43 */ "List does not have active item\0"
+/* 44 */ "Empty list\0"
+/* 45 */ "Bad queue reference\0"
+/* 46 */ "Empty WaitUntilList - can't Get() (internal error)\0"
+/* 47 */ "Bad entity reference\0"
+/* 48 */ "Entity not scheduled\0"
+/* 49 */ "Time statistic not initialized\0"
+/* 50 */ "Can't create new integrator in dynamic section\0"
+/* 51 */ "Can't destroy integrator in dynamic section\0"
+/* 52 */ "Can't create new status variable in dynamic section\0"
+/* 53 */ "Can't destroy status variable in dynamic section\0"
+/* 54 */ "Seize(): Can't interrupt facility service\0"
+/* 55 */ "Release(): Facility is released by other than currently serviced process\0"
+/* 56 */ "Release(): Can't release empty facility\0"
+/* 57 */ "Enter() request exceeded the store capacity\0"
+/* 58 */ "Leave() leaves more than currently used\0"
+/* 59 */ "SetCapacity(): can't reduce store capacity\0"
+/* 60 */ "SetQueue(): deleted (old) queue is not empty\0"
+/* 61 */ "Weibul(): lambda<=0.0 or alfa<=1.0\0"
+/* 62 */ "Erlang(): beta<1\0"
+/* 63 */ "NegBin(): q<=0 or k<=0\0"
+/* 64 */ "NegBinM(): m<=0\0"
+/* 65 */ "NegBinM(): p not in range 0..1\0"
+/* 66 */ "Poisson(lambda): lambda<=0\0"
+/* 67 */ "Gamma(), Beta(): shape or scale parameter <=0\0"
+/* 68 */ "Binom(): n<0 or p not in range 0..1\0"
+/* 69 */ "Empirical distribution: bad or missing data\0"
+/* 70 */ "Empirical distribution: can't read data file\0"
+/* 71 */ "Geom(): q<=0\0"
+/* 72 */ "HyperGeom(): m<=0\0"
+/* 73 */ "HyperGeom(): p not in range 0..1\0"
+/* 74 */ "Can't write output file\0"
+/* 75 */ "Output file can't be open between Init() and Run()\0"
+/* 76 */ "Can't open output file\0"
+/* 77 */ "Can't close output file\0"
+/* 78 */ "Algebraic loop detected\0"
+/* 79 */ "Parameter low>=high\0"
+/* 80 */ "Parameter of quantizer <= 0\0"
+/* 81 */ "Library and header (simlib.h) version mismatch \0"
+/* 82 */ "Semaphore -- value out of range\0"
+/* 83 */ "Uniform(l,h) -- bad arguments\0"
+/* 84 */ "Stat::MeanValue()  No record in statistics\0"
+/* 85 */ "Stat::Disp()  Can't compute (n<2)\0"
+/* 86 */ "BatchMeans -- bad parameter (batches<2, level not in (0,1), precision<0)\0"
+/* 87 */ "WarmupDetector -- capacity<10 or no data\0"
+/* 88 */ "QuantileStat -- bad parameter (compression<10 or q not in [0,1])\0"
+/* 89 */ "AlgLoop: t_min>=t_max\0"
+/* 90 */ "AlgLoop: t0 not in  <t_min,t_max>\0"
+/* 91 */ "AlgLoop: method not convergent\0"
+/* 92 */ "AlgLoop: iteration limit exceeded\0"
+/* 93 */ "AlgLoop: iterative block is not in loop\0"
+/* 94 */ "Unknown integration method\0"
+/* 95 */ "Integration method name not unique\0"
+/* 96 */ "Integration step <=0\0"
+/* 97 */ "Start-method is not single-step\0"
+/* 98 */ "Method is not multi-step\0"
+/* 99 */ "Can't switch methods in dynamic section\0"
+/* 100 */ "Can't switch start-methods in dynamic section\0"
+/* 101 */ "Rline: argument n<2\0"
+/* 102 */ "Rline: array is not sorted\0"
+/* 103 */ "Library compiled without debugging support\0"
+/* 104 */ "Dealy is too small (<=MaxStep)\0"
+/* 105 */ "Parameter can not be changed during simulation run\0"
+/* 106 */ "TStatRecorder: window width <= 0 or zero capacity\0"
+/* 107 */ "TStatRecorder: window index out of range\0"
+/* 108 */ "General error\0"
 };
 
 const char *_ErrMsg(enum _ErrEnum N)
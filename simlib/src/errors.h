@@ -21,73 +21,101 @@ enum _ErrEnum {
 /* 11 */ SetAccuracyError,
 /* 12 */ SFunctionUseError,
 /* 13 */ AccuracyError,
-/* 14 */ LinkRefError,
-/* 15 */ LinkDelError,
-/* 16 */ LinkOutError,
-/* 17 */ DuplicateCalendar,
-/* 18 */ DeletingActive,
-/* 19 */ SchedulingBeforeTime,
-/* 20 */ EmptyCalendar,
-/* 21 */ ProcessNotInitialized,
-/* 22 */ HistoStepError,
-/* 23 */ HistoCountError,
-/* 24 */ ListActivityError,
-/* 25 */ ListEmptyError,
-/* 26 */ QueueRefError,
-/* 27 */ EmptyWUListError,
-/* 28 */ EntityRefError,
-/* 29 */ EntityIsNotScheduled,
-/* 30 */ TStatNotInitialized,
-/* 31 */ CantCreateIntg,
-/* 32 */ CantDestroyIntg,
-/* 33 */ CantCreateStatus,
-/* 34 */ CantDestroyStatus,
-/* 35 */ FacInterruptError,
-/* 36 */ ReleaseError,
-/* 37 */ ReleaseNotSeized,
-/* 38 */ EnterCapError,
-/* 39 */ LeaveManyError,
-/* 40 */ SetCapacityError,
-/* 41 */ SetQueueError,
-/* 42 */ WeibullError,
-/* 43 */ ErlangError,
-/* 44 */ NegBinError,
-/* 45 */ NegBinMError1,
-/* 46 */ NegBinMError2,
-/* 47 */ PoissonError,
-/* 48 */ GeomError,
-/* 49 */ HyperGeomError1,
-/* 50 */ HyperGeomError2,
-/* 51 */ OutFilePutError,
-/* 52 */ OutFileOpenError,
-/* 53 */ CantOpenOutFile,
-/* 54 */ CantCloseOutFile,
-/* 55 */ AlgLoopDetected,
-/* 56 */ LowGreaterHigh,
-/* 57 */ BadQntzrStep,
-/* 58 */ InconsistentHeader,
-/* 59 */ SemaphoreError,
-/* 60 */ BadUniformParam,
-/* 61 */ StatNoRecError,
-/* 62 */ StatDispError,
-/* 63 */ AL_BadBounds,
-/* 64 */ AL_BadInitVal,
-/* 65 */ AL_Diverg,
-/* 66 */ AL_MaxCount,
-/* 67 */ AL_NotInLoop,
-/* 68 */ NI_UnknownMeth,
-/* 69 */ NI_MultDefMeth,
-/* 70 */ NI_IlStepSize,
-/* 71 */ NI_NotSingleStep,
-/* 72 */ NI_NotMultiStep,
-/* 73 */ NI_CantSetMethod,
-/* 74 */ NI_CantSetStarter,
-/* 75 */ RlineErr1,
-/* 76 */ RlineErr2,
-/* 77 */ NoDebugErr,
-/* 78 */ DelayTimeErr,
-/* 79 */ ParameterChangeErr,
-/* 80 */ UserError,
+/* 14 */ SimulatorError,
+/* 15 */ ReplicationError,
+/* 16 */ ForkError,
+/* 17 */ ForkChildError,
+/* 18 */ BranchError,
+/* 19 */ CheckpointError,
+/* 20 */ CheckpointFileError,
+/* 21 */ CheckpointEntityError,
+/* 22 */ CheckpointProcessError,
+/* 23 */ SweepError,
+/* 24 */ SweepFileError,
+/* 25 */ SensitivityError,
+/* 26 */ SelectionError,
+/* 27 */ SelectionBudgetWarning,
+/* 28 */ EvaluationCacheError,
+/* 29 */ EvaluationCacheFileError,
+/* 30 */ LinkRefError,
+/* 31 */ LinkDelError,
+/* 32 */ LinkOutError,
+/* 33 */ DuplicateCalendar,
+/* 34 */ DeletingActive,
+/* 35 */ SchedulingBeforeTime,
+/* 36 */ EmptyCalendar,
+/* 37 */ ProcessNotInitialized,
+/* 38 */ HistoStepError,
+/* 39 */ HistoCountError,
+/* 40 */ HistoMergeError,
+/* 41 */ LogHistoError,
+/* 42 */ LogHistoMergeError,
+/* 43 */ ListActivityError,
+/* 44 */ ListEmptyError,
+/* 45 */ QueueRefError,
+/* 46 */ EmptyWUListError,
+/* 47 */ EntityRefError,
+/* 48 */ EntityIsNotScheduled,
+/* 49 */ TStatNotInitialized,
+/* 50 */ CantCreateIntg,
+/* 51 */ CantDestroyIntg,
+/* 52 */ CantCreateStatus,
+/* 53 */ CantDestroyStatus,
+/* 54 */ FacInterruptError,
+/* 55 */ ReleaseError,
+/* 56 */ ReleaseNotSeized,
+/* 57 */ EnterCapError,
+/* 58 */ LeaveManyError,
+/* 59 */ SetCapacityError,
+/* 60 */ SetQueueError,
+/* 61 */ WeibullError,
+/* 62 */ ErlangError,
+/* 63 */ NegBinError,
+/* 64 */ NegBinMError1,
+/* 65 */ NegBinMError2,
+/* 66 */ PoissonError,
+/* 67 */ GammaError,
+/* 68 */ BinomError,
+/* 69 */ EmpiricalError,
+/* 70 */ EmpiricalFileError,
+/* 71 */ GeomError,
+/* 72 */ HyperGeomError1,
+/* 73 */ HyperGeomError2,
+/* 74 */ OutFilePutError,
+/* 75 */ OutFileOpenError,
+/* 76 */ CantOpenOutFile,
+/* 77 */ CantCloseOutFile,
+/* 78 */ AlgLoopDetected,
+/* 79 */ LowGreaterHigh,
+/* 80 */ BadQntzrStep,
+/* 81 */ InconsistentHeader,
+/* 82 */ SemaphoreError,
+/* 83 */ BadUniformParam,
+/* 84 */ StatNoRecError,
+/* 85 */ StatDispError,
+/* 86 */ BatchMeansError,
+/* 87 */ WarmupError,
+/* 88 */ QuantileError,
+/* 89 */ AL_BadBounds,
+/* 90 */ AL_BadInitVal,
+/* 91 */ AL_Diverg,
+/* 92 */ AL_MaxCount,
+/* 93 */ AL_NotInLoop,
+/* 94 */ NI_UnknownMeth,
+/* 95 */ NI_MultDefMeth,
+/* 96 */ NI_IlStepSize,
+/* 97 */ NI_NotSingleStep,
+/* 98 */ NI_NotMultiStep,
+/* 99 */ NI_CantSetMethod,
+/* 100 */ NI_CantSetStarter,
+/* 101 */ RlineErr1,
+/* 102 */ RlineErr2,
+/* 103 */ NoDebugErr,
+/* 104 */ DelayTimeErr,
+/* 105 */ ParameterChangeErr,
+/* 106 */ TStatRecorderError,
+/* 107 */ TStatRecorderIndexError,
+/* 108 */ UserError,
 };
 
 extern const char *_ErrMsg(enum _ErrEnum N);
@@ -54,7 +54,7 @@ void Event::Terminate()
   Dprintf(("%s.Terminate()",Name().c_str()));
   if(!Idle())          // if scheduled
       SQS::Get(this);  // remove from calendar
-  if(isAllocated() && this != SIMLIB_Current)
+  if(isAllocated() && this != Current)
       delete this;     // destroy entity (if not currently running Behavior)
 }
 
@@ -39,6 +39,7 @@ Facility::Facility()
 {
     Dprintf(("Facility::Facility()"));
     _Qflag = 0;
+    _StatLevel = SIMLIB_StatisticsLevel;
     Q1 = new Queue("Q1");
     _Qflag |= _OWNQ1;
     Q2 = new Queue("Q2");
@@ -50,6 +51,7 @@ Facility::Facility(const char *name)
     Dprintf(("Facility::Facility(\"%s\")", name));
     SetName(name);
     _Qflag = 0;
+    _StatLevel = SIMLIB_StatisticsLevel;
     Q1 = new Queue("Q1");
     _Qflag |= _OWNQ1;
     Q2 = new Queue("Q2");
@@ -60,6 +62,7 @@ Facility::Facility(Queue * queue)
 {
     Dprintf(("Facility::Facility(%s)", queue->Name().c_str()));
     _Qflag = 0;
+    _StatLevel = SIMLIB_StatisticsLevel;
     CHECKQUEUE(queue);
     Q1 = queue;
     Q2 = new Queue("Q2");
@@ -71,6 +74,7 @@ Facility::Facility(const char *name, Queue * queue)
     Dprintf(("Facility::Facility(\"%s\",%s)", name, queue->Name().c_str()));
     SetName(name);
     _Qflag = 0;
+    _StatLevel = SIMLIB_StatisticsLevel;
     CHECKQUEUE(queue);
     Q1 = queue;
     Q2 = new Queue("Q2");
@@ -104,6 +108,23 @@ void Facility::SetQueue(Queue * queue)
     Q1 = queue;
 }
 ////////////////////////////////////////////////////////////////////////////
+//  SetStatisticsLevel
+//
+// changes also the level of internal queues, statistics are cleared
+// if the level differs
+//
+void Facility::SetStatisticsLevel(StatisticsLevel_t level)
+{
+    Dprintf(("%s.SetStatisticsLevel(%d)", Name().c_str(), int(level)));
+    StatisticsLevel_t l = SIMLIB_StatLevelLimit(level);
+    if (l != _StatLevel)        // do not mix records of different levels
+        tstat.Clear(Busy() ? 1 : 0);
+    _StatLevel = l;
+    if (OwnQueue())
+        Q1->SetStatisticsLevel(level);
+    Q2->SetStatisticsLevel(level);
+}
+////////////////////////////////////////////////////////////////////////////
 //  Seize -- seize facility by entity e
 //
 // possible waiting in queue
@@ -120,7 +141,7 @@ void Facility::Seize(Entity * e, ServicePriority_t sp)
     e->_SPrio = sp;
     if (!Busy()) {
         in = e;                 // seize by entity
-        tstat(1);               // update statistics
+        SIMLIB_STAT_RECORD(_StatLevel, tstat, 1); // update statistics
         return;
     }
     if (sp > in->_SPrio) {      // special case: service interrupted
@@ -132,7 +153,7 @@ void Facility::Seize(Entity * e, ServicePriority_t sp)
         QueueIn2(*in);          // insert interrupted entity into queue2
         in->Passivate();        // wait in queue2 =====================
         in = e;                 // seize by entity
-        tstat(1);               // update statistics
+        SIMLIB_STAT_RECORD(_StatLevel, tstat, 1); // update statistics
     } else {                    // go into main queue
         QueueIn(e, sp);         // insert in priority queue
         e->Passivate();         // wait in queue, activated by Release()
@@ -160,8 +181,7 @@ void Facility::Release(Entity * e)
     if (e != in)
         SIMLIB_error(ReleaseError);     // seized by other entity
     in = NULL;                  // empty
-    tstat(0);                   // record
-    tstat.n--;                  // correction !!
+    SIMLIB_STAT_UPDATE(_StatLevel, tstat, 0); // record
 
     bool flag = false;          // correction: 5.12.91, bool:1998/08/10
     if (!(Q1->empty() || Q2->empty())) {
@@ -178,8 +198,7 @@ void Facility::Release(Entity * e)
         Dprintf(("%s.Seize(%s,%u) from Q2",
                  Name().c_str(), ent->Name().c_str(), (unsigned) ent->_SPrio));
         in = ent;               // seize again
-        tstat(1);
-        tstat.n--;              // correction !!!
+        SIMLIB_STAT_UPDATE(_StatLevel, tstat, 1);
         ent->Activate(Time + ent->_RemainingTime);  // schedule end of service
         return;
     }
@@ -188,7 +207,7 @@ void Facility::Release(Entity * e)
         ent = Q1->front();      // points to first entity in queue
         ent->Out();             // remove from queue
         in = ent;               // seize by entity [should be here]
-        tstat(1);               // update statistics
+        SIMLIB_STAT_RECORD(_StatLevel, tstat, 1); // update statistics
         ent->Activate();        // activation of entity behavior
         return;
     }
@@ -0,0 +1,249 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file forkrep.cc  Replications in forked processes
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  ForkReplications implementation (POSIX: fork, mmap, waitpid)
+//
+//  Each replication is a child process forked from the prepared model.
+//  Shared anonymous memory contains slot for each replication:
+//
+//     [done flag] [data of result 1] [data of result 2] ...
+//
+//  Child writes data of result objects (SIMLIB_Snapshot) and sets flag.
+//  Parent keeps at most `workers` children running and merges the slots
+//  in order of index after all children end.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>       // fflush
+#include <thread>       // hardware_concurrency, sleep_for
+#include <vector>
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+# define SIMLIB_HAVE_FORK 1
+# include <sys/mman.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+#ifdef SIMLIB_HAVE_FORK
+
+namespace {
+
+enum ResultType { STAT, TSTAT, HISTOGRAM };
+
+struct Result {
+  SimObject *obj;
+  ResultType type;
+};
+
+ResultType TypeOf(SimObject *o)
+{
+  if (dynamic_cast<Histogram*>(o)) return HISTOGRAM;
+  if (dynamic_cast<TStat*>(o))     return TSTAT;
+  if (SIMLIB_StatDerived(o))       SIMLIB_error(ForkError); // data lost
+  if (dynamic_cast<Stat*>(o))      return STAT;
+  SIMLIB_error(ForkError);
+}
+
+size_t Size(const Result &r)
+{
+  switch (r.type) {
+    case HISTOGRAM: return SIMLIB_Snapshot::Size(*static_cast<Histogram*>(r.obj));
+    case TSTAT:     return SIMLIB_Snapshot::Size(*static_cast<TStat*>(r.obj));
+    default:        return SIMLIB_Snapshot::Size(*static_cast<Stat*>(r.obj));
+  }
+}
+
+void Clear(const Result &r)
+{
+  switch (r.type) {
+    case HISTOGRAM: static_cast<Histogram*>(r.obj)->Clear(); break;
+    case TSTAT: {
+      TStat *s = static_cast<TStat*>(r.obj);
+      s->Clear(s->LastValue());         // start with current value
+      break;
+    }
+    default:        static_cast<Stat*>(r.obj)->Clear(); break;
+  }
+}
+
+void Save(const Result &r, char *&p)
+{
+  switch (r.type) {
+    case HISTOGRAM: SIMLIB_Snapshot::Save(*static_cast<Histogram*>(r.obj), p); break;
+    case TSTAT:     SIMLIB_Snapshot::Save(*static_cast<TStat*>(r.obj), p); break;
+    default:        SIMLIB_Snapshot::Save(*static_cast<Stat*>(r.obj), p); break;
+  }
+}
+
+void Merge(const Result &r, const char *&p)
+{
+  switch (r.type) {
+    case HISTOGRAM: SIMLIB_Snapshot::Merge(*static_cast<Histogram*>(r.obj), p); break;
+    case TSTAT:     SIMLIB_Snapshot::Merge(*static_cast<TStat*>(r.obj), p); break;
+    default:        SIMLIB_Snapshot::Merge(*static_cast<Stat*>(r.obj), p); break;
+  }
+}
+
+// Child --- body of replication process (does not return)
+[[noreturn]] void Child(unsigned long i, void (*fn)(unsigned long),
+                        const std::vector<Result> &results,
+                        unsigned long long master, const RandomStream &s,
+                        char *slot)
+{
+  SIMLIB_RandomReplica(master + 0x9e3779b97f4a7c15ULL * (i + 1), s);
+  for (size_t k = 0; k < results.size(); k++)
+    Clear(results[k]);
+  fn(i);
+  char *p = slot + sizeof(int);
+  for (size_t k = 0; k < results.size(); k++) {
+    if (results[k].type == TSTAT)       // up to the end of run
+      SIMLIB_Snapshot::Close(*static_cast<TStat*>(results[k].obj));
+    Save(results[k], p);
+  }
+  *reinterpret_cast<volatile int*>(slot) = 1;   // done
+  fflush(0);
+  _exit(0);             // no destructors, atexit functions of parent
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_WaitChild --- wait until one of given children ends
+//
+//  polls the given pids only (WNOHANG), so other children of program are
+//  not reaped
+//
+int SIMLIB_WaitChild(const std::vector<pid_t> &pid, int *status)
+{
+  if (pid.empty())
+    return -1;
+  for (;;) {
+    for (size_t i = 0; i < pid.size(); i++) {
+      pid_t r = waitpid(pid[i], status, WNOHANG);
+      if (r == pid[i])
+        return int(i);
+      if (r < 0 && errno != EINTR)
+        return -1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ForkReplications --- run n replications in child processes
+//
+void ForkReplications(unsigned long n, unsigned workers,
+                      void (*fn)(unsigned long i),
+                      std::initializer_list<SimObject*> results)
+{
+  Dprintf(("ForkReplications(%lu,%u)", n, workers));
+  if (fn == 0)
+    SIMLIB_error(ReplicationError);
+  if (SIMLIB_Phase == SIMULATION)
+    SIMLIB_error(ForkError);
+  if (n == 0)
+    return;
+  if (workers == 0)
+    workers = std::thread::hardware_concurrency();
+  if (workers == 0)
+    workers = 1;
+  std::vector<Result> r;
+  size_t slotsize = sizeof(int);
+  for (std::initializer_list<SimObject*>::const_iterator o = results.begin();
+       o != results.end(); ++o) {
+    Result x = { *o, TypeOf(*o) };
+    r.push_back(x);
+    slotsize += Size(x);
+  }
+  slotsize = (slotsize + 7) & ~size_t(7);       // aligned slots
+  size_t total = slotsize * n;
+  void *mem = mmap(0, total, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED)
+    SIMLIB_error(ForkError);
+  char *shm = static_cast<char*>(mem);  // zero filled
+  RandomStream next = CurrentRandomStream();
+  const unsigned long long master = SIMLIB_RandomMasterSeed();
+  bool failed = false;
+  std::vector<pid_t> running;           // our children
+  for (unsigned long i = 0; i < n || !running.empty(); ) {
+    if (i < n && running.size() < workers && !failed) {
+      RandomStream s = next.Split();
+      fflush(0);                // no duplicate output of buffers
+      pid_t pid = fork();
+      if (pid < 0) {
+        failed = true;
+        continue;
+      }
+      if (pid == 0)
+        Child(i, fn, r, master, s, shm + slotsize * i);
+      running.push_back(pid);
+      ++i;
+      continue;
+    }
+    if (running.empty())
+      break;                    // failed: do not start the rest
+    int status;
+    int c = SIMLIB_WaitChild(running, &status);
+    if (c < 0) {
+      failed = true;
+      break;
+    }
+    running.erase(running.begin() + c);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      failed = true;
+  }
+  if (!failed)
+    for (unsigned long i = 0; i < n; i++)       // merge in fixed order
+      if (*reinterpret_cast<volatile int*>(shm + slotsize * i) != 1) {
+        failed = true;
+        break;
+      }
+  if (!failed)
+    for (unsigned long i = 0; i < n; i++) {
+      const char *p = shm + slotsize * i + sizeof(int);
+      for (size_t k = 0; k < r.size(); k++)
+        Merge(r[k], p);
+    }
+  munmap(mem, total);
+  if (failed)
+    SIMLIB_error(ForkChildError);
+  if (SIMLIB_Phase == INITIALIZATION)
+    SIMLIB_Phase = TERMINATION;         // experiment done, Init() can follow
+}
+
+#else // no fork()
+
+void ForkReplications(unsigned long, unsigned, void (*)(unsigned long),
+                      std::initializer_list<SimObject*>)
+{
+  SIMLIB_error(ForkError);
+}
+
+#endif
+
+} // namespace
+
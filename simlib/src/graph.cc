@@ -115,7 +115,7 @@ void Graph::Behavior()
 //
 void Graph::StartSampling()
 {
-  if( Phase!=SIMULATION && Phase!=INITIALIZATION ) return;
+  if( SIMLIB_Phase!=SIMULATION && SIMLIB_Phase!=INITIALIZATION ) return;
   //Behavior()
   Sample();
 
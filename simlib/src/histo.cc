@@ -53,6 +53,7 @@ Histogram::Histogram() :
 {
   Dprintf(("Histogram::Histogram()"));
   dptr = Alloc(count+2);
+  SIMLIB_StatRegistry::Register(this);
 }
 
 Histogram::Histogram(double l, double s, unsigned c) :
@@ -64,6 +65,7 @@ Histogram::Histogram(double l, double s, unsigned c) :
   if(s<=0)                      SIMLIB_error(HistoStepError);
   if(c==0 || c>MAXHISTOCOUNT)   SIMLIB_error(HistoCountError);
   dptr = Alloc(count+2);
+  SIMLIB_StatRegistry::Register(this);
 }
 
 Histogram::Histogram(const char *n, double l, double s, unsigned c) :
@@ -76,6 +78,7 @@ Histogram::Histogram(const char *n, double l, double s, unsigned c) :
   if(s<=0)                      SIMLIB_error(HistoStepError);
   if(c==0 || c>MAXHISTOCOUNT)   SIMLIB_error(HistoCountError);
   dptr = Alloc(count+2);
+  SIMLIB_StatRegistry::Register(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -84,6 +87,7 @@ Histogram::Histogram(const char *n, double l, double s, unsigned c) :
 Histogram::~Histogram()
 {
   Dprintf(("Histogram::~Histogram() // \"%s\" ", Name().c_str()));
+  SIMLIB_StatRegistry::Unregister(this);
   delete[] dptr;
 }
 
@@ -96,6 +100,19 @@ unsigned Histogram::operator [] (unsigned i) const
   return dptr[i];
 }
 
+////////////////////////////////////////////////////////////////////////////
+//  Merge --- add counts of other histogram with the same intervals
+//
+void Histogram::Merge(const Histogram &h)
+{
+  Dprintf(("Histogram::Merge(\"%s\")", h.Name().c_str()));
+  if(low!=h.low || step!=h.step || count!=h.count)
+    SIMLIB_error(HistoMergeError);
+  for(unsigned i=0; i<count+2; i++)
+    dptr[i] += h.dptr[i];
+  stat.Merge(h.stat);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //  operator ()  - value recording
 //
@@ -53,6 +53,12 @@
 #  error "simlib.h should be included first"
 #endif
 
+#include <functional>   // std::function
+#include <vector>       // SIMLIB_OptEvaluate()
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+#include <sys/types.h>  // pid_t: SIMLIB_WaitChild()
+#endif
+
 namespace simlib3 {
 
 ////////////////////////////////////////////////////////////////////////////
@@ -80,10 +86,6 @@ enum SIMLIB_Phase_t {
     TERMINATION,    // after Run() call
     ERROREXIT       // fatal error handling phase
 };
-//! This variable contains the current phase of experiment
-//! (used for internal checking)
-extern const SIMLIB_Phase_t &Phase;
-
 ////////////////////////////////////////////////////////////////////////////
 // debugging ...
 //TODO: minimize
@@ -94,17 +96,16 @@ extern const SIMLIB_Phase_t &Phase;
 #   define DEBUG(c,s)
 #   define DEBUG_INFO
 #else
-    extern double SIMLIB_Time;            // simulation time
 #   define DEBUG_INFO "/debug"
     extern unsigned long SIMLIB_debug_flag; // debugging flags
 #   define Dprintf(f) \
         do { if( SIMLIB_debug_flag ) \
-                 { _Print("DEBUG: T=%-10g ", SIMLIB_Time); \
+                 { _Print("DEBUG: T=%-10g ", Time); \
                    _Print f; _Print("\n"); \
         } }while(0)
 #   define DEBUG(c,f) \
     do{ if( SIMLIB_debug_flag & (c) ) \
-            { _Print("DEBUG: T=%-10g ", SIMLIB_Time); \
+            { _Print("DEBUG: T=%-10g ", Time); \
               _Print f; _Print("\n"); \
     } }while(0)
     // classification of DEBUG messages
@@ -147,8 +148,11 @@ extern const SIMLIB_Phase_t &Phase;
    _Pragma("GCC diagnostic pop")
 
 // SIMLIB atexit function (for internal use only)
+// functions are registered per thread, they free thread-local simulator
+// data at program exit (main thread) or by ~Simulator()
 typedef void (*SIMLIB_atexit_function_t)();
 void SIMLIB_atexit(SIMLIB_atexit_function_t p);
+void SIMLIB_atexit_call();      // call and unregister (current thread)
 
 ////////////////////////////////////////////////////////////////////////////
 // error handling functions
@@ -181,34 +185,24 @@ typedef void (*VoidFunctionPtr)(); // ptr to void function
 // internal variables:
 //
 
-extern bool SIMLIB_DynamicFlag;             // in dynamic section
-extern bool SIMLIB_ResetStatus;             // restart flag
-
-extern SIMLIB_Phase_t SIMLIB_Phase;         // phase of simulation experiment
+// (constant-initialized, see SIMLIB_CONSTINIT in simlib.h)
 
-extern Entity *SIMLIB_Current;              // currently active entity
+SIMLIB_CONSTINIT extern thread_local bool SIMLIB_DynamicFlag;     // in dynamic section
+SIMLIB_CONSTINIT extern thread_local bool SIMLIB_ResetStatus;     // restart flag
 
-extern int SIMLIB_ERRNO;                    // error number
-
-extern bool SIMLIB_ConditionFlag;           // change of condition vector
-extern bool SIMLIB_ContractStepFlag;        // requests shorter step
-extern double SIMLIB_ContractStep;          // requested step size
+//! This variable contains the current phase of experiment
+//! (used for internal checking)
+SIMLIB_CONSTINIT extern thread_local SIMLIB_Phase_t SIMLIB_Phase; // phase of simulation experiment
 
-extern double SIMLIB_StepStartTime;         // last step time
-extern double SIMLIB_DeltaTime;             // Time-s_StepStartTime
+SIMLIB_CONSTINIT extern thread_local int SIMLIB_ERRNO;            // error number
 
-extern double SIMLIB_OptStep;               // optimal step
-extern double SIMLIB_MinStep;               // minimal step
-extern double SIMLIB_MaxStep;               // max. step
-extern double SIMLIB_StepSize;              // actual step
+SIMLIB_CONSTINIT extern thread_local bool SIMLIB_ConditionFlag;   // change of condition vector
+SIMLIB_CONSTINIT extern thread_local bool SIMLIB_ContractStepFlag; // requests shorter step
+SIMLIB_CONSTINIT extern thread_local double SIMLIB_ContractStep;  // requested step size
 
-extern double SIMLIB_AbsoluteError;         // absolute error tolerance
-extern double SIMLIB_RelativeError;         // relative error
+SIMLIB_CONSTINIT extern thread_local double SIMLIB_StepStartTime; // last step time
+SIMLIB_CONSTINIT extern thread_local double SIMLIB_DeltaTime;     // Time-s_StepStartTime
 
-extern double SIMLIB_StartTime;       // time of simulation start
-extern double SIMLIB_Time;            // simulation time
-extern double SIMLIB_NextTime;        // next-event time
-extern double SIMLIB_EndTime;         // time of simulation end
 
 // TODO: move to context (public methods with prefix calendar::?)
 
@@ -217,22 +211,191 @@ extern double SIMLIB_EndTime;         // time of simulation end
 //! This is for internal use only.
 namespace SQS {
     void ScheduleAt(Entity *e, double t);// time t
+    void ScheduleBatch(Entity *const *e, unsigned n, double t); // n at t
     Entity *GetFirst();                  // remove first item
     void Get(Entity *e);                 // remove entity e
     bool Empty();                        // ?empty calendar
+    Entity *GetFirst(Entity::Priority_t &p); // remove first, its priority
     void Clear();                        // remove all items
     int debug_print();
 };
 
+////////////////////////////////////////////////////////////////////////////
+// statistics of Queue, Facility and Store
+//
+// SIMLIB_STATISTICS is the compile-time upper bound of statistics level:
+//   0 = no statistics code in Queue/Facility/Store operations
+//   1 = counters of requests only
+//   2 = full statistics (default)
+// use e.g. CXXFLAGS+=-DSIMLIB_STATISTICS=0 for library build
+#ifndef SIMLIB_STATISTICS
+#define SIMLIB_STATISTICS 2
+#endif
+
+SIMLIB_CONSTINIT extern thread_local StatisticsLevel_t SIMLIB_StatisticsLevel; // default for new objects
+
+/// SIMLIB_StatCount: number of records of Stat/TStat changed without value
+/// In STAT_COUNTERS mode only n is valid (mean, m2 and the TStat integral
+/// are not updated), so SetStatisticsLevel() of Queue, Facility and Store
+/// clears the statistics when the level changes -- records of different
+/// levels are never mixed in one object.
+struct SIMLIB_StatCount {
+  static void Add(Stat &s)     { s.n++; }
+  static void Add(TStat &s)    { s.n++; }
+  static void Remove(TStat &s) { s.n--; }
+};
+
+/// SIMLIB_STAT_RECORD: record value x of new request into Stat/TStat st
+/// SIMLIB_STAT_UPDATE: record changed value x without counting (TStat only)
+#if SIMLIB_STATISTICS >= 2
+#define SIMLIB_STAT_RECORD(level,st,x) do { \
+        if ((level) == STAT_FULL) (st)(x); \
+        else if ((level) == STAT_COUNTERS) SIMLIB_StatCount::Add(st); \
+        } while (0)
+#define SIMLIB_STAT_UPDATE(level,st,x) do { \
+        if ((level) == STAT_FULL) { (st)(x); SIMLIB_StatCount::Remove(st); } \
+        } while (0)
+#elif SIMLIB_STATISTICS == 1
+#define SIMLIB_STAT_RECORD(level,st,x) do { \
+        if ((level) != STAT_NONE) SIMLIB_StatCount::Add(st); \
+        } while (0)
+#define SIMLIB_STAT_UPDATE(level,st,x) do { } while (0)
+#else
+#define SIMLIB_STAT_RECORD(level,st,x) do { } while (0)
+#define SIMLIB_STAT_UPDATE(level,st,x) do { } while (0)
+#endif
+
+/// limit statistics level by library compilation setting
+inline StatisticsLevel_t SIMLIB_StatLevelLimit(StatisticsLevel_t level) {
+    return level > SIMLIB_STATISTICS ? StatisticsLevel_t(SIMLIB_STATISTICS)
+                                     : level;
+}
+
 /// macro for simple assignement to internal time variables
-#define _SetTime(t,x) (SIMLIB_##t = x)
+#define _SetTime(t,x) (t = x)
 
 void SIMLIB_Dynamic();               // TODO: optimize!
 void SIMLIB_DoActions();             // dispatch events and processes
 void SIMLIB_ContinueInit();          // initialize variables
+void SIMLIB_ContinueRestore();       // continue restored state (checkpoint)
 void SIMLIB_DoConditions();          // perform state events
 void SIMLIB_WUClear();               // clear WUList
 
+// object is Stat with own data (QuantileStat, BatchMeans), which
+// is not merged by Stat::Merge (replicate.cc)
+bool SIMLIB_StatDerived(const SimObject *o);
+
+// remove interrupted request of entity from PreemptiveFacility (preempt.cc)
+void SIMLIB_InterruptedRemove(Entity *e);
+
+////////////////////////////////////////////////////////////////////////////
+// registry of statistics for ResetStatistics() (warmup.cc)
+// objects are registered by constructors into the list of the current
+// (owning) thread and removed by destructors in O(1); an object may be
+// destroyed in other thread if its owning thread does not run simulation
+struct SIMLIB_StatRegistry {
+  static void Register(Stat *s);
+  static void Register(TStat *s);
+  static void Register(Histogram *h);
+  static void Register(LogHistogram *h);
+  static void Unregister(Stat *s)         { Unlink(s->_reg); }
+  static void Unregister(TStat *s)        { Unlink(s->_reg); }
+  static void Unregister(Histogram *h)    { Unlink(h->_reg); }
+  static void Unregister(LogHistogram *h) { Unlink(h->_reg); }
+  static void Unlink(SIMLIB_StatLink &l); // no-op if not registered
+};
+
+unsigned long long SIMLIB_RandomBits();   // 64 random bits (base generator)
+unsigned long long SIMLIB_RandomMasterSeed();   // last RandomSeed() value
+// random state of replication: master seed and default stream
+void SIMLIB_RandomReplica(unsigned long long master, const RandomStream &s);
+// key of random state set by SIMLIB_RandomReplica() (evaluation cache)
+unsigned long long SIMLIB_RandomKey(unsigned long long master, const RandomStream &s);
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_Snapshot --- binary copy of statistics data
+// Save() writes Size() bytes at p, Merge() adds saved data to object of
+// the same type and parameters; both move p after the data
+struct SIMLIB_Snapshot {
+  static size_t Size(const Stat &s);
+  static void Save(const Stat &s, char *&p);
+  static void Merge(Stat &s, const char *&p);
+  static size_t Size(const TStat &s);
+  static void Save(const TStat &s, char *&p);
+  static void Merge(TStat &s, const char *&p);
+  static size_t Size(const Histogram &h);
+  static void Save(const Histogram &h, char *&p);
+  static void Merge(Histogram &h, const char *&p);
+  // exact copy (checkpoint), Load() replaces data of object
+  static void Load(Stat &s, const char *&p);
+  static void Load(TStat &s, const char *&p);
+  static void Load(Histogram &h, const char *&p);
+  static void Close(TStat &s);  // include last period up to current Time
+};
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_Checkpoint --- save/restore of model objects (checkpoint.cc)
+struct SIMLIB_Checkpoint;
+SIMLIB_CONSTINIT extern thread_local bool SIMLIB_Restored;       // Run() continues checkpoint
+SIMLIB_CONSTINIT extern thread_local unsigned long SIMLIB_Entity_Count; // next entity ident
+RandomStream &SIMLIB_RandomDefault();           // default stream of thread
+void SIMLIB_RandomSetMasterSeed(unsigned long long master);
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_WaitChild --- wait until one of child processes pid[i] ends
+// (forkrep.cc, POSIX), other children of program are not reaped;
+// returns index i and wait status, -1 on error
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+int SIMLIB_WaitChild(const std::vector<pid_t> &pid, int *status);
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_ParallelFor --- call f(i) for i=0..n-1 in worker threads
+// work stealing (idle thread takes upper half of the largest remaining
+// range), threads=0 means number of CPUs; the first exception thrown by
+// f is rethrown after all threads end (the rest of work is skipped)
+void SIMLIB_ParallelFor(unsigned long n, unsigned threads,
+                        const std::function<void(unsigned long)> &f);
+
+// SIMLIB_OptJobs --- run n jobs in worker threads (each with own
+// Simulator) or in child processes (fork=true, POSIX), workers=0 means
+// number of CPUs; done(k,y) gets y=job(k) (in worker thread, or in the
+// caller for processes); failed child: ForkChildError at the end
+void SIMLIB_OptJobs(unsigned long n, unsigned workers, bool fork,
+                    const std::function<double(unsigned long)> &job,
+                    const std::function<void(unsigned long, double)> &done);
+
+// SIMLIB_OptEvaluator --- values f(x[k]) computed by SIMLIB_OptJobs, all
+// evaluations use random state of the caller at construction (common
+// random numbers of parallel optimization methods)
+class ParameterVector;
+struct ParallelOptions;
+class SIMLIB_OptEvaluator {
+  double (*f)(const ParameterVector &);
+  const ParallelOptions &o;
+  RandomStream s;                       // default stream of evaluations
+  unsigned long long master;            // master seed of evaluations
+ public:
+  SIMLIB_OptEvaluator(double (*fn)(const ParameterVector &),
+                      const ParallelOptions &opt) :
+    f(fn), o(opt), s(CurrentRandomStream()),
+    master(SIMLIB_RandomMasterSeed()) {}
+  std::vector<double> operator()(const std::vector<ParameterVector> &x) const;
+  double operator()(const ParameterVector &x) const;    // single point
+};
+
+// SIMLIB_OptCache --- cache set by SetEvaluationCache() or 0
+// (key of random input: SIMLIB_RandomKey() of the run)
+class EvaluationCache;
+EvaluationCache *SIMLIB_OptCache();
+
+// SIMLIB_Sobol --- i-th point of Sobol sequence in [0,1)^dim (dim<=32),
+// direction numbers of Joe and Kuo, point 0 is (0,...,0)
+void SIMLIB_Sobol(unsigned long i, unsigned dim, double *x);
+
+double SIMLIB_NormalQuantile(double p);       // quantile of N(0,1)
+double SIMLIB_StudentQuantile(double p, unsigned long df); // Student's t
+
 
 //////////////////////////////////////////////////////////////////////////
 // MACROS --- Hooks into simulation control algorithm
@@ -265,7 +428,7 @@ void SIMLIB_WUClear();               // clear WUList
 // can be used at global scope
 //
 #define DEFINE_HOOK(name)  \
-        static void (* HOOK_PTR_NAME(name) )() = 0; \
+        static thread_local void (* HOOK_PTR_NAME(name) )() = 0; \
         void HOOK_INST_NAME(name)(void (*f)())  { HOOK_PTR_NAME(name) = f; }
 
 
@@ -29,34 +29,25 @@ namespace simlib3 {
 
 SIMLIB_IMPLEMENTATION;
 
-int SIMLIB_ERRNO=0;
+SIMLIB_CONSTINIT thread_local int SIMLIB_ERRNO=0;
 
-double SIMLIB_StepStartTime;         //!< last step time
-double SIMLIB_DeltaTime;             //!< Time-SIMLIB_StepStartTime
+SIMLIB_CONSTINIT thread_local double SIMLIB_StepStartTime=0;         //!< last step time
+SIMLIB_CONSTINIT thread_local double SIMLIB_DeltaTime=0;             //!< Time-SIMLIB_StepStartTime
 
-double SIMLIB_OptStep;               //!< optimal step
-double SIMLIB_MinStep=1e-10;         //!< minimal step
-double SIMLIB_MaxStep=1;             //!< max. step
-double SIMLIB_StepSize;              //!< actual step
-
-double SIMLIB_AbsoluteError=0;       //!< absolute error
-double SIMLIB_RelativeError=0.001;   //!< relative error
-
-// step limits
-const double &MinStep=SIMLIB_MinStep;        //!< minimal integration step
-const double &MaxStep=SIMLIB_MaxStep;        //!< maximal integration step
-const double &StepSize=SIMLIB_StepSize;      //!< actual integration step
-const double &OptStep=SIMLIB_OptStep;        //!< optimal integration step
-//const double &StepStartTime=SIMLIB_StepStartTime; // start of step
+// step limits (read-only for models)
+SIMLIB_CONSTINIT thread_local double OptStep=0;            //!< optimal step
+SIMLIB_CONSTINIT thread_local double MinStep=1e-10;        //!< minimal step
+SIMLIB_CONSTINIT thread_local double MaxStep=1;            //!< max. step
+SIMLIB_CONSTINIT thread_local double StepSize=0;           //!< actual step
 
 // error params
-const double &AbsoluteError=SIMLIB_AbsoluteError; //!< max. abs. error of integration
-const double &RelativeError=SIMLIB_RelativeError; //!< max. rel. error
+SIMLIB_CONSTINIT thread_local double AbsoluteError=0;      //!< max. abs. error of integration
+SIMLIB_CONSTINIT thread_local double RelativeError=0.001;  //!< max. rel. error
 
-bool SIMLIB_DynamicFlag = false;          //!< in dynamic section
+SIMLIB_CONSTINIT thread_local bool SIMLIB_DynamicFlag = false;          //!< in dynamic section
 
-bool SIMLIB_ContractStepFlag = false;     //!< requests shorter step
-double  SIMLIB_ContractStep = SIMLIB_MAXTIME;    //!< requested step size
+SIMLIB_CONSTINIT thread_local bool SIMLIB_ContractStepFlag = false;     //!< requests shorter step
+SIMLIB_CONSTINIT thread_local double  SIMLIB_ContractStep = SIMLIB_MAXTIME;    //!< requested step size
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -75,15 +66,15 @@ void ContractStep(double time)
   double newCS = time - SIMLIB_StepStartTime;
   if (newCS<SIMLIB_ContractStep)
     SIMLIB_ContractStep = newCS;                // can be only less
-  if (newCS<SIMLIB_MinStep)
-    SIMLIB_ContractStep = SIMLIB_MinStep;       // minimum
+  if (newCS<MinStep)
+    SIMLIB_ContractStep = MinStep;       // minimum
 }
 
 
 ////////////////////////////////////////////////////////////////////////////
 /// \var bool SIMLIB_ResetStatus
 /// flag set if there is a need for integration method restart
-bool SIMLIB_ResetStatus = false;
+SIMLIB_CONSTINIT thread_local bool SIMLIB_ResetStatus = false;
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -91,12 +82,12 @@ bool SIMLIB_ResetStatus = false;
 //
 void SetStep(double _dtmin, double _dtmax)
 {
-  SIMLIB_MinStep = _dtmin;
-  SIMLIB_MaxStep = _dtmax;
-  if (SIMLIB_MinStep>SIMLIB_MaxStep) SIMLIB_error(SetStepError);
-//  if (SIMLIB_MinStep/SIMLIB_MaxStep < 1e-12) SIMLIB_error(SetStepError2);
+  MinStep = _dtmin;
+  MaxStep = _dtmax;
+  if (MinStep>MaxStep) SIMLIB_error(SetStepError);
+//  if (MinStep/MaxStep < 1e-12) SIMLIB_error(SetStepError2);
 //  if(MinStep/tend<1e-15) SIMLIB_error(InitMinStepError); // moznost chyby ???
-  Dprintf(("SetStep: StepSize = %g .. %g ",SIMLIB_MinStep,SIMLIB_MaxStep));
+  Dprintf(("SetStep: StepSize = %g .. %g ",MinStep,MaxStep));
 }
 
 
@@ -105,12 +96,12 @@ void SetStep(double _dtmin, double _dtmax)
 //
 void SetAccuracy(double _abserr, double _relerr)
 {
-  SIMLIB_AbsoluteError = _abserr;
+  AbsoluteError = _abserr;
   if(_relerr>1) _relerr=1;   // 100% error is maximum
-  SIMLIB_RelativeError = _relerr;
-  if(SIMLIB_RelativeError<1e-14) SIMLIB_error(SetAccuracyError);
+  RelativeError = _relerr;
+  if(RelativeError<1e-14) SIMLIB_error(SetAccuracyError);
   Dprintf(("SetAccuracy: maxerror = %g + %g * X ",
-            SIMLIB_AbsoluteError,SIMLIB_RelativeError));
+            AbsoluteError,RelativeError));
 }
 
 void SetAccuracy(double relerr)
@@ -124,8 +115,8 @@ void SetAccuracy(double relerr)
 //
 void SIMLIB_ContinueInit()
 {
-  SIMLIB_OptStep = SIMLIB_MaxStep;        // initial step size
-  SIMLIB_StepStartTime = SIMLIB_Time;
+  OptStep = MaxStep;        // initial step size
+  SIMLIB_StepStartTime = Time;
   SIMLIB_DeltaTime = 0.0;
   if (IntegratorContainer::isAny()
       || StatusContainer::isAny()
@@ -142,6 +133,26 @@ void SIMLIB_ContinueInit()
   }
 }
 
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_ContinueRestore -- continue with state set by RestoreEventCheckpoint
+//  (integrators keep restored values, conditions are evaluated)
+//
+void SIMLIB_ContinueRestore()
+{
+  SIMLIB_StepStartTime = Time;
+  SIMLIB_DeltaTime = 0.0;
+  if (IntegratorContainer::isAny()
+      || StatusContainer::isAny()
+      || Condition::isAny())
+  {
+    SIMLIB_Dynamic();           // restored state evaluation
+    SIMLIB_DynamicFlag = true;
+    Condition::TestAll();
+    SIMLIB_DynamicFlag = false;
+    Condition::SetAll();
+  }
+}
+
 
 /*************************************************/
 /*****  Outline members of class Integrator  *****/
@@ -268,7 +279,7 @@ const char *Integrator::Name() const
 /**********************************************************/
 
 /// list of integrators
-std::list<Integrator*>* IntegratorContainer::ListPtr=NULL;
+SIMLIB_CONSTINIT thread_local std::list<Integrator*>* IntegratorContainer::ListPtr=NULL;
 
 ////////////////////////////////////////////////////////////////////////////
 //  IntegratorContainer::Instance
@@ -478,7 +489,7 @@ void Status::Eval()
 /******************************************************/
 
 /// list of status variables
-std::list<Status*>* StatusContainer::ListPtr=NULL;
+SIMLIB_CONSTINIT thread_local std::list<Status*>* StatusContainer::ListPtr=NULL;
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,273 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file loghisto.cc  Log-linear (HDR) histogram
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class LogHistogram implementation
+//
+//  Values are scaled by 1/unit to integers. Range [0,2^h) is divided into
+//  2^h bins of width 1 (h is given by number of significant digits), each
+//  following power of 2 range [2^k,2^(k+1)) into 2^(h-1) bins of width
+//  2^(k-h+1). Relative error of bin is less than 10^-digits.
+//  Bin index is computed using count of leading zeros and shifts:
+//
+//    bucket = log2(v|mask) - h + 1;   sub = v >> bucket
+//    index  = (bucket+1) * 2^(h-1) + sub - 2^(h-1)
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cmath>        // ceil, log2, pow
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+// values >= 2^63 (scaled) can not be stored
+static const double MAXSCALED = 9223372036854775808.0;
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+LogHistogram::LogHistogram(double u, unsigned d, double h) :
+  counts(0), len(0),
+  unit(u), rate(0), highest(h),
+  digits(d), halfmag(0),
+  total(0), under(0), over(0)
+{
+  Dprintf(("LogHistogram::LogHistogram(%g,%u,%g)", u, d, h));
+  Init();
+}
+
+LogHistogram::LogHistogram(const char *n, double u, unsigned d, double h) :
+  counts(0), len(0),
+  unit(u), rate(0), highest(h),
+  digits(d), halfmag(0),
+  total(0), under(0), over(0)
+{
+  Dprintf(("LogHistogram::LogHistogram(\"%s\",%g,%u,%g)", n, u, d, h));
+  SetName(n);
+  Init();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Init --- check parameters, allocate bins
+//
+void LogHistogram::Init()
+{
+  if (unit <= 0 || digits < 1 || digits > 5 || highest < 0)
+    SIMLIB_error(LogHistoError);
+  rate = 1 / unit;
+  // number of subbuckets: 2^h >= 2*10^digits
+  unsigned h = unsigned(ceil(log2(2 * pow(10.0, digits))));
+  halfmag = h - 1;
+  if (highest > 0) {
+    if (highest * rate >= MAXSCALED)
+      SIMLIB_error(LogHistoError);
+    Resize(Index((unsigned long long)(highest * rate)) + 1);
+  } else
+    Resize(4U << halfmag);      // first 3 power of 2 ranges
+  SIMLIB_StatRegistry::Register(this);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+LogHistogram::~LogHistogram()
+{
+  Dprintf(("LogHistogram::~LogHistogram() // \"%s\" ", Name().c_str()));
+  SIMLIB_StatRegistry::Unregister(this);
+  delete [] counts;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Index --- bin of scaled value v
+//
+inline unsigned LogHistogram::Index(unsigned long long v) const
+{
+  unsigned long long mask = (2ULL << halfmag) - 1;
+  int bucket = 64 - __builtin_clzll(v | mask) - int(halfmag + 1);
+  unsigned sub = unsigned(v >> bucket);
+  return ((bucket + 1) << halfmag) + sub - (1U << halfmag);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  BinLow --- scaled low bound of bin i
+//
+unsigned long long LogHistogram::BinLow(unsigned i) const
+{
+  int bucket = int(i >> halfmag) - 1;
+  unsigned long long sub = (i & ((1U << halfmag) - 1)) + (1U << halfmag);
+  if (bucket < 0) {
+    sub -= 1U << halfmag;
+    bucket = 0;
+  }
+  return sub << bucket;
+}
+
+double LogHistogram::Low(unsigned i) const
+{
+  return BinLow(i) * unit;
+}
+
+double LogHistogram::High(unsigned i) const
+{
+  int bucket = int(i >> halfmag) - 1;
+  return (BinLow(i) + (1ULL << (bucket < 0 ? 0 : bucket))) * unit;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Resize --- change number of bins (contents is preserved)
+//
+void LogHistogram::Resize(unsigned n)
+{
+  Dprintf(("LogHistogram::Resize(%u)", n));
+  unsigned long *p = new unsigned long[n];
+  unsigned i = 0;
+  for (; i < len && i < n; i++)
+    p[i] = counts[i];
+  for (; i < n; i++)
+    p[i] = 0;
+  delete [] counts;
+  counts = p;
+  len = n;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator [] --- number of values in bin i
+//
+unsigned long LogHistogram::operator [] (unsigned i) const
+{
+  return i < len ? counts[i] : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator ()  - value recording
+//
+void LogHistogram::operator () (double x)
+{
+  stat(x);
+  if (x < 0) {
+    under++;
+    return;
+  }
+  double s = x * rate;
+  if (s >= MAXSCALED || (highest > 0 && x > highest)) {
+    over++;
+    return;
+  }
+  unsigned i = Index((unsigned long long)s);
+  if (i >= len)                 // auto-ranging: add power of 2 ranges
+    Resize(((i >> halfmag) + 2) << halfmag);
+  counts[i]++;
+  total++;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Merge --- add counts of other histogram (same unit and digits)
+//
+void LogHistogram::Merge(const LogHistogram &h)
+{
+  Dprintf(("LogHistogram::Merge(\"%s\")", h.Name().c_str()));
+  if (unit != h.unit || digits != h.digits)
+    SIMLIB_error(LogHistoMergeError);
+  if (h.len > len)
+    Resize(h.len);
+  for (unsigned i = 0; i < h.len; i++)
+    counts[i] += h.counts[i];
+  total += h.total;
+  under += h.under;
+  over += h.over;
+  stat.Merge(h.stat);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Clear --- initialize
+//
+void LogHistogram::Clear()
+{
+  Dprintf(("LogHistogram::Clear()"));
+  for (unsigned i = 0; i < len; i++)
+    counts[i] = 0;
+  total = under = over = 0;
+  stat.Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Quantile --- estimate of q-quantile (middle of bin)
+//
+double LogHistogram::Quantile(double q) const
+{
+  if (q < 0 || q > 1)
+    SIMLIB_error(LogHistoError);
+  unsigned long n = under + total + over;
+  if (n == 0)
+    SIMLIB_error(StatNoRecError);
+  unsigned long target = (unsigned long)ceil(q * n);
+  if (target == 0)
+    target = 1;
+  if (target <= under)
+    return stat.Min();
+  unsigned long s = under;
+  for (unsigned i = 0; i < len; i++) {
+    s += counts[i];
+    if (s >= target) {
+      double x = (Low(i) + High(i)) / 2;
+      if (x < stat.Min()) x = stat.Min();
+      if (x > stat.Max()) x = stat.Max();
+      return x;
+    }
+  }
+  return stat.Max();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print statistics and non-empty bins
+//
+void LogHistogram::Output() const
+{
+  Print("+----------------------------------------------------------+\n");
+  Print("| LOG HISTOGRAM %-42s |\n", Name().c_str());
+  stat.Output();
+  unsigned long n = under + total + over;
+  if (n == 0)
+    return;
+  Print("|    from    |     to     |     n    |   rel    |   sum    |\n");
+  Print("+------------+------------+----------+----------+----------+\n");
+  unsigned long s = under;
+  if (under > 0)
+    Print("|       -inf | %10.4g | %8lu | %8.6f | %8.6f |\n",
+          0.0, under, (double)under/n, (double)s/n);
+  for (unsigned i = 0; i < len; i++) {
+    unsigned long x = counts[i];
+    if (x == 0)
+      continue;
+    s += x;
+    Print("| %10.4g | %10.4g | %8lu | %8.6f | %8.6f |\n",
+          Low(i), High(i), x, (double)x/n, (double)s/n);
+  }
+  if (over > 0) {
+    s += over;
+    Print("| %10.4g |       +inf | %8lu | %8.6f | %8.6f |\n",
+          highest > 0 ? highest : MAXSCALED * unit, over,
+          (double)over/n, (double)s/n);
+  }
+  Print("+------------+------------+----------+----------+----------+\n");
+  Print("\n");
+}
+
+} // namespace
+
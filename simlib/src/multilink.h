@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file multilink.h   Intrusive lists with multiple membership
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  Link allows an object to be in single List/Queue only.
+//  MultiLink<N> adds N independent intrusive hooks to the object,
+//  so it can be member of up to N HookLists at once (one per hook).
+//  Insert/remove operations are O(1) and do not allocate memory.
+//
+//  Example:
+//
+//    class Order : public Process, public MultiLink<2> { ... };
+//    HookList<Order,0> open_orders;    // uses hook 0
+//    HookList<Order,1> urgent;         // uses hook 1
+//    ...
+//    open_orders.InsLast(this);        // can be in both lists
+//    urgent.Insert(this);              // and in Queue (via Link)
+//    Unlink<1>();                      // remove from urgent only
+//
+
+#ifndef __SIMLIB__
+#   error "multilink.h: 27: you should include simlib.h first"
+#endif
+#if __SIMLIB__ < 0x0308
+#   error "multilink.h: 30: requires SIMLIB version 3.08 and higher"
+#endif
+
+#include <cstddef>      // offsetof
+
+namespace simlib3 {
+
+class HookListBase;
+
+////////////////////////////////////////////////////////////////////////////
+//! single intrusive hook (links for one membership)
+struct ListHook {
+    ListHook *pred;             //!< previous item in list
+    ListHook *succ;             //!< next item in list
+    HookListBase *head;         //!< list containing this item (if any)
+    ListHook() : pred(this), succ(this), head(0) {}
+    inline void unlink();       //!< remove from list (if linked)
+};
+
+////////////////////////////////////////////////////////////////////////////
+//! common (non-template) part of HookList: circular list with head
+class HookListBase {
+    HookListBase(const HookListBase&);          // disable copy ctor
+    void operator= (const HookListBase&);       // disable assignment
+  protected:
+    ListHook root;              //!< list head (sentinel)
+    unsigned n;                 //!< number of items in list
+    friend struct ListHook;
+    //! insert h before position pos
+    void link(ListHook *h, ListHook *pos) {
+        h->unlink();            // if in list then remove (as Link::Into)
+        h->succ = pos;
+        h->pred = pos->pred;
+        pos->pred->succ = h;
+        pos->pred = h;
+        h->head = this;
+        ++n;
+    }
+    HookListBase() : n(0) {}
+    ~HookListBase() { clear(); }
+  public:
+    unsigned size() const { return n; }
+    bool empty() const { return n == 0; }
+    //! remove all items (objects are not deleted)
+    void clear() { while (root.succ != &root) root.succ->unlink(); }
+};
+
+inline void ListHook::unlink()
+{
+    if (!head)
+        return;
+    pred->succ = succ;
+    succ->pred = pred;
+    pred = succ = this;
+    --head->n;
+    head = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//! base class adding N intrusive hooks to derived class
+/// the object is removed from all HookLists by destructor
+template <unsigned N>
+class MultiLink {
+    ListHook hooks[N];
+    template <class T, unsigned I> friend class HookList;
+  public:
+    typedef MultiLink<N> MultiLinkType; //!< used by HookList
+    enum { Hooks = N };                 //!< number of hooks
+    MultiLink() {}
+    MultiLink(const MultiLink&) {}      // copy is not linked
+    MultiLink &operator= (const MultiLink&) { return *this; }
+    ~MultiLink() { for (unsigned i = 0; i < N; ++i) hooks[i].unlink(); }
+    //! hook I is linked in some list
+    template <unsigned I> bool IsLinked() const {
+        static_assert(I < N, "MultiLink: hook index out of range");
+        return hooks[I].head != 0;
+    }
+    //! remove from list using hook I
+    template <unsigned I> void Unlink() {
+        static_assert(I < N, "MultiLink: hook index out of range");
+        hooks[I].unlink();
+    }
+    //! remove from all lists
+    void UnlinkAll() { for (unsigned i = 0; i < N; ++i) hooks[i].unlink(); }
+};
+
+////////////////////////////////////////////////////////////////////////////
+//! intrusive list of T objects using hook I of MultiLink base of T
+template <class T, unsigned I>
+class HookList : public HookListBase {
+    // T can be incomplete at declaration of HookList object
+    static ListHook *hook(T *p) {
+        typedef typename T::MultiLinkType Base;
+        static_assert(I < Base::Hooks, "HookList: hook index out of range");
+        return &static_cast<Base*>(p)->hooks[I];
+    }
+    static T *object(ListHook *h) {
+        typedef typename T::MultiLinkType Base;
+        char *p = reinterpret_cast<char*>(h - I) - offsetof(Base, hooks);
+        return static_cast<T*>(reinterpret_cast<Base*>(p));
+    }
+  public:
+    class iterator {
+        ListHook *p; // position in list
+      public:
+        explicit iterator(ListHook *pos) : p(pos) {}
+        iterator &operator++() { p = p->succ; return *this; }
+        iterator &operator--() { p = p->pred; return *this; }
+        iterator operator++(int) { iterator t(*this); p = p->succ; return t; }
+        iterator operator--(int) { iterator t(*this); p = p->pred; return t; }
+        T *operator*() const { return object(p); }
+        bool operator != (iterator q) const { return p != q.p; }
+        bool operator == (iterator q) const { return p == q.p; }
+        friend class HookList;
+    }; // iterator
+    HookList() {}
+    iterator begin() { return iterator(root.succ); }
+    iterator end()   { return iterator(&root); }
+    T *front()       { return empty() ? 0 : object(root.succ); }
+    T *back()        { return empty() ? 0 : object(root.pred); }
+    //! test if p is in this list
+    bool contains(T *p) { return hook(p)->head == this; }
+    void InsFirst(T *p) { link(hook(p), root.succ); }
+    void InsLast(T *p)  { link(hook(p), &root); }
+    //! insert before position pos (can be end())
+    void PredIns(T *p, iterator pos) { link(hook(p), pos.p); }
+    //! insert after position pos
+    void PostIns(T *p, iterator pos) { link(hook(p), pos.p->succ); }
+    //! priority insert (higher Priority first, FIFO for equal priority)
+    void Insert(T *p) {
+        ListHook *pos = &root;  // search from end (usual case)
+        while (pos->pred != &root && object(pos->pred)->Priority < p->Priority)
+            pos = pos->pred;
+        link(hook(p), pos);
+    }
+    //! remove object from list
+    T *Get(T *p) { if (contains(p)) hook(p)->unlink(); return p; }
+    //! remove object at position pos
+    T *Get(iterator pos) { T *p = *pos; pos.p->unlink(); return p; }
+    T *GetFirst() { return empty() ? 0 : Get(begin()); }
+    T *GetLast()  { return empty() ? 0 : Get(--end()); }
+}; // HookList
+
+} // namespace
+
@@ -59,9 +59,9 @@ void ABM4::Integrate(void)
   Iterator ip, end_it; // for loops to go through container of integrators
   bool DoubleStepFlag; // allows doubling step
   // WARNING: following variables must be static !!!
-  static double PrevStep; // previous stepsize
-  static int ind = 0; // base index to arrays with values from previous steps
-  static int DoubleCount = 0; // number of good steps for doubling stepsize
+  static thread_local double PrevStep; // previous stepsize
+  static thread_local int ind = 0; // base index to arrays with values from previous steps
+  static thread_local int DoubleCount = 0; // number of good steps for doubling stepsize
 
   Dprintf((" ABM4 integration step ")); // print debugging info
   Dprintf((" Time = %g, optimal step = %g", (double)Time, OptStep));
@@ -75,13 +75,13 @@ void ABM4::Integrate(void)
 
 begin_step:
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
 
-  if(ABM_Count>0 && PrevStep!=SIMLIB_StepSize) { // stepsize has been changed
+  if(ABM_Count>0 && PrevStep!=StepSize) { // stepsize has been changed
     ABM_Count = 0;
     Dprintf(("NEW START, Time = %g",(double)Time));
   }
-  PrevStep = SIMLIB_StepSize;
+  PrevStep = StepSize;
 
   Dprintf(("counter: %d, Time = %g",ABM_Count,(double)Time));
 
@@ -90,7 +90,7 @@ begin_step:
     //-----------------------------------------------------------------------
 
   if(ABM_Count <= abm_ord-2) {
-    Dprintf(("start, step = %g, Time = %g",SIMLIB_StepSize,(double)Time));
+    Dprintf(("start, step = %g, Time = %g",StepSize,(double)Time));
     ind = 0;
     DoubleCount = 0;
     for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
@@ -105,9 +105,9 @@ begin_step:
 
   } else {
     SIMLIB_ContractStepFlag = false; // clear reduce step flag
-    SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // reduce to quater of step
+    SIMLIB_ContractStep = 0.5*StepSize; // reduce to quater of step
     Dprintf(("own-method, step = %g, Time = %g",
-             SIMLIB_StepSize,(double)Time));
+             StepSize,(double)Time));
 
     //-----------------------------------------------------------------------
     //  compute predictor
@@ -122,11 +122,11 @@ begin_step:
                       - 59.0 * Z[(ind+2)%abm_ord][i]
                       + 37.0 * Z[(ind+1)%abm_ord][i]
                       -  9.0 * Z[ind][i]
-                    ) * (SIMLIB_StepSize / 24.0)
+                    ) * (StepSize / 24.0)
                   );
     }
 
-    _SetTime(Time,SIMLIB_StepStartTime + SIMLIB_StepSize); // endpoint time
+    _SetTime(Time,SIMLIB_StepStartTime + StepSize); // endpoint time
     SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
     SIMLIB_Dynamic();  // evaluate new state of model
     ind=(ind+1)%abm_ord; // increment base index
@@ -141,7 +141,7 @@ begin_step:
                         + 19.0 * Z[(ind+2)%abm_ord][i]
                         -  5.0 * Z[(ind+1)%abm_ord][i]
                         +        Z[ind][i]
-                      ) * (SIMLIB_StepSize / 24.0)
+                      ) * (StepSize / 24.0)
                   );
     }
 
@@ -155,18 +155,18 @@ begin_step:
       double terr; // greatest allowed error
 
       eerr = 0.5 * fabs(PRED[i] - (*ip)->GetState()); // error estimation
-      terr = SIMLIB_AbsoluteError + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+      terr = AbsoluteError + fabs(RelativeError*(*ip)->GetState());
 
       if(eerr < err_lo*terr) // tolerantion is fulfiled with provision
         continue;
 
       if(eerr > err_hi*terr) { // tolerantion is overfulfiled
-        if(SIMLIB_StepSize>SIMLIB_MinStep) {     // reducing step is possible
-          SIMLIB_OptStep = 0.25*SIMLIB_StepSize; // quater optimal step
-          if(SIMLIB_OptStep < SIMLIB_MinStep) {  // limit of optimal step
-            SIMLIB_OptStep = SIMLIB_MinStep;
+        if(StepSize>MinStep) {     // reducing step is possible
+          OptStep = 0.25*StepSize; // quater optimal step
+          if(OptStep < MinStep) {  // limit of optimal step
+            OptStep = MinStep;
           }
-          SIMLIB_StepSize = SIMLIB_OptStep;
+          StepSize = OptStep;
           IsEndStepEvent = false;
           goto begin_step; // compute again with smaller step
         }
@@ -176,7 +176,7 @@ begin_step:
         if(SIMLIB_ConditionFlag) // event was in half step, step reducing was
           break;                 // unpossible and accuracy cannot be achieved
       }
-      DoubleStepFlag = false;    // disable increasing SIMLIB_OptStep,
+      DoubleStepFlag = false;    // disable increasing OptStep,
     }                            // accuracy is sufficient, but not well
     if(SIMLIB_ERRNO) {
       SIMLIB_warning(AccuracyError);
@@ -204,7 +204,7 @@ begin_step:
     // increase stepsize
     if(DoubleCount >= max_dbl) {
       DoubleCount = 0;
-      SIMLIB_OptStep=min(SIMLIB_MaxStep, 2.0*SIMLIB_StepSize);
+      OptStep=min(MaxStep, 2.0*StepSize);
     }
   }
 } // ABM4::Integrate
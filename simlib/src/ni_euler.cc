@@ -46,10 +46,10 @@ SIMLIB_IMPLEMENTATION;
 void EULER::Integrate(void)
 {
   const double err_coef = 0.02; // limits an error range
-  static double dthlf;   // half step
+  static thread_local double dthlf;   // half step
   size_t i;   // auxiliary variables for loops to go through list
   Iterator ip, end_it; // of integrators
-  static bool DoubleStepFlag; // flag - allow increasing (doubling) the step
+  static thread_local bool DoubleStepFlag; // flag - allow increasing (doubling) the step
 
   Dprintf((" Euler integration step ")); // print debugging info
   Dprintf((" Time = %g, optimal step = %g", (double)Time, OptStep));
@@ -62,9 +62,9 @@ void EULER::Integrate(void)
 
 begin_step: // beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
 
-  dthlf = 0.5*SIMLIB_StepSize;     // half step
+  dthlf = 0.5*StepSize;     // half step
 
   SIMLIB_ContractStepFlag = false; // clear reduce step flag
   SIMLIB_ContractStep = 0.5*dthlf; // implicitly reduce to half
@@ -99,8 +99,8 @@ begin_step: // beginning of step
 
   //////////////////////////////////////////////////////////// end of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + SIMLIB_StepSize);
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time, SIMLIB_StepStartTime + StepSize);
+  SIMLIB_DeltaTime = StepSize;
 
   SIMLIB_Dynamic();  // compute new state of model                  (2)
 
@@ -114,19 +114,19 @@ begin_step: // beginning of step
     double eerr; // estimated error
     double terr; // greatest allowed error
 
-    eerr = fabs(SIMLIB_StepSize*A[i]); // error estimation
-    terr = SIMLIB_AbsoluteError + fabs(SIMLIB_RelativeError*si[i]);
+    eerr = fabs(StepSize*A[i]); // error estimation
+    terr = AbsoluteError + fabs(RelativeError*si[i]);
 
     if(eerr < err_coef*terr) // allowed tolerantion is fulfiled with provision
       continue;
 
     if(eerr > terr) {        // allowed tolerantion is overfulfiled
-      if(SIMLIB_StepSize > SIMLIB_MinStep) {  // reducing step is possible
-        SIMLIB_OptStep = 0.5*SIMLIB_StepSize; // halve optimal step
-        if(SIMLIB_OptStep < SIMLIB_MinStep) { // limit of optimal step
-          SIMLIB_OptStep = SIMLIB_MinStep;
+      if(StepSize > MinStep) {  // reducing step is possible
+        OptStep = 0.5*StepSize; // halve optimal step
+        if(OptStep < MinStep) { // limit of optimal step
+          OptStep = MinStep;
         }
-        SIMLIB_StepSize = SIMLIB_OptStep;
+        StepSize = OptStep;
         IsEndStepEvent = false;
         goto begin_step; // compute again with smaller step
       }
@@ -137,7 +137,7 @@ begin_step: // beginning of step
         break;
     }
 
-    DoubleStepFlag = false;  // disable increasing SIMLIB_OptStep,
+    DoubleStepFlag = false;  // disable increasing OptStep,
                              // accuracy is sufficient, but not well
   } // for
 
@@ -176,9 +176,9 @@ begin_step: // beginning of step
   // step increasing is allowed
   // && method is not used to start multi-step method
   if(DoubleStepFlag && !IsStartMode()) {
-    SIMLIB_OptStep += SIMLIB_OptStep; // step doubling
+    OptStep += OptStep; // step doubling
   }
-  SIMLIB_OptStep = min(SIMLIB_OptStep,SIMLIB_MaxStep); // limit step size
+  OptStep = min(OptStep,MaxStep); // limit step size
 
 } // EULER::Integrate
 
@@ -53,10 +53,10 @@ void FW::Integrate(void)
   bool FWMayDouble;       // accuracy has been very good
   // WARNING: following variables must be static!
   // others are static only for efficiency
-  static int FWDoubleCount;   // counter of doubling step requestes in FW
-  static int EulDoubleCount;  // counter of doubling step requestes in Euler
-  static double Eul_StepSize; // step of Euler's method
-  static double PrevStep;     // previous FW step
+  static thread_local int FWDoubleCount;   // counter of doubling step requestes in FW
+  static thread_local int EulDoubleCount;  // counter of doubling step requestes in Euler
+  static thread_local double Eul_StepSize; // step of Euler's method
+  static thread_local double PrevStep;     // previous FW step
 
   Dprintf((" Fowler-Warten integration step ")); // print debugging info
   Dprintf((" Time = %g, optimal step = %g", (double)Time, OptStep));
@@ -70,7 +70,7 @@ void FW::Integrate(void)
   if(FW_First) { // method is called first time -> authomatic start
     FWDoubleCount  = 0;
     EulDoubleCount = 0;
-    Eul_StepSize   = eul_step_rat*SIMLIB_StepSize;
+    Eul_StepSize   = eul_step_rat*StepSize;
   }
 
   //--------------------------------------------------------------------------
@@ -79,9 +79,9 @@ void FW::Integrate(void)
 
 begin_step: // beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
   SIMLIB_ContractStepFlag = false; // clear reduce step flag
-  SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // reduce to half step
+  SIMLIB_ContractStep = 0.5*StepSize; // reduce to half step
 
   //--------------------------------------------------------------------------
   //  Substep of Euler's method
@@ -89,11 +89,11 @@ begin_step: // beginning of step
 
 euler_step: // beginning of Euler's step
 
-  Eul_StepSize = max(Eul_StepSize, eul_step_coef*SIMLIB_MinStep); // low limit
-  Eul_StepSize = min(Eul_StepSize, eul_step_coef*SIMLIB_StepSize); // high
+  Eul_StepSize = max(Eul_StepSize, eul_step_coef*MinStep); // low limit
+  Eul_StepSize = min(Eul_StepSize, eul_step_coef*StepSize); // high
 
-  Dprintf(("E_MIN: %g, E_MAX %g", eul_step_coef*SIMLIB_MinStep,
-          eul_step_coef*SIMLIB_StepSize));
+  Dprintf(("E_MIN: %g, E_MAX %g", eul_step_coef*MinStep,
+          eul_step_coef*StepSize));
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
     // state y(t+he) = y + he * y'
@@ -115,7 +115,7 @@ euler_step: // beginning of Euler's step
 
     // error estimation
     eerr = Eul_StepSize*fabs((*ip)->GetDiff() - (*ip)->GetOldDiff());
-    terr = SIMLIB_AbsoluteError + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+    terr = AbsoluteError + fabs(RelativeError*(*ip)->GetState());
 
     if(eerr < eul_err_coef*terr) // tolerantion is fulfiled with provision
       continue;
@@ -123,9 +123,9 @@ euler_step: // beginning of Euler's step
     EulDoubleStepFlag = false; // disable increasing Eul_StepSize
 
     if(eerr > terr) { // allowed tolerantion is overfulfiled
-      if(Eul_StepSize>eul_step_coef*SIMLIB_MinStep) { // reducing is possible
+      if(Eul_StepSize>eul_step_coef*MinStep) { // reducing is possible
         // halve Euler's step with limit
-        Eul_StepSize = max(0.5*Eul_StepSize, eul_step_coef*SIMLIB_MinStep);
+        Eul_StepSize = max(0.5*Eul_StepSize, eul_step_coef*MinStep);
         goto euler_step; // compute again with smaller step
       }
       // reducing step is unpossible
@@ -164,7 +164,7 @@ euler_step: // beginning of Euler's step
   // increase step for Euler's method
   if(EulDoubleCount >= eul_max_count) {
     EulDoubleCount = 0;
-    Eul_StepSize=min(eul_step_coef*SIMLIB_StepSize, 2.0*Eul_StepSize);
+    Eul_StepSize=min(eul_step_coef*StepSize, 2.0*Eul_StepSize);
   }
 
   Dprintf(("E_S: %g", Eul_StepSize));
@@ -186,19 +186,19 @@ euler_step: // beginning of Euler's step
     d1  = (*ip)->GetOldDiff() - yia;
     d2  = ((*ip)->GetDiff() - (*ip)->GetOldDiff())/Eul_StepSize;
     ll  = (d1<=prec && d1>=-prec) ? 0 : (d2/d1);
-    denom = SIMLIB_StepSize * ll;
+    denom = StepSize * ll;
     c1  = (denom >= -prec)
           ? (1.0 + 0.5 * denom)
           : ((exp(denom) - 1.0) / denom);
     c0  = (ll>=0) ? (1.0 + denom)
                   : exp(denom);
     // state
-    (*ip)->SetState((*ip)->GetOldState() + SIMLIB_StepSize * (yia + c1 * d1));
+    (*ip)->SetState((*ip)->GetOldState() + StepSize * (yia + c1 * d1));
     ERR[i] = yia + c0 * d1;
   }
 
-  _SetTime(Time,SIMLIB_StepStartTime + SIMLIB_StepSize); // set time to t+h
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time,SIMLIB_StepStartTime + StepSize); // set time to t+h
+  SIMLIB_DeltaTime = StepSize;
   SIMLIB_Dynamic(); // compute new state of model
 
   //--------------------------------------------------------------------------
@@ -211,19 +211,19 @@ euler_step: // beginning of Euler's step
     double eerr; // estimated error
     double terr; // greatest allowed error
 
-    eerr = SIMLIB_StepSize*fabs((*ip)->GetDiff() - ERR[i]); // estimation
-    terr = SIMLIB_AbsoluteError + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+    eerr = StepSize*fabs((*ip)->GetDiff() - ERR[i]); // estimation
+    terr = AbsoluteError + fabs(RelativeError*(*ip)->GetState());
 
     if(eerr > fw_err_rnghi*terr) {
       // allowed tolerantion is overfulfiled,
       // halve stepsize and compute again
       FWDoubleStepFlag = false;
-      if(SIMLIB_StepSize > SIMLIB_MinStep) {  // reducing step is possible
-        SIMLIB_OptStep = 0.5*SIMLIB_StepSize; // halve optimal step
-        if(SIMLIB_OptStep < SIMLIB_MinStep) { // limit of optimal step
-          SIMLIB_OptStep = SIMLIB_MinStep;
+      if(StepSize > MinStep) {  // reducing step is possible
+        OptStep = 0.5*StepSize; // halve optimal step
+        if(OptStep < MinStep) { // limit of optimal step
+          OptStep = MinStep;
         }
-        SIMLIB_StepSize = SIMLIB_OptStep;
+        StepSize = OptStep;
         IsEndStepEvent = false;
         goto begin_step; // compute again with smaller step
       }
@@ -269,12 +269,12 @@ euler_step: // beginning of Euler's step
     Y1[i] = (*ip)->GetOldDiff();
   }
   FW_First = false;
-  PrevStep = SIMLIB_StepSize;
+  PrevStep = StepSize;
 
   // if accuracy hasn't been good, reduce step
   if(FWHalveStepFlag) { // halving takes precedence over doubling
     FWDoubleCount = 0;
-    SIMLIB_OptStep = 0.5*SIMLIB_OptStep;
+    OptStep = 0.5*OptStep;
     Dprintf(("Reducing"));
   } // if accuracy has been good, increase counter
   else if(FWDoubleStepFlag) {
@@ -288,12 +288,12 @@ euler_step: // beginning of Euler's step
   // increase step for FW method
   if(FWDoubleCount >= fw_max_count) {
     FWDoubleCount = 0;
-    SIMLIB_OptStep += SIMLIB_OptStep;
+    OptStep += OptStep;
     Dprintf(("Doubling"));
   }
-  SIMLIB_OptStep = min(SIMLIB_OptStep,SIMLIB_MaxStep);
-  SIMLIB_OptStep = max(SIMLIB_OptStep,SIMLIB_MinStep);
-  Dprintf(("Step: %g", SIMLIB_OptStep));
+  OptStep = min(OptStep,MaxStep);
+  OptStep = max(OptStep,MinStep);
+  Dprintf(("Step: %g", OptStep));
 
 } // FW::Integrate
 
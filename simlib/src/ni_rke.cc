@@ -54,9 +54,9 @@ SIMLIB_IMPLEMENTATION;
 void RKE::Integrate(void)
 {
   static const double err_coef = 0.02; // limits an error range
-  static double dthlf;         // half step
-  static double dtqrt;         // quater step
-  static bool DoubleStepFlag;  // flag - allow increasing (doubling) the step
+  static thread_local double dthlf;         // half step
+  static thread_local double dtqrt;         // quater step
+  static thread_local bool DoubleStepFlag;  // flag - allow increasing (doubling) the step
   size_t i;   // auxiliary variables for loops to go through list
   Iterator ip, end_it; // of integrators
 
@@ -73,8 +73,8 @@ begin_step:
 
   ///////////////////////////////////////////////////////// beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
-  dthlf = 0.5*SIMLIB_StepSize; // half step
+  StepSize = max(StepSize, MinStep); // low step limit
+  dthlf = 0.5*StepSize; // half step
   dtqrt = 0.5*dthlf;           // quater step
 
   SIMLIB_ContractStepFlag = false; // clear reduce step flag
@@ -164,8 +164,8 @@ begin_step:
 
   //////////////////////////////////////////////////////////// end of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + SIMLIB_StepSize);
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time, SIMLIB_StepStartTime + StepSize);
+  SIMLIB_DeltaTime = StepSize;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (7)
 
@@ -186,18 +186,18 @@ begin_step:
                   +   4.0 * A7[i]
                   - dthlf * (*ip)->GetDiff()
                 ) / 90.0);  // error estimation
-    terr = SIMLIB_AbsoluteError + fabs(SIMLIB_RelativeError*si[i]);
+    terr = AbsoluteError + fabs(RelativeError*si[i]);
 
     if(eerr < err_coef*terr) // allowed tolerantion is fulfiled with provision
       continue;
 
     if(eerr > terr) {        // allowed tolerantion is overfulfiled
-      if(SIMLIB_StepSize>SIMLIB_MinStep) {    // reducing step is possible
-        SIMLIB_OptStep = 0.5*SIMLIB_StepSize; // halve optimal step
-        if(SIMLIB_OptStep < SIMLIB_MinStep) { // limit of optimal step
-          SIMLIB_OptStep = SIMLIB_MinStep;
+      if(StepSize>MinStep) {    // reducing step is possible
+        OptStep = 0.5*StepSize; // halve optimal step
+        if(OptStep < MinStep) { // limit of optimal step
+          OptStep = MinStep;
         }
-        SIMLIB_StepSize = SIMLIB_OptStep;
+        StepSize = OptStep;
         IsEndStepEvent = false;
         goto begin_step; // compute again with smaller step
       }
@@ -207,7 +207,7 @@ begin_step:
       if(SIMLIB_ConditionFlag) // event was in half step, step reducing was
         break;                 // unpossible and accuracy cannot be achieved
     }
-    DoubleStepFlag = false;    // disable increasing SIMLIB_OptStep,
+    DoubleStepFlag = false;    // disable increasing OptStep,
   }                            // accuracy is sufficient, but not well
   if(SIMLIB_ERRNO) {
     SIMLIB_warning(AccuracyError);
@@ -251,9 +251,9 @@ begin_step:
   // step increasing is allowed
   // && method is not used to start multi-step method
   if(DoubleStepFlag && !IsStartMode()) {
-    SIMLIB_OptStep += SIMLIB_OptStep; // step doubling
+    OptStep += OptStep; // step doubling
   }
-  SIMLIB_OptStep = min(SIMLIB_OptStep,SIMLIB_MaxStep); // limit step size
+  OptStep = min(OptStep,MaxStep); // limit step size
 
 } // RKE::Integrate
 
@@ -68,45 +68,45 @@ begin_step:
 
   ///////////////////////////////////////////////////////// beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
 
   SIMLIB_ContractStepFlag = false;           // clear reduce step flag
-  SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // implicitly reduce to half step
+  SIMLIB_ContractStep = 0.5*StepSize; // implicitly reduce to half step
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A1[i]  = SIMLIB_StepSize*(*ip)->GetOldDiff(); // compute coefficient
+    A1[i]  = StepSize*(*ip)->GetOldDiff(); // compute coefficient
     (*ip)->SetState((*ip)->GetOldState() + 0.5*A1[i]); // state (y) for next sub-step
   }
 
   ////////////////////////////////////////////////////////////// 1/2 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 0.5*SIMLIB_StepSize); // substep's time
+  _SetTime(Time,SIMLIB_StepStartTime + 0.5*StepSize); // substep's time
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model (y'=f(t,y))      (1)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A2[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A2[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + 0.75*A2[i]);
   }
 
   ////////////////////////////////////////////////////////////// 3/4 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 0.75*SIMLIB_StepSize); //substep's time
+  _SetTime(Time,SIMLIB_StepStartTime + 0.75*StepSize); //substep's time
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (2)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A3[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A3[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState()
                  + (2.0*A1[i] + 3.0*A2[i] + 4.0*A3[i]) / 9.0);
   }
 
   ////////////////////////////////////////////////////////////// 1.0 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+SIMLIB_StepSize); // goto end time point
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time, SIMLIB_StepStartTime+StepSize); // goto end time point
+  SIMLIB_DeltaTime = StepSize;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (3)
 
@@ -124,10 +124,10 @@ begin_step:
     eerr = fabs(  -5.0*A1[i]  // estimation
                  + 6.0*A2[i]
                  + 8.0*A3[i]
-                 - 9.0*SIMLIB_StepSize*(*ip)->GetDiff()
+                 - 9.0*StepSize*(*ip)->GetDiff()
                ) / 72.0;
-    terr = fabs(SIMLIB_AbsoluteError)
-         + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+    terr = fabs(AbsoluteError)
+         + fabs(RelativeError*(*ip)->GetState());
     if(terr < eerr*ratio) { // avoid arithmetic overflow
       ratio = terr/eerr;    // find the lowest ratio
       n=i;                  // remember the integrator
@@ -139,9 +139,9 @@ begin_step:
   if(ratio < 1.0) { // error is too large, reduce stepsize
     ratio = pow(ratio,pshrnk);              // coefficient for reduce
     Dprintf(("Down: %g",ratio));
-    if(SIMLIB_StepSize > SIMLIB_MinStep) {  // reducing step is possible
-      SIMLIB_OptStep = max(safety*ratio*SIMLIB_StepSize, SIMLIB_MinStep);
-      SIMLIB_StepSize = SIMLIB_OptStep;
+    if(StepSize > MinStep) {  // reducing step is possible
+      OptStep = max(safety*ratio*StepSize, MinStep);
+      StepSize = OptStep;
       IsEndStepEvent = false; // no event will be at the end of the step
       goto begin_step;        // compute again with smaller step
     }
@@ -149,14 +149,14 @@ begin_step:
     SIMLIB_ERRNO++;          // requested accuracy cannot be achieved
     _Print("\n Integrator[%lu] ",(unsigned long)n);
     SIMLIB_warning(AccuracyError);
-    next_step = SIMLIB_StepSize;
+    next_step = StepSize;
   } else { // allowed tolerantion is fulfiled
     if(!IsStartMode()) { // method is not used for start multi-step method
       ratio = min(pow(ratio,pgrow),max_ratio); // coefficient for increase
       Dprintf(("Up: %g",ratio));
-      next_step = min(safety*ratio*SIMLIB_StepSize, SIMLIB_MaxStep);
+      next_step = min(safety*ratio*StepSize, MaxStep);
     } else {
-      next_step = SIMLIB_StepSize;
+      next_step = StepSize;
     }
   }
 
@@ -173,7 +173,7 @@ begin_step:
   //--------------------------------------------------------------------------
 
   // increase step, if accuracy was good
-  SIMLIB_OptStep = next_step;
+  OptStep = next_step;
 
 } // RKF3::Integrate
 
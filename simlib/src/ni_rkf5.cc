@@ -81,49 +81,49 @@ begin_step:
 
   ///////////////////////////////////////////////////////// beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
 
   SIMLIB_ContractStepFlag = false;           // clear reduce step flag
-  SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // implicitly reduce to half step
+  SIMLIB_ContractStep = 0.5*StepSize; // implicitly reduce to half step
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A1[i] = SIMLIB_StepSize*(*ip)->GetOldDiff(); // compute coefficient
+    A1[i] = StepSize*(*ip)->GetOldDiff(); // compute coefficient
     (*ip)->SetState((*ip)->GetOldState() + 0.2*A1[i]); // state (y) for next sub-step
   }
 
   ////////////////////////////////////////////////////////////// 0.2 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 0.2*SIMLIB_StepSize); // substep's time
+  _SetTime(Time,SIMLIB_StepStartTime + 0.2*StepSize); // substep's time
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model (y'=f(t,y))      (1)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A2[i] = SIMLIB_StepSize*(*ip)->GetDiff();
+    A2[i] = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + (3.0*A1[i] + 9.0*A2[i]) / 40.0);
   }
 
   ////////////////////////////////////////////////////////////// 0.3 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 0.3*SIMLIB_StepSize); //substep's time
+  _SetTime(Time,SIMLIB_StepStartTime + 0.3*StepSize); //substep's time
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (2)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A3[i] = SIMLIB_StepSize*(*ip)->GetDiff();
+    A3[i] = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + 0.3 * A1[i] - 0.9 * A2[i] + 1.2 * A3[i]);
   }
 
   ////////////////////////////////////////////////////////////// 0.6 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+0.6*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime+0.6*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (3)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A4[i] = SIMLIB_StepSize*(*ip)->GetDiff();
+    A4[i] = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() - 11.0 / 54.0 * A1[i]
                                    +  2.5        * A2[i]
                                    - 70.0 / 27.0 * A3[i]
@@ -132,13 +132,13 @@ begin_step:
 
   ////////////////////////////////////////////////////////////// 1.0 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime+StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (4)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A5[i] = SIMLIB_StepSize*(*ip)->GetDiff();
+    A5[i] = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +  1631.0 /  55296.0 * A1[i]
                                    +   175.0 /    512.0 * A2[i]
                                    +   575.0 /  13824.0 * A3[i]
@@ -148,13 +148,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 0.875 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+0.875*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime+0.875*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (5)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A6[i] = SIMLIB_StepSize*(*ip)->GetDiff();
+    A6[i] = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +  37.0 /  378.0 * A1[i] // final state
                                    + 250.0 /  621.0 * A3[i]
                                    + 125.0 /  594.0 * A4[i]
@@ -163,8 +163,8 @@ begin_step:
 
   ////////////////////////////////////////////////////////////// end of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+SIMLIB_StepSize); // go to end of step
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time, SIMLIB_StepStartTime+StepSize); // go to end of step
+  SIMLIB_DeltaTime = StepSize;
   SIMLIB_Dynamic();
 
   //--------------------------------------------------------------------------
@@ -183,8 +183,8 @@ begin_step:
                 - 6925.0 / 202752.0 * A4[i]
                 -  277.0 /  14336.0 * A5[i]
                 +  277.0 /   7084.0 * A6[i]);
-    terr = fabs(SIMLIB_AbsoluteError)
-         + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+    terr = fabs(AbsoluteError)
+         + fabs(RelativeError*(*ip)->GetState());
     if(terr < eerr*ratio) { // avoid arithmetic overflow
       ratio = terr/eerr;    // find the lowest ratio
       n=i;                  // remember the integrator
@@ -196,9 +196,9 @@ begin_step:
   if(ratio < 1.0) { // error is too large, reduce stepsize
     ratio = pow(ratio,pshrnk); // coefficient for reduce
     Dprintf(("Down: %g",ratio));
-    if(SIMLIB_StepSize > SIMLIB_MinStep) {  // reducing step is possible
-      SIMLIB_OptStep = max(safety*ratio*SIMLIB_StepSize, SIMLIB_MinStep);
-      SIMLIB_StepSize = SIMLIB_OptStep;
+    if(StepSize > MinStep) {  // reducing step is possible
+      OptStep = max(safety*ratio*StepSize, MinStep);
+      StepSize = OptStep;
       IsEndStepEvent = false; // no event will be at the end of the step
       goto begin_step;        // compute again with smaller step
     }
@@ -206,14 +206,14 @@ begin_step:
     SIMLIB_ERRNO++;          // requested accuracy cannot be achieved
     _Print("\n Integrator[%lu] ",(unsigned long)n);
     SIMLIB_warning(AccuracyError);
-    next_step = SIMLIB_StepSize;
+    next_step = StepSize;
   } else { // allowed tolerantion is fulfiled
     if(!IsStartMode()) { // method is not used for start multi-step method
       ratio = min(pow(ratio,pgrow),max_ratio); // coefficient for increase
       Dprintf(("Up: %g",ratio));
-      next_step = min(safety*ratio*SIMLIB_StepSize, SIMLIB_MaxStep);
+      next_step = min(safety*ratio*StepSize, MaxStep);
     } else {
-      next_step = SIMLIB_StepSize;
+      next_step = StepSize;
     }
   }
 
@@ -230,7 +230,7 @@ begin_step:
   //--------------------------------------------------------------------------
 
   // increase step, if accuracy is good
-  SIMLIB_OptStep = next_step;
+  OptStep = next_step;
 
 } // RKF5::Integrate
 
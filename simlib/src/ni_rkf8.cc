@@ -63,49 +63,49 @@ begin_step:
 
   ///////////////////////////////////////////////////////// beginning of step
 
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
+  StepSize = max(StepSize, MinStep); // low step limit
 
   SIMLIB_ContractStepFlag = false;           // clear reduce step flag
-  SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // implicitly reduce to half step
+  SIMLIB_ContractStep = 0.5*StepSize; // implicitly reduce to half step
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A1[i]  = SIMLIB_StepSize*(*ip)->GetOldDiff(); // compute coefficient
+    A1[i]  = StepSize*(*ip)->GetOldDiff(); // compute coefficient
     (*ip)->SetState((*ip)->GetOldState() + 0.25*A1[i]); // state (y) for next substep
   }
 
   ////////////////////////////////////////////////////////////// 1/4 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 0.25*SIMLIB_StepSize); // substep time
+  _SetTime(Time,SIMLIB_StepStartTime + 0.25*StepSize); // substep time
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model (y'=f(t,y))      (1)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A2[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A2[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + (5.0*A1[i] + A2[i]) / 72.0);
   }
 
   ////////////////////////////////////////////////////////////// 1/12 of step
 
-  _SetTime(Time,SIMLIB_StepStartTime + 1.0/12.0*SIMLIB_StepSize); // substep
+  _SetTime(Time,SIMLIB_StepStartTime + 1.0/12.0*StepSize); // substep
   SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (2)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A3[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A3[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + (A1[i] + 3.0*A3[i]) / 32.0);
   }
 
   ////////////////////////////////////////////////////////////// 1/8 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 0.125*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 0.125*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (3)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A4[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A4[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + (   106.0 * A1[i]
                          - 408.0 * A3[i]
                          + 352.0 * A4[i]
@@ -114,13 +114,13 @@ begin_step:
 
   ////////////////////////////////////////////////////////////// 2/5 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 0.4*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 0.4*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (4)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A5[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A5[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +   1.0 /  48.0 * A1[i]
                      +   8.0 /  33.0 * A4[i]
                      + 125.0 / 528.0 * A5[i]);
@@ -128,13 +128,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 1/2 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 0.5*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 0.5*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (5)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A6[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A6[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() -  1263.0 /  2401.0 * A1[i]
                      + 39936.0 / 26411.0 * A4[i]
                      - 64125.0 / 26411.0 * A5[i]
@@ -143,13 +143,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 6/7 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 6.0/7.0*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 6.0/7.0*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (6)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A7[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A7[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +   37.0 /  392.0 * A1[i]
                      + 1625.0 / 9408.0 * A5[i]
                      -    2.0 /   15.0 * A6[i]
@@ -158,13 +158,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 1/7 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 1.0/7.0*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 1.0/7.0*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (7)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A8[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A8[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() + 17176.0 /  25515.0 * A1[i]
                      - 47104.0 /  25515.0 * A4[i]
                      +  1325.0 /    504.0 * A5[i]
@@ -175,13 +175,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 2/3 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 2.0/3.0*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 2.0/3.0*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (8)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A9[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A9[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() -  23834.0 /  180075.0 * A1[i]
                      -  77824.0 / 1980825.0 * A4[i]
                      - 636635.0 /  633864.0 * A5[i]
@@ -193,13 +193,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 2/7 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 2.0/7.0*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 2.0/7.0*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (9)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A10[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A10[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +  12733.0 /   7600.0 * A1[i]
                      -  20032.0 /   5225.0 * A4[i]
                      + 456485.0 /  80256.0 * A5[i]
@@ -212,13 +212,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 1/1 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (10)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A11[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A11[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() -   27061.0 /  204120.0 * A1[i]
                      +   40448.0 /  280665.0 * A4[i]
                      - 1353775.0 / 1197504.0 * A5[i]
@@ -231,13 +231,13 @@ begin_step:
 
   ///////////////////////////////////////////////////////////// 1/3 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime + 1.0/3.0*SIMLIB_StepSize);
+  _SetTime(Time, SIMLIB_StepStartTime + 1.0/3.0*StepSize);
   SIMLIB_DeltaTime = double(Time)-SIMLIB_StepStartTime;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (11)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A12[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A12[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState() +   11203.0 /    8680.0 * A1[i]
                      -   38144.0 /   11935.0 * A4[i]
                      + 2354425.0 /  458304.0 * A5[i]
@@ -251,13 +251,13 @@ begin_step:
 
   ////////////////////////////////////////////////////////////// 1/1 of step
 
-  _SetTime(Time, SIMLIB_StepStartTime+SIMLIB_StepSize);
-  SIMLIB_DeltaTime = SIMLIB_StepSize;
+  _SetTime(Time, SIMLIB_StepStartTime+StepSize);
+  SIMLIB_DeltaTime = StepSize;
 
   SIMLIB_Dynamic();  // evaluate new state of model                  (9)
 
   for(ip=FirstIntegrator(),i=0; ip!=end_it; ip++,i++) {
-    A13[i]  = SIMLIB_StepSize*(*ip)->GetDiff();
+    A13[i]  = StepSize*(*ip)->GetDiff();
     (*ip)->SetState((*ip)->GetOldState()+   31.0/720.0   * (A1[i]+A13[i])
                     +   16.0/75.0    *  A6[i]
                     +16807.0/79200.0 * (A7[i]+A8[i])
@@ -284,8 +284,8 @@ begin_step:
                 +  243.0 /   1760.0 * A12[i]
                 +   31.0 /    720.0 * A13[i]
                );
-    terr = fabs(SIMLIB_AbsoluteError)
-         + fabs(SIMLIB_RelativeError*(*ip)->GetState());
+    terr = fabs(AbsoluteError)
+         + fabs(RelativeError*(*ip)->GetState());
     if(terr < eerr*ratio) { // avoid arithmetic overflow
       ratio = terr/eerr;    // find the lowest ratio
       n=i;                  // remember the integrator
@@ -297,9 +297,9 @@ begin_step:
   if(ratio < 1.0) { // error is too large, reduce stepsize
     ratio = pow(ratio,pshrnk);              // coefficient for reduce
     Dprintf(("Down: %g",ratio));
-    if(SIMLIB_StepSize > SIMLIB_MinStep) {  // reducing step is possible
-      SIMLIB_OptStep = max(safety*ratio*SIMLIB_StepSize, SIMLIB_MinStep);
-      SIMLIB_StepSize = SIMLIB_OptStep;
+    if(StepSize > MinStep) {  // reducing step is possible
+      OptStep = max(safety*ratio*StepSize, MinStep);
+      StepSize = OptStep;
       IsEndStepEvent = false; // no event will be at the end of the step
       goto begin_step;        // compute again with smaller step
     }
@@ -307,14 +307,14 @@ begin_step:
     SIMLIB_ERRNO++;          // requested accuracy cannot be achieved
     _Print("\n Integrator[%lu] ",(unsigned long)n);
     SIMLIB_warning(AccuracyError);
-    next_step = SIMLIB_StepSize;
+    next_step = StepSize;
   } else { // allowed tolerantion is fulfiled
     if(!IsStartMode()) { // method is not used for start multi-step method
       ratio = min(pow(ratio,pgrow),max_ratio); // coefficient for increase
       Dprintf(("Up: %g",ratio));
-      next_step = min(safety*ratio*SIMLIB_StepSize, SIMLIB_MaxStep);
+      next_step = min(safety*ratio*StepSize, MaxStep);
     } else {
-      next_step = SIMLIB_StepSize;
+      next_step = StepSize;
     }
   }
 
@@ -331,7 +331,7 @@ begin_step:
   //--------------------------------------------------------------------------
 
   // increase step, if accuracy was good
-  SIMLIB_OptStep = next_step;
+  OptStep = next_step;
 
 } // RKF8::Integrate
 
@@ -58,7 +58,7 @@ void IntegrationMethod::StepSim(void)
   SIMLIB_DynamicFlag = true; // numerical integration is running
   if(Prepare()) { // initialize integration step (condition is not changed)
     if(IntegratorContainer::isAny()) { // are there any integrators?
-      CurrentMethodPtr->Integrate(); // * numerical integration *
+      CurrentMethod()->Integrate(); // * numerical integration *
     } else {     // model without integrators
       Iterate(); // compute new values of state blocks
     }
@@ -78,7 +78,7 @@ void IntegrationMethod::SetMethod(const char* name)
   if(SIMLIB_DynamicFlag) {
     SIMLIB_error(NI_CantSetMethod);  // can't in 'dynamic section' !!!
   }
-  CurrentMethodPtr->TurnOff();  // suspend present method
+  CurrentMethod()->TurnOff();  // suspend present method (methods exist)
   CurrentMethodPtr=SearchMethod(name);  // set new method
 }
 
@@ -89,21 +89,21 @@ void IntegrationMethod::Iterate(void)
 {
   Dprintf(("IntegrationMethod::Iterate()"));
   while(1) {
-    SIMLIB_StepSize = max(SIMLIB_MinStep, SIMLIB_StepSize);
+    StepSize = max(MinStep, StepSize);
     SIMLIB_ContractStepFlag = false;           // don't reduce step
-    SIMLIB_ContractStep = 0.5*SIMLIB_StepSize; // implicitly reduce to half
-    _SetTime(Time, SIMLIB_StepStartTime + SIMLIB_StepSize);
-    SIMLIB_DeltaTime = SIMLIB_StepSize;
+    SIMLIB_ContractStep = 0.5*StepSize; // implicitly reduce to half
+    _SetTime(Time, SIMLIB_StepStartTime + StepSize);
+    SIMLIB_DeltaTime = StepSize;
 
     SIMLIB_Dynamic(); // evaluate new state of model - only state blocks
     Condition::TestAll(); // check on changes of state conditions
 
     if(!SIMLIB_ContractStepFlag)
       break;
-    if(SIMLIB_StepSize<=SIMLIB_MinStep)
+    if(StepSize<=MinStep)
       break;
     IsEndStepEvent = false;     // no event will be at end of step
-    SIMLIB_StepSize = SIMLIB_ContractStep;
+    StepSize = SIMLIB_ContractStep;
     StatusContainer::LtoN();
   }
 }
@@ -127,16 +127,16 @@ void IntegrationMethod::Summarize(void)
 /// initialize integration step
 bool IntegrationMethod::Prepare(void)
 {
-  SIMLIB_StepSize = SIMLIB_OptStep; // optimal step size at start
+  StepSize = OptStep; // optimal step size at start
 
   Dprintf(("IntegrationMethod::Prepare()"));
 
  // If an event is scheduled within the step,
   // set on flag, that will be event at the end of the step
-  IsEndStepEvent=(bool)(double(Time)+1.01*SIMLIB_StepSize>=NextTime);//1.1???
+  IsEndStepEvent=(bool)(double(Time)+1.01*StepSize>=NextTime);//1.1???
   // and adjust step size, so that event will take place at end of step
   if(IsEndStepEvent)
-    SIMLIB_StepSize = double(NextTime)-double(Time);
+    StepSize = double(NextTime)-double(Time);
 
   // set up auxiliary variables
   SIMLIB_StepStartTime = Time; // start time of integration
@@ -161,10 +161,10 @@ bool IntegrationMethod::Prepare(void)
       return false;             // condition has been changed => terminate step
   }
 
-  if(SIMLIB_StepSize<=0)
+  if(StepSize<=0)
     SIMLIB_error(NI_IlStepSize); // error of integration
 
-  CurrentMethodPtr->PrepareStep(); // prepare current method for single step
+  CurrentMethod()->PrepareStep(); // prepare current method for single step
 
   return true;
 }
@@ -178,9 +178,9 @@ bool IntegrationMethod::StateCond(void)
 
   Condition::TestAll(); // check on changes
 
-  if(SIMLIB_ContractStepFlag && SIMLIB_StepSize>SIMLIB_MinStep) {
+  if(SIMLIB_ContractStepFlag && StepSize>MinStep) {
     // step reducing is requested and it is possible
-    SIMLIB_StepSize = SIMLIB_ContractStep; // reduce step to demanded size
+    StepSize = SIMLIB_ContractStep; // reduce step to demanded size
                                            // implicitly to quater of step
     IsEndStepEvent = false; // no event will be scheduled at end of step
     return true;
@@ -297,21 +297,21 @@ bool IntegrationMethod::PrepareStep(void)
 ///  initialize step
 void IntegrationMethod::InitStep(double step_frag)
 {
-  SIMLIB_StepSize = max(SIMLIB_StepSize, SIMLIB_MinStep); // low step limit
-  SIMLIB_StepSize = min(SIMLIB_StepSize, SIMLIB_MaxStep); // high step limit
+  StepSize = max(StepSize, MinStep); // low step limit
+  StepSize = min(StepSize, MaxStep); // high step limit
   SIMLIB_ContractStepFlag = false;  // clear reduce step flag
   // implicitly reduce to half step
-  SIMLIB_ContractStep = step_frag*SIMLIB_StepSize;
+  SIMLIB_ContractStep = step_frag*StepSize;
 }
 
 void IntegrationMethod::SetOptStep(double opt_step)
 {                               // set optimal step size
-    SIMLIB_OptStep = opt_step;
+    OptStep = opt_step;
 }
 
 void IntegrationMethod::SetStepSize(double step_size)
 {                               // set step size
-    SIMLIB_StepSize = step_size;
+    StepSize = step_size;
 }
 
 bool IntegrationMethod::IsConditionFlag(void)
@@ -338,11 +338,11 @@ void IntegrationMethod::FunCall(double step_frag)
 {
   if(step_frag==1.0) {  // accuracy!
     // substep time
-    _SetTime(Time, SIMLIB_StepStartTime + SIMLIB_StepSize);
-    SIMLIB_DeltaTime = SIMLIB_StepSize;
+    _SetTime(Time, SIMLIB_StepStartTime + StepSize);
+    SIMLIB_DeltaTime = StepSize;
   } else {
     // substep time
-    _SetTime(Time, SIMLIB_StepStartTime + step_frag*SIMLIB_StepSize);
+    _SetTime(Time, SIMLIB_StepStartTime + step_frag*StepSize);
     SIMLIB_DeltaTime = double(Time) - SIMLIB_StepStartTime;
   }
   SIMLIB_Dynamic(); // evaluate new state of model
@@ -648,39 +648,49 @@ void StatusMethod::GoToState(Memory& di, Memory& si, StatusMemory& xi)
 const size_t IntegrationMethod::Memory::page_size = 256;
 
 // flag - will be event at the end of the step?
-bool IntegrationMethod::IsEndStepEvent=false;
+SIMLIB_CONSTINIT thread_local bool IntegrationMethod::IsEndStepEvent=false;
 
 // list of registered methods
-std::list<IntegrationMethod*>* IntegrationMethod::MthLstPtr=NULL;
+SIMLIB_CONSTINIT thread_local std::list<IntegrationMethod*>* IntegrationMethod::MthLstPtr=NULL;
 
 // pointer to the filled list of memories
-std::list<IntegrationMethod::Memory*>* IntegrationMethod::PtrMList;
+SIMLIB_CONSTINIT thread_local std::list<IntegrationMethod::Memory*>* IntegrationMethod::PtrMList;
 
 // pointer to the filled list of status memories
-std::list<IntegrationMethod::Memory*>* StatusMethod::PtrStatusMList;
+SIMLIB_CONSTINIT thread_local std::list<IntegrationMethod::Memory*>* StatusMethod::PtrStatusMList;
 
 
 ////////////////////////////////////////////////////////////////////////////
 // instantiate integration methods
 
 /// Adams-Bashforth-Moulton, 4th order
-ABM4 abm4("abm4", "rkf5");
+thread_local ABM4 abm4("abm4", "rkf5");
 /// Euler method
-EULER euler("euler");
+thread_local EULER euler("euler");
 /// Fowler-Warten (Warning: needs testing, do not use)
-FW fw("fw");
+thread_local FW fw("fw");
 /// Runge-Kutta-England, 4th order?
-RKE rke("rke");
+thread_local RKE rke("rke");
 /// Runge-Kutta-Fehlberg, 3rd order
-RKF3 rkf3("rkf3");
+thread_local RKF3 rkf3("rkf3");
 /// Runge-Kutta-Fehlberg, 5th order
-RKF5 rkf5("rkf5");
+thread_local RKF5 rkf5("rkf5");
 /// Runge-Kutta-Fehlberg, 8th order
-RKF8 rkf8("rkf8");
+thread_local RKF8 rkf8("rkf8");
 
-/// pointer to the method currently used
-/// "rke" is a predefined method (historical reasons, we need rk45)
-IntegrationMethod* IntegrationMethod::CurrentMethodPtr = &rke;
+/// pointer to the method currently used, 0 = default method
+SIMLIB_CONSTINIT thread_local IntegrationMethod* IntegrationMethod::CurrentMethodPtr = 0;
+
+////////////////////////////////////////////////////////////////////////////
+///  method currently used
+/// "rke" is a predefined method (historical reasons, we need rk45);
+/// the first use of method objects creates all of them in current thread
+IntegrationMethod* IntegrationMethod::CurrentMethod(void)
+{
+  if(!CurrentMethodPtr)
+    CurrentMethodPtr = &rke;
+  return CurrentMethodPtr;
+}
 
 } // namespace
 
@@ -0,0 +1,255 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-cache.cc  Evaluation cache for optimization and sweep
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// memoization of cost function values
+//
+// File (text) has a header line and one line per result:
+//
+//   # SIMLIB evaluation cache quantum=1e-09 values=absolute
+//   random  replication  <quantized parameters>  value
+//
+// (random = SIMLIB_RandomKey() of the run, parameter x is stored as
+// llround(x/quantum), so the key does not depend on ranges). The file of previous session
+// is checked and new lines are appended; an incomplete last line
+// (interrupted write) is removed.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <cctype>               // isdigit
+#include <cmath>                // llround, fabs
+#include <cstdio>
+#include <cstdlib>              // strtoull, strtoll, strtod
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+//////////////////////////////////////////////////////////////////////////////
+// cache data
+//
+namespace {
+
+struct Key {
+    unsigned long long random;  // key of random input of run
+    unsigned long replication;
+    std::vector<long long> x;   // quantized parameters
+    bool operator < (const Key & k) const {
+        if (random != k.random)
+            return random < k.random;
+        if (replication != k.replication)
+            return replication < k.replication;
+        return x < k.x;
+    }
+};
+
+std::string Header(double quantum)
+{
+    char s[100];
+    std::snprintf(s, sizeof(s), "# SIMLIB evaluation cache quantum=%.17g "
+                  "values=absolute\n",
+                  quantum);
+    return s;
+}
+
+} // local namespace
+
+struct EvaluationCache::Data {
+    double quantum;
+    FILE *f;                    // appended results or 0
+    std::map<Key, double> values;
+    unsigned long hits, misses;
+    std::mutex lock;
+    Key MakeKey(const ParameterVector & p, unsigned long long random,
+                unsigned long replication) const;
+    size_t Read(const std::string & s);
+};
+
+// quantize values of parameters (absolute, not relative to range)
+Key EvaluationCache::Data::MakeKey(const ParameterVector & p,
+                                   unsigned long long random,
+                                   unsigned long replication) const
+{
+    Key k;
+    k.random = random;
+    k.replication = replication;
+    for (int i = 0; i < p.size(); i++) {
+        double q = p[i] / quantum;
+        if (!(std::fabs(q) < 9e18))     // out of long long
+            SIMLIB_error(EvaluationCacheError);
+        k.x.push_back(std::llround(q));
+    }
+    return k;
+}
+
+// results of previous session: complete lines after header,
+// returns end of the last complete line
+size_t EvaluationCache::Data::Read(const std::string & s)
+{
+    size_t pos = 0;
+    for (size_t end; (end = s.find('\n', pos)) != std::string::npos;
+         pos = end + 1) {
+        std::string line(s, pos, end - pos);    // complete line only
+        size_t v = line.rfind('\t');
+        const char *c = line.c_str();
+        char *e;
+        Key k;
+        bool ok = v != std::string::npos && std::isdigit((unsigned char) c[0]);
+        if (ok) {
+            k.random = std::strtoull(c, &e, 10);
+            ok = *e == '\t' && std::isdigit((unsigned char) e[1]);
+        }
+        if (ok) {
+            k.replication = std::strtoul(e + 1, &e, 10);
+            ok = *e == '\t';
+        }
+        while (ok && e < c + v) {       // quantized parameters
+            const char *x = e + 1;
+            k.x.push_back(std::strtoll(x, &e, 10));
+            ok = e != x && *e == '\t';
+        }
+        double y = 0;
+        if (ok) {
+            y = std::strtod(c + v + 1, &e);
+            ok = e != c + v + 1 && *e == '\0';
+        }
+        if (!ok)
+            SIMLIB_error(EvaluationCacheFileError);     // malformed line
+        values[k] = y;
+    }
+    return pos;
+}
+
+EvaluationCache::EvaluationCache(double quantum, const char *file):
+    d(new Data)
+{
+    if (!(quantum > 0))
+        SIMLIB_error(EvaluationCacheError);
+    d->quantum = quantum;
+    d->f = 0;
+    d->hits = d->misses = 0;
+    if (file == 0)
+        return;
+    std::string header = Header(quantum);
+    std::string old;
+    FILE *in = std::fopen(file, "r");
+    if (in) {
+        char tmp[4096];
+        size_t k;
+        while ((k = std::fread(tmp, 1, sizeof(tmp), in)) > 0)
+            old.append(tmp, k);
+        std::fclose(in);
+    }
+    if (old.empty()) {                  // new file
+        d->f = std::fopen(file, "w");
+        if (d->f == 0)
+            SIMLIB_error(EvaluationCacheFileError);
+        std::fputs(header.c_str(), d->f);
+        std::fflush(d->f);
+        return;
+    }
+    if (old.compare(0, header.size(), header) != 0)
+        SIMLIB_error(EvaluationCacheFileError);         // other quantum
+    size_t end = header.size() + d->Read(old.substr(header.size()));
+    if (end < old.size()) {     // remove incomplete line: temporary file
+        std::string tmp = std::string(file) + ".tmp";
+        FILE *t = std::fopen(tmp.c_str(), "w");
+        if (t == 0)
+            SIMLIB_error(EvaluationCacheFileError);
+        bool ok = std::fwrite(old.data(), 1, end, t) == end;
+        ok = std::fclose(t) == 0 && ok;
+        if (!ok || std::rename(tmp.c_str(), file) != 0)
+            SIMLIB_error(EvaluationCacheFileError);
+    }
+    d->f = std::fopen(file, "a");
+    if (d->f == 0)
+        SIMLIB_error(EvaluationCacheFileError);
+}
+
+EvaluationCache::~EvaluationCache()
+{
+    if (d->f)
+        std::fclose(d->f);
+    delete d;
+}
+
+bool EvaluationCache::Find(const ParameterVector & p,
+                           unsigned long long random,
+                           unsigned long replication, double & y)
+{
+    Key k = d->MakeKey(p, random, replication);
+    std::lock_guard<std::mutex> g(d->lock);
+    std::map<Key, double>::const_iterator i = d->values.find(k);
+    if (i == d->values.end()) {
+        ++d->misses;
+        return false;
+    }
+    ++d->hits;
+    y = i->second;
+    return true;
+}
+
+void EvaluationCache::Store(const ParameterVector & p,
+                            unsigned long long random,
+                            unsigned long replication, double y)
+{
+    Key k = d->MakeKey(p, random, replication);
+    std::lock_guard<std::mutex> g(d->lock);
+    if (!d->values.insert(std::make_pair(k, y)).second)
+        return;                 // already stored
+    if (d->f == 0)
+        return;
+    std::fprintf(d->f, "%llu\t%lu", k.random, k.replication);
+    for (size_t i = 0; i < k.x.size(); i++)
+        std::fprintf(d->f, "\t%lld", k.x[i]);
+    std::fprintf(d->f, "\t%.17g\n", y);
+    std::fflush(d->f);          // results survive crash
+}
+
+unsigned long EvaluationCache::Size() const
+{
+    std::lock_guard<std::mutex> g(d->lock);
+    return d->values.size();
+}
+
+unsigned long EvaluationCache::Hits() const
+{
+    std::lock_guard<std::mutex> g(d->lock);
+    return d->hits;
+}
+
+unsigned long EvaluationCache::Misses() const
+{
+    std::lock_guard<std::mutex> g(d->lock);
+    return d->misses;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// cache used by optimization methods and Sweep()
+//
+static EvaluationCache *cache = 0;
+
+EvaluationCache *SetEvaluationCache(EvaluationCache * c)
+{
+    EvaluationCache *prev = cache;
+    cache = c;
+    return prev;
+}
+
+EvaluationCache *SIMLIB_OptCache()
+{
+    return cache;
+}
+
+}
+// end
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-gradient.cc  Optimization algorithm - gradient descent
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// steepest descent method, gradient by finite differences
+//
+// Parameters are scaled to range 0..1; the step is shortened after each
+// unsuccessful move, the method ends after MAXITER iterations or when
+// the step is too small. Moves are limited by the parameter ranges.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <cmath>                // sqrt
+#include <functional>
+#include <vector>
+
+#define debug 0                 // print values
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+typedef std::function<std::vector<double>(const std::vector<ParameterVector> &)>
+    evaluate_t;
+
+const double DIFF_STEP = 1e-3;  // finite difference (part of range)
+const double START_STEP = 0.1;  // initial step (part of range)
+const double MIN_STEP = 1e-6;   // end
+
+//////////////////////////////////////////////////////////////////////////////
+// optimization method
+//   eval computes f at all given points (sequentially or in parallel)
+//
+static double gradient(const evaluate_t & eval, ParameterVector & p,
+                       double MAXITER)
+{
+    int n = p.size();
+    double fx = eval(std::vector<ParameterVector>(1, p))[0];
+#if debug
+    p.PrintValues();
+    Print("%g\n", fx);
+#endif
+    double step = START_STEP;
+    for (int iter = 0; iter < MAXITER && step > MIN_STEP; iter++) {
+        // components of gradient: one point for each parameter
+        std::vector<ParameterVector> x(n, p);
+        std::vector<double> h(n);
+        for (int i = 0; i < n; i++) {
+            if (p[i].Range() == 0) {    // fixed parameter: no gradient
+                h[i] = 0;
+                continue;
+            }
+            double d = DIFF_STEP * p[i].Range();
+            x[i][i] = p[i] + d;
+            if (x[i][i] == p[i])        // upper limit
+                x[i][i] = p[i] - d;
+            h[i] = (x[i][i] - p[i]) / p[i].Range();     // scaled
+        }
+        std::vector<double> y = eval(x);
+        std::vector<double> g(n, 0.0);
+        double norm = 0;
+        for (int i = 0; i < n; i++) {
+            if (h[i] != 0)      // zero range or at limit: no gradient
+                g[i] = (y[i] - fx) / h[i];
+            norm += g[i] * g[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0)
+            break;              // stationary point
+        ParameterVector q(p);
+        for (int i = 0; i < n; i++)
+            q[i] = p[i] - step * p[i].Range() * g[i] / norm;
+        double fq = eval(std::vector<ParameterVector>(1, q))[0];
+        if (fq < fx) {          // successful move, try longer steps
+            p = q;
+            fx = fq;
+            step *= 1.5;
+            if (step > 0.5)
+                step = 0.5;
+#if debug
+            p.PrintValues();
+            Print("%g\n", fx);
+#endif
+        } else
+            step *= 0.5;
+    }
+    return fx;                  // return last minimum value
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+double Optimize_gradient(opt_function_t f, ParameterVector & p,
+                         double MAXITER)
+{
+    auto eval = [f](const std::vector<ParameterVector> &x) {
+        std::vector<double> y;
+        for (size_t k = 0; k < x.size(); k++)
+            y.push_back(f(x[k]));
+        return y;
+    };
+    return gradient(eval, p, MAXITER);
+}
+
+double Optimize_gradient(opt_function_t f, ParameterVector & p,
+                         double MAXITER, const ParallelOptions & o)
+{
+    SIMLIB_OptEvaluator eval(f, o);
+    return gradient(eval, p, MAXITER);
+}
+
+}
+// end
@@ -17,6 +17,7 @@
 
 //## repair
 #include <math.h>
+#include <vector>
 
 namespace simlib3 {
 
@@ -53,9 +54,70 @@ static double hooke_step(double *delta, opt_function_t f, ParameterVector & p,
 }
 
 //////////////////////////////////////////////////////////////////////////////
+// parallel version: all exploratory moves from the same point at once,
+// then the improving moves are combined (if the combination is worse,
+// the best single move is used)
+static double hooke_step_parallel(double *delta,
+                                  const SIMLIB_OptEvaluator & eval,
+                                  ParameterVector & p, double min0)
+{
+    int n = p.size();
+    std::vector<ParameterVector> x;     // moves
+    std::vector<int> axis;              // changed coordinate of move
+    std::vector<int> dir;               // +1: +delta, -1: -delta
+    for (int i = 0; i < n; i++) {
+        if (delta[i] == 0.0)
+            continue;           // ignore zero delta
+        for (int d = 1; d >= -1; d -= 2) {
+            ParameterVector q(p);
+            q[i] = p[i] + d * delta[i];
+            if (q[i] == p[i])
+                continue;       // limit
+            x.push_back(q);
+            axis.push_back(i);
+            dir.push_back(d);
+        }
+    }
+    std::vector<double> y = eval(x);
+    ParameterVector comb(p);    // all improving moves
+    int moved = 0;
+    size_t best = 0;            // the best single move
+    for (size_t k = 0; k < x.size(); k++) {
+        int i = axis[k];
+        size_t m = k;
+        if (k + 1 < x.size() && axis[k + 1] == i) {     // both directions
+            if (y[k + 1] < y[k])
+                m = k + 1;
+            ++k;
+        }
+        bool better = y[m] < min0;
+        if (better) {
+            comb[i] = x[m][i];
+            if (moved++ == 0 || y[m] < y[best])
+                best = m;
+        }
+        if (!better || dir[m] < 0)
+            delta[i] = -delta[i];       // as in hooke_step
+    }
+    if (moved == 0)
+        return min0;
+    if (moved > 1) {
+        double fcomb = eval(comb);
+        if (fcomb < y[best]) {
+            p = comb;
+            return fcomb;
+        }
+    }
+    p = x[best];
+    return y[best];
+}
 
-double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
-                      double rho, double epsilon, int itermax)
+//////////////////////////////////////////////////////////////////////////////
+// Hooke-Jeeves method, step = exploratory moves
+//
+template <class Step>
+static double hooke(Step step, double f0, ParameterVector & parameter,
+                    double rho, double epsilon, int itermax)
 {
 // assert(rho>0.01 && rho <1.0);
 // assert(epsilon>1e-12 && epsilon < rho);  // 1e-12 > 100*DBL_EPS
@@ -69,7 +131,7 @@ double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
         delta[i] = fabs(parameter[i].Range() / 10);     // initial step 10==MPARAMETER-???
     int iteration = 0;
     double steplength = rho;    // 1.0 ???
-    double newf = f(newx);
+    double newf = f0;
 #if debug
     newx.PrintValues();
     Print("%g\n", newf);
@@ -78,7 +140,7 @@ double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
     while (iteration < itermax && steplength > epsilon) {
         iteration++;
         newx = oldx;
-        newf = hooke_step(delta, f, newx, oldf);
+        newf = step(delta, newx, oldf);
         // if we made some improvements, continue that direction
         while (newf < oldf) {
 #if debug
@@ -94,7 +156,7 @@ double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
                 newx[i] = newx[i] + dxi;
             }
             oldf = newf;
-            newf = hooke_step(delta, f, newx, oldf);
+            newf = step(delta, newx, oldf);
             /* if the further (optimistic) move was bad.... */
             if (newf >= oldf)   // worse
                 break;          ///////////////////// break
@@ -122,5 +184,25 @@ double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
     return oldf;                // return last minimum value
 }
 
+double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
+                      double rho, double epsilon, int itermax)
+{
+    auto step = [f](double *delta, ParameterVector & p, double min0) {
+        return hooke_step(delta, f, p, min0);
+    };
+    return hooke(step, f(parameter), parameter, rho, epsilon, itermax);
+}
+
+double Optimize_hooke(opt_function_t f, ParameterVector & parameter,
+                      double rho, double epsilon, int itermax,
+                      const ParallelOptions & o)
+{
+    SIMLIB_OptEvaluator eval(f, o);
+    auto step = [&eval](double *delta, ParameterVector & p, double min0) {
+        return hooke_step_parallel(delta, eval, p, min0);
+    };
+    return hooke(step, eval(parameter), parameter, rho, epsilon, itermax);
+}
+
 }
 // end
@@ -0,0 +1,232 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-ocba.cc  Ranking and selection - OCBA
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// optimal computing budget allocation (C.-H. Chen et al.)
+//
+// For the best mean b and the others i (d_i = distance of means, s_i =
+// standard deviation) the asymptotically optimal numbers of replications
+// satisfy
+//
+//   N_i / N_j = (s_i / d_i)^2 / (s_j / d_j)^2
+//   N_b = s_b * sqrt(sum N_i^2 / s_i^2)
+//
+// Candidates with more replications than their share are left out and
+// the rest of budget is divided again. With indifference zone delta the
+// distances d_i < delta are replaced by delta and candidates worse than
+// the best by less than delta are correct selections (APCS).
+//
+// Job = (candidate, replication) runs as in Sweep(): replication r uses
+// r-th Split() of the caller's current stream, the values are recorded
+// in order of jobs.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <cmath>                // sqrt, erfc, fabs, floor
+#include <vector>
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+namespace {
+
+const double MIN_DIFF = 1e-12;  // distance of equal means
+
+// estimated mean and standard deviation of candidate (sign: maximize)
+struct Estimate {
+    double mean, sd;
+    unsigned long n;
+};
+
+// approximate probability of correct selection (Bonferroni bound),
+// candidate worse by less than delta than the best is correct too
+double APCS(const std::vector<Estimate> & e, unsigned b, double delta)
+{
+    double p = 1;
+    for (unsigned i = 0; i < e.size(); i++) {
+        if (i == b)
+            continue;
+        double v = e[b].sd * e[b].sd / e[b].n + e[i].sd * e[i].sd / e[i].n;
+        double d = e[i].mean - e[b].mean + delta;
+        if (v > 0)
+            p -= 0.5 * std::erfc(d / std::sqrt(2 * v));     // P(i < b-delta)
+        else if (d <= 0)
+            p -= 1;             // equal constant values
+    }
+    return p < 0 ? 0 : p;
+}
+
+// replications added to candidates in the next stage (sum = delta)
+std::vector<unsigned long> Allocate(const std::vector<Estimate> & e,
+                                    unsigned b, unsigned long delta,
+                                    double indifference)
+{
+    const double dmin = indifference > MIN_DIFF ? indifference : MIN_DIFF;
+    unsigned k = e.size();
+    double smin = 0;            // zero variance: the smallest positive
+    for (unsigned i = 0; i < k; i++)
+        if (e[i].sd > 0 && (smin == 0 || e[i].sd < smin))
+            smin = e[i].sd;
+    if (smin == 0)
+        smin = 1;
+    std::vector<double> s(k), ratio(k);
+    for (unsigned i = 0; i < k; i++)
+        s[i] = e[i].sd > 0 ? e[i].sd : 1e-3 * smin;
+    // ratios relative to the first candidate other than b
+    unsigned r = (b == 0) ? 1 : 0;
+    double dr = std::fabs(e[r].mean - e[b].mean);
+    if (dr < dmin)
+        dr = dmin;
+    double sum = 0;             // sum N_i^2 / s_i^2
+    for (unsigned i = 0; i < k; i++) {
+        if (i == b)
+            continue;
+        double d = std::fabs(e[i].mean - e[b].mean);
+        if (d < dmin)
+            d = dmin;
+        double q = (s[i] / d) / (s[r] / dr);
+        ratio[i] = q * q;
+        sum += ratio[i] * ratio[i] / (s[i] * s[i]);
+    }
+    ratio[b] = s[b] * std::sqrt(sum);
+    // total after stage divided by ratios, candidates over share left out
+    double total = delta;
+    for (unsigned i = 0; i < k; i++)
+        total += e[i].n;
+    std::vector<char> fixed(k, 0);
+    std::vector<double> want(k);
+    for (bool more = true; more; ) {
+        more = false;
+        double rest = total, rsum = 0;
+        for (unsigned i = 0; i < k; i++)
+            if (fixed[i])
+                rest -= e[i].n;
+            else
+                rsum += ratio[i];
+        for (unsigned i = 0; i < k; i++)
+            if (!fixed[i])
+                want[i] = rest * ratio[i] / rsum;
+        for (unsigned i = 0; i < k; i++)
+            if (!fixed[i] && want[i] < e[i].n) {
+                fixed[i] = 1;
+                more = true;
+            }
+    }
+    std::vector<unsigned long> add(k, 0);
+    unsigned long given = 0;
+    for (unsigned i = 0; i < k; i++)
+        if (!fixed[i]) {
+            add[i] = (unsigned long) std::floor(want[i]) - e[i].n;
+            given += add[i];
+        }
+    add[b] += delta - given;    // rounding: the rest to the best
+    return add;
+}
+
+} // local namespace
+
+//////////////////////////////////////////////////////////////////////////////
+// SelectBest --- sequential OCBA procedure
+//
+unsigned SelectBest(sweep_function_t f,
+                    const std::vector<ParameterVector> & candidates,
+                    Stat * results, const SelectionOptions & o,
+                    double *pcs)
+{
+    unsigned k = candidates.size();
+    if (f == 0 || k < 2 || results == 0 || o.increment == 0 ||
+        o.budget == 0 || !(o.pcs > 0 && o.pcs < 1) || !(o.indifference >= 0))
+        SIMLIB_error(SelectionError);
+    unsigned long initial = o.initial < 2 ? 2 : o.initial;      // sd
+    const double sign = o.maximize ? -1 : 1;
+    const unsigned long long master = SIMLIB_RandomMasterSeed();
+    RandomStream base = CurrentRandomStream();
+    std::vector<RandomStream> streams;  // of replications, as needed
+    std::vector<unsigned long long> keys;       // SIMLIB_RandomKey of them
+    EvaluationCache *cache = SIMLIB_OptCache();
+    unsigned long used = 0;     // replications run by this call
+    std::vector<unsigned long> add(k);
+    for (unsigned i = 0; i < k; i++)
+        add[i] = results[i].Number() < initial
+                 ? initial - results[i].Number() : 0;
+    std::vector<Estimate> e(k);
+    unsigned b = 0;
+    double p = 0;
+    for (unsigned stage = 0; ; stage++) {
+        // jobs of stage: replications n..n+add-1 of candidates
+        std::vector<unsigned> job_c;
+        std::vector<unsigned long> job_r;
+        for (unsigned i = 0; i < k; i++)
+            for (unsigned long j = 0; j < add[i]; j++) {
+                job_c.push_back(i);
+                job_r.push_back(results[i].Number() + j);
+            }
+        unsigned long jobs = job_c.size();
+        for (unsigned long j = 0; j < jobs; j++)
+            while (streams.size() <= job_r[j]) {
+                unsigned long r = streams.size();
+                streams.push_back(base.Split());
+                keys.push_back(SIMLIB_RandomKey(master + 0x9e3779b97f4a7c15ULL
+                                                * (r + 1), streams[r]));
+            }
+        std::vector<double> y(jobs);
+        std::vector<unsigned long> run;         // not in cache
+        for (unsigned long j = 0; j < jobs; j++)
+            if (!cache || !cache->Find(candidates[job_c[j]], keys[job_r[j]],
+                                       job_r[j], y[j]))
+                run.push_back(j);
+        SIMLIB_OptJobs(run.size(), o.threads, o.fork,
+                       [&](unsigned long m) {
+                           unsigned long j = run[m], r = job_r[j];
+                           SIMLIB_RandomReplica(master + 0x9e3779b97f4a7c15ULL
+                                                * (r + 1), streams[r]);
+                           return f(candidates[job_c[j]], r);
+                       },
+                       [&](unsigned long m, double v) {
+                           unsigned long j = run[m];
+                           y[j] = v;
+                           if (cache)
+                               cache->Store(candidates[job_c[j]],
+                                            keys[job_r[j]], job_r[j], v);
+                       });
+        for (unsigned long j = 0; j < jobs; j++)        // order of jobs
+            results[job_c[j]](y[j]);
+        used += jobs;
+        // estimates, the best, probability of correct selection
+        for (unsigned i = 0; i < k; i++) {
+            e[i].mean = sign * results[i].MeanValue();
+            e[i].sd = results[i].StdDev();
+            e[i].n = results[i].Number();
+        }
+        b = 0;
+        for (unsigned i = 1; i < k; i++)
+            if (e[i].mean < e[b].mean)
+                b = i;
+        p = APCS(e, b, o.indifference);
+        Dprintf(("SelectBest: stage %u, %lu replications, best %u, PCS %g",
+                 stage, used, b, p));
+        if (p >= o.pcs)
+            break;
+        if (used >= o.budget) {
+            SIMLIB_warning(SelectionBudgetWarning);     // not converged
+            break;
+        }
+        unsigned long delta = o.increment;
+        if (used + delta > o.budget)
+            delta = o.budget - used;
+        add = Allocate(e, b, delta, o.indifference);
+    }
+    if (pcs)
+        *pcs = p;
+    return b;
+}
+
+}
+// end
@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-parallel.cc  Parallel evaluation of jobs (optimization, sweep)
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// worker pools used by Sweep() and parallel optimization methods
+//
+// Thread workers run each job with own Simulator (f creates the model),
+// fork workers run each job in child process of prepared program (global
+// model can be used, as in ForkReplications()). Results of child
+// processes are passed in shared memory.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <cstdio>               // fflush
+#include <thread>               // hardware_concurrency
+
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+# define SIMLIB_HAVE_FORK 1
+# include <sys/mman.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+//////////////////////////////////////////////////////////////////////////////
+// SIMLIB_OptJobs --- run n jobs in worker threads or child processes
+//
+void SIMLIB_OptJobs(unsigned long n, unsigned workers, bool fork,
+                    const std::function<double(unsigned long)> &job,
+                    const std::function<void(unsigned long, double)> &done)
+{
+    if (!fork) {
+        SIMLIB_ParallelFor(n, workers, [&](unsigned long k) {
+            double y;
+            {
+                Simulator sim;  // frees data of run at the end
+                y = job(k);
+            }
+            done(k, y);
+        });
+        return;
+    }
+#ifdef SIMLIB_HAVE_FORK
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    if (workers == 0)
+        workers = 1;
+    size_t total = n * sizeof(double) + 1;
+    void *mem = mmap(0, total, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        SIMLIB_error(ForkError);
+    volatile double *slot = static_cast<double*>(mem);
+    bool failed = false;
+    std::vector<pid_t> running;         // our children
+    std::vector<unsigned long> index;   // job of running[c]
+    for (unsigned long k = 0; k < n || !running.empty(); ) {
+        if (k < n && running.size() < workers && !failed) {
+            fflush(0);          // no duplicate output of buffers
+            pid_t pid = ::fork();
+            if (pid < 0) {
+                failed = true;
+                continue;
+            }
+            if (pid == 0) {     // child: one job
+                slot[k] = job(k);
+                fflush(0);
+                _exit(0);
+            }
+            running.push_back(pid);
+            index.push_back(k);
+            ++k;
+            continue;
+        }
+        if (running.empty())
+            break;
+        int status;
+        int c = SIMLIB_WaitChild(running, &status);  // not other children
+        if (c < 0) {
+            failed = true;
+            break;
+        }
+        unsigned long j = index[c];
+        running.erase(running.begin() + c);
+        index.erase(index.begin() + c);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = true;
+            continue;
+        }
+        done(j, slot[j]);
+    }
+    munmap(mem, total);
+    if (failed)
+        SIMLIB_error(ForkChildError);   // finished jobs are done
+#else
+    SIMLIB_error(ForkError);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// SIMLIB_OptEvaluator --- f(x[k]) for all points, in parallel
+// (values in the evaluation cache are not computed again)
+//
+std::vector<double>
+SIMLIB_OptEvaluator::operator() (const std::vector<ParameterVector> &x) const
+{
+    std::vector<double> y(x.size());
+    std::vector<size_t> run;    // points not in cache
+    EvaluationCache *cache = SIMLIB_OptCache();
+    const unsigned long long key = SIMLIB_RandomKey(master, s);
+    for (size_t k = 0; k < x.size(); k++)
+        if (!cache || !cache->Find(x[k], key, 0, y[k]))
+            run.push_back(k);
+    SIMLIB_OptJobs(run.size(), o.threads, o.fork,
+                   [&](unsigned long j) {
+                       SIMLIB_RandomReplica(master, s);
+                       return f(x[run[j]]);
+                   },
+                   [&](unsigned long j, double v) {
+                       y[run[j]] = v;
+                       if (cache)
+                           cache->Store(x[run[j]], key, 0, v);
+                   });
+    return y;
+}
+
+double SIMLIB_OptEvaluator::operator() (const ParameterVector &x) const
+{
+    return (*this)(std::vector<ParameterVector>(1, x))[0];
+}
+
+}
+// end
@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-sensitivity.cc  Global sensitivity analysis (Sobol, Morris)
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// variance based sensitivity indices and elementary effects
+//
+// Sobol: rows j=1..N of Sobol sequence in 2d dimensions give A_j (first
+// d coordinates) and B_j (the rest); AB_j^i is A_j with i-th coordinate
+// of B_j. With V = variance of all f(A), f(B):
+//
+//   S_i  = mean(f(B) * (f(AB^i) - f(A))) / V             (Saltelli 2010)
+//   S_Ti = mean((f(A) - f(AB^i))^2) / 2 / V              (Jansen 1999)
+//
+// Bootstrap resamples rows j (the same runs for all indices), interval
+// is given by percentiles. Morris: base point on grid {0, 1/(p-1), ...}
+// (+Delta stays in range), Delta = p/(2(p-1)), factors changed in random
+// order, elementary effect EE = (f(x + Delta e_i) - f(x)) / Delta.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <algorithm>            // sort, swap
+#include <cmath>                // sqrt, fabs, floor
+#include <vector>
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+namespace {
+
+typedef std::vector<double> Point;      // parameters scaled to 0..1
+
+// values of f at design points (replication 0 of Sweep())
+std::vector<double> Evaluate(sweep_function_t f, const ParameterVector & p,
+                             const std::vector<Point> & u,
+                             const SensitivityOptions & o)
+{
+    const unsigned long long master = SIMLIB_RandomMasterSeed()
+                                      + 0x9e3779b97f4a7c15ULL;  // r=0
+    RandomStream base = CurrentRandomStream();
+    const RandomStream stream = base.Split();
+    const unsigned long long key = SIMLIB_RandomKey(master, stream);
+    std::vector<ParameterVector> x(u.size(), p);
+    for (size_t k = 0; k < u.size(); k++)
+        for (int j = 0; j < p.size(); j++)
+            x[k][j] = p[j].Min() + u[k][j] * p[j].Range();
+    std::vector<double> y(u.size());
+    std::vector<size_t> run;    // not in cache
+    EvaluationCache *cache = SIMLIB_OptCache();
+    for (size_t k = 0; k < x.size(); k++)
+        if (!cache || !cache->Find(x[k], key, 0, y[k]))
+            run.push_back(k);
+    SIMLIB_OptJobs(run.size(), o.threads, o.fork,
+                   [&](unsigned long m) {
+                       SIMLIB_RandomReplica(master, stream);
+                       return f(x[run[m]], 0);
+                   },
+                   [&](unsigned long m, double v) {
+                       y[run[m]] = v;
+                       if (cache)
+                           cache->Store(x[run[m]], key, 0, v);
+                   });
+    return y;
+}
+
+// indices from rows given by index (bootstrap sample)
+void SobolIndices(const std::vector<double> & y, unsigned d, unsigned long N,
+                  const std::vector<unsigned long> & rows,
+                  std::vector<double> & S, std::vector<double> & ST)
+{
+    // y: f(A_j) at j, f(B_j) at N+j, f(AB_j^i) at (2+i)*N+j
+    double mean = 0, v = 0;
+    for (size_t k = 0; k < rows.size(); k++)
+        mean += y[rows[k]] + y[N + rows[k]];
+    mean /= 2.0 * rows.size();
+    for (size_t k = 0; k < rows.size(); k++) {
+        double a = y[rows[k]] - mean, b = y[N + rows[k]] - mean;
+        v += a * a + b * b;
+    }
+    v /= 2.0 * rows.size() - 1;
+    for (unsigned i = 0; i < d; i++) {
+        double s = 0, st = 0;
+        for (size_t k = 0; k < rows.size(); k++) {
+            unsigned long j = rows[k];
+            double fa = y[j], fb = y[N + j], fab = y[(2 + i) * N + j];
+            s += fb * (fab - fa);
+            st += (fa - fab) * (fa - fab);
+        }
+        S[i] = v > 0 ? s / rows.size() / v : 0;
+        ST[i] = v > 0 ? st / (2.0 * rows.size()) / v : 0;
+    }
+}
+
+// percentile of sorted values
+double Percentile(const std::vector<double> & x, double q)
+{
+    double k = q * (x.size() - 1);
+    size_t i = (size_t) std::floor(k);
+    if (i + 1 >= x.size())
+        return x.back();
+    return x[i] + (k - i) * (x[i + 1] - x[i]);
+}
+
+void Sobol(sweep_function_t f, const ParameterVector & p,
+           const SensitivityOptions & o, std::vector<Sensitivity> & res)
+{
+    unsigned d = p.size();
+    unsigned long N = o.samples;
+    if (2 * d > 32)
+        SIMLIB_error(SensitivityError);         // Sobol sequence
+    std::vector<Point> u((d + 2) * N, Point(d));
+    std::vector<double> ab(2 * d);
+    for (unsigned long j = 0; j < N; j++) {
+        SIMLIB_Sobol(j + 1, 2 * d, &ab[0]);     // skip (0,...,0)
+        for (unsigned i = 0; i < d; i++) {
+            u[j][i] = ab[i];                    // A
+            u[N + j][i] = ab[d + i];            // B
+        }
+        for (unsigned i = 0; i < d; i++) {
+            u[(2 + i) * N + j] = u[j];          // AB^i
+            u[(2 + i) * N + j][i] = ab[d + i];
+        }
+    }
+    std::vector<double> y = Evaluate(f, p, u, o);
+    std::vector<unsigned long> rows(N);
+    for (unsigned long j = 0; j < N; j++)
+        rows[j] = j;
+    std::vector<double> S(d), ST(d);
+    SobolIndices(y, d, N, rows, S, ST);
+    // bootstrap
+    std::vector<std::vector<double> > bs(d), bst(d);
+    RandomStream rs = RandomStream::ForComponent("Sensitivity bootstrap");
+    std::vector<double> s(d), st(d);
+    for (unsigned long b = 0; b < o.bootstrap; b++) {
+        for (unsigned long j = 0; j < N; j++)
+            rows[j] = (unsigned long) (rs.Random() * N);
+        SobolIndices(y, d, N, rows, s, st);
+        for (unsigned i = 0; i < d; i++) {
+            bs[i].push_back(s[i]);
+            bst[i].push_back(st[i]);
+        }
+    }
+    double alpha = (1 - o.confidence) / 2;
+    for (unsigned i = 0; i < d; i++) {
+        res[i].first = S[i];
+        res[i].total = ST[i];
+        res[i].first_low = res[i].first_high = S[i];
+        res[i].total_low = res[i].total_high = ST[i];
+        if (o.bootstrap == 0)
+            continue;
+        std::sort(bs[i].begin(), bs[i].end());
+        std::sort(bst[i].begin(), bst[i].end());
+        res[i].first_low = Percentile(bs[i], alpha);
+        res[i].first_high = Percentile(bs[i], 1 - alpha);
+        res[i].total_low = Percentile(bst[i], alpha);
+        res[i].total_high = Percentile(bst[i], 1 - alpha);
+    }
+}
+
+void Morris(sweep_function_t f, const ParameterVector & p,
+            const SensitivityOptions & o, std::vector<Sensitivity> & res)
+{
+    unsigned d = p.size();
+    unsigned long r = o.samples;
+    unsigned levels = o.levels;
+    if (levels < 2)
+        SIMLIB_error(SensitivityError);
+    const double delta = levels / (2.0 * (levels - 1));
+    unsigned base_levels = 0;   // grid values x with x + delta <= 1
+    while (base_levels < levels &&
+           base_levels / double(levels - 1) + delta <= 1 + 1e-12)
+        base_levels++;
+    RandomStream rs = RandomStream::ForComponent("Sensitivity Morris");
+    std::vector<Point> u;
+    std::vector<std::vector<unsigned> > order(r, std::vector<unsigned>(d));
+    for (unsigned long t = 0; t < r; t++) {
+        Point x(d);
+        for (unsigned i = 0; i < d; i++) {
+            x[i] = unsigned(rs.Random() * base_levels) / double(levels - 1);
+            order[t][i] = i;
+        }
+        for (unsigned i = d - 1; i > 0; i--)    // random order of factors
+            std::swap(order[t][i], order[t][unsigned(rs.Random() * (i + 1))]);
+        u.push_back(x);
+        for (unsigned k = 0; k < d; k++) {
+            x[order[t][k]] += delta;
+            u.push_back(x);
+        }
+    }
+    std::vector<double> y = Evaluate(f, p, u, o);
+    for (unsigned i = 0; i < d; i++)
+        res[i].mu = res[i].mu_star = res[i].sigma = 0;
+    for (unsigned long t = 0; t < r; t++)
+        for (unsigned k = 0; k < d; k++) {
+            size_t j = t * (d + 1) + k;
+            double ee = (y[j + 1] - y[j]) / delta;
+            unsigned i = order[t][k];
+            res[i].mu += ee;
+            res[i].mu_star += std::fabs(ee);
+            res[i].sigma += ee * ee;
+        }
+    for (unsigned i = 0; i < d; i++) {
+        double m = res[i].mu / r;
+        double v = r > 1 ? (res[i].sigma - r * m * m) / (r - 1) : 0;
+        res[i].mu = m;
+        res[i].mu_star /= r;
+        res[i].sigma = v > 0 ? std::sqrt(v) : 0;
+    }
+}
+
+} // local namespace
+
+//////////////////////////////////////////////////////////////////////////////
+// SensitivityAnalysis --- indices of all parameters
+//
+std::vector<Sensitivity> SensitivityAnalysis(sweep_function_t f,
+                                             const ParameterVector & p,
+                                             const SensitivityOptions & o)
+{
+    if (f == 0 || p.size() == 0 || o.samples == 0 ||
+        !(o.confidence > 0 && o.confidence < 1))
+        SIMLIB_error(SensitivityError);
+    std::vector<Sensitivity> res(p.size());
+    for (int i = 0; i < p.size(); i++) {
+        Sensitivity & s = res[i];
+        s.name = p[i].Name();
+        s.first = s.first_low = s.first_high = 0;
+        s.total = s.total_low = s.total_high = 0;
+        s.mu = s.mu_star = s.sigma = 0;
+    }
+    if (o.method == SENSITIVITY_MORRIS)
+        Morris(f, p, o, res);
+    else
+        Sobol(f, p, o, res);
+    return res;
+}
+
+}
+// end
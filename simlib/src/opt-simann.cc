@@ -13,6 +13,7 @@
 #include "internal.h"
 #include "optimize.h"           // Param, ParameterVector
 #include <cmath>                // exp()
+#include <vector>
 
 #define debug 1                 // 0=NO, 1=OPTn, >1=ALL
 
@@ -93,5 +94,64 @@ double Optimize_simann(double (*f) (const ParameterVector & p),
     return opt;                 // return optimal value and p
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// parallel simulated annealing
+//  - population of candidates evaluated at each temperature, the best
+//    candidate is the next point (as single candidate of the sequential
+//    version)
+//  - random steps use own stream (depends on the seed only)
+//
+double Optimize_simann(double (*f) (const ParameterVector & p),
+                       ParameterVector & p, int MAXT, unsigned population,
+                       const ParallelOptions & o)
+{
+    if (population == 0)
+        population = 1;
+    SIMLIB_OptEvaluator eval(f, o);
+    RandomStream steps = RandomStream::ForComponent("Optimize simann");
+    int bad_count = 0;
+    double opt = 1e30;
+    double xopt = opt;
+    ParameterVector px(p);
+    for (int temp = MAXT; temp > 0; temp--) {   // falling temperature
+        double eps = temp / double (MAXT);
+        std::vector<ParameterVector> cand(population, px);
+        RandomStream *caller = SetRandomStream(&steps);
+        for (unsigned k = 0; k < population; k++)
+            move_to_next_point(cand[k], eps);
+        SetRandomStream(caller);
+        std::vector<double> y = eval(cand);
+        unsigned best = 0;
+        for (unsigned k = 1; k < population; k++)
+            if (y[k] < y[best])
+                best = k;
+        double new_x = y[best];
+        bool bad = false;
+        if (new_x >= xopt) {
+            RandomStream *caller = SetRandomStream(&steps);
+            bad = accept_bad(eps);
+            SetRandomStream(caller);
+        }
+        if (new_x < xopt || bad) {      // move to next point
+            xopt = new_x;       // can be worse
+            px = cand[best];
+            if (bad)
+                ++bad_count;
+        }
+        if (new_x < opt) {      // accept new temporary optimum
+            opt = new_x;
+            p = cand[best];
+#if debug==1                    // optima only
+            p.PrintValues();
+            Print("%.12g\n", opt);
+#endif
+        }
+    }
+#if debug
+    Print("# %d accepted uphill steps\n", bad_count);
+#endif
+    return opt;                 // return optimal value and p
+}
+
 }
 // end
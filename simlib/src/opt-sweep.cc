@@ -0,0 +1,400 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file opt-sweep.cc  Parameter sweep (design of experiments)
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+// EXPERIMENTAL
+// designs over ParameterVector ranges: grid, Latin hypercube, Sobol
+//
+// Job = (point, replication). Replication r uses the same random streams
+// at all points (common random numbers): the default stream is r-th
+// Split() of the caller's current stream, as in RunReplications().
+// Jobs run in worker threads or processes, see SIMLIB_OptJobs().
+//
+// Results file (TSV) has two header lines and one line per finished job:
+//
+//   # SIMLIB sweep design=sobol points=64 replications=4
+//   point  replication  <parameter names>  value
+//
+// Resume checks the file, skips jobs of its lines and appends new lines
+// (an incomplete last line is removed). Jobs in the evaluation cache
+// (key: point, random state of replication, replication) are not run.
+
+#include "simlib.h"
+#include "internal.h"
+#include "optimize.h"
+#include <cctype>               // isdigit
+#include <cmath>                // NAN
+#include <cstdio>
+#include <cstdlib>              // strtoul, strtod
+#include <cstring>
+#include <mutex>
+#include <string>
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+//////////////////////////////////////////////////////////////////////////////
+// Sobol sequence
+//
+// primitive polynomials (degree s, coefficients a) and initial direction
+// numbers m of dimensions 2..32 (S. Joe, F. Y. Kuo: new-joe-kuo-6.21201)
+static const struct {
+    unsigned s, a;
+    unsigned m[7];
+} joe_kuo[31] = {
+    { 1,  0, { 1 } },
+    { 2,  1, { 1, 3 } },
+    { 3,  1, { 1, 3, 1 } },
+    { 3,  2, { 1, 1, 1 } },
+    { 4,  1, { 1, 1, 3, 3 } },
+    { 4,  4, { 1, 3, 5, 13 } },
+    { 5,  2, { 1, 1, 5, 5, 17 } },
+    { 5,  4, { 1, 1, 5, 5, 5 } },
+    { 5,  7, { 1, 1, 7, 11, 19 } },
+    { 5, 11, { 1, 1, 5, 1, 1 } },
+    { 5, 13, { 1, 1, 1, 3, 11 } },
+    { 5, 14, { 1, 3, 5, 5, 31 } },
+    { 6,  1, { 1, 3, 3, 9, 7, 49 } },
+    { 6, 13, { 1, 1, 1, 15, 21, 21 } },
+    { 6, 16, { 1, 3, 1, 13, 27, 49 } },
+    { 6, 19, { 1, 1, 1, 15, 7, 5 } },
+    { 6, 22, { 1, 3, 1, 15, 13, 25 } },
+    { 6, 25, { 1, 1, 5, 5, 19, 61 } },
+    { 7,  1, { 1, 3, 7, 11, 23, 15, 103 } },
+    { 7,  4, { 1, 3, 7, 13, 13, 15, 69 } },
+    { 7,  7, { 1, 1, 3, 13, 7, 35, 63 } },
+    { 7,  8, { 1, 3, 5, 9, 1, 25, 53 } },
+    { 7, 14, { 1, 3, 1, 13, 9, 35, 107 } },
+    { 7, 19, { 1, 3, 1, 5, 27, 61, 31 } },
+    { 7, 21, { 1, 1, 5, 11, 19, 41, 61 } },
+    { 7, 28, { 1, 3, 5, 3, 3, 13, 69 } },
+    { 7, 31, { 1, 1, 7, 13, 1, 19, 1 } },
+    { 7, 32, { 1, 3, 7, 5, 13, 19, 59 } },
+    { 7, 37, { 1, 1, 3, 9, 25, 29, 41 } },
+    { 7, 41, { 1, 3, 5, 13, 23, 1, 55 } },
+    { 7, 42, { 1, 3, 7, 3, 13, 59, 17 } },
+};
+
+static const unsigned SOBOL_DIM = 32;
+static const unsigned SOBOL_BITS = 32;
+
+struct SobolDirections {
+    unsigned v[SOBOL_DIM][SOBOL_BITS];
+    SobolDirections();
+};
+
+SobolDirections::SobolDirections()
+{
+    for (unsigned k = 0; k < SOBOL_BITS; k++)
+        v[0][k] = 1u << (31 - k);       // van der Corput
+    for (unsigned j = 1; j < SOBOL_DIM; j++) {
+        unsigned s = joe_kuo[j - 1].s;
+        unsigned a = joe_kuo[j - 1].a;
+        for (unsigned k = 0; k < s; k++)
+            v[j][k] = joe_kuo[j - 1].m[k] << (31 - k);
+        for (unsigned k = s; k < SOBOL_BITS; k++) {
+            unsigned x = v[j][k - s] ^ (v[j][k - s] >> s);
+            for (unsigned l = 1; l < s; l++)
+                if ((a >> (s - 1 - l)) & 1)
+                    x ^= v[j][k - l];
+            v[j][k] = x;
+        }
+    }
+}
+
+// i-th point in Gray code order (the same sets of 2^m points)
+void SIMLIB_Sobol(unsigned long i, unsigned dim, double *x)
+{
+    static const SobolDirections d;
+    if (dim > SOBOL_DIM || i > 0xFFFFFFFFUL)
+        SIMLIB_error(SweepError);
+    unsigned long g = i ^ (i >> 1);
+    for (unsigned j = 0; j < dim; j++) {
+        unsigned r = 0;
+        for (unsigned k = 0; k < SOBOL_BITS; k++)
+            if ((g >> k) & 1)
+                r ^= d.v[j][k];
+        x[j] = r / 4294967296.0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// SweepPoints --- values of parameters in design points
+//
+std::vector<std::vector<double> > SweepPoints(const ParameterVector & p,
+                                              SweepDesign design,
+                                              unsigned long points)
+{
+    unsigned n = p.size();
+    if (n == 0 || points == 0)
+        SIMLIB_error(SweepError);
+    std::vector<std::vector<double> > u;       // points in [0,1)^n
+    switch (design) {
+    case SWEEP_GRID: {
+        unsigned long total = 1;
+        for (unsigned j = 0; j < n; j++) {
+            if (total > 0xFFFFFFFFUL / points)
+                SIMLIB_error(SweepError);       // too many points
+            total *= points;
+        }
+        u.assign(total, std::vector<double>(n));
+        for (unsigned long i = 0; i < total; i++) {
+            unsigned long k = i;
+            for (unsigned j = n; j-- > 0; k /= points)  // the last is fastest
+                u[i][j] = (points == 1) ? 0.5
+                        : double(k % points) / (points - 1);
+        }
+        break;
+    }
+    case SWEEP_LHS: {
+        RandomStream s = RandomStream::ForComponent("Sweep LHS");
+        u.assign(points, std::vector<double>(n));
+        std::vector<unsigned long> perm(points);
+        for (unsigned j = 0; j < n; j++) {
+            for (unsigned long i = 0; i < points; i++)
+                perm[i] = i;
+            for (unsigned long i = points - 1; i > 0; i--) {  // shuffle
+                unsigned long k = (unsigned long)(s.Random() * (i + 1));
+                unsigned long t = perm[i];
+                perm[i] = perm[k];
+                perm[k] = t;
+            }
+            for (unsigned long i = 0; i < points; i++)
+                u[i][j] = (perm[i] + s.Random()) / points;
+        }
+        break;
+    }
+    case SWEEP_SOBOL:
+        if (n > SOBOL_DIM)
+            SIMLIB_error(SweepError);
+        u.assign(points, std::vector<double>(n));
+        for (unsigned long i = 0; i < points; i++)
+            SIMLIB_Sobol(i + 1, n, &u[i][0]);   // without (0,...,0)
+        break;
+    default:
+        SIMLIB_error(SweepError);
+    }
+    for (unsigned long i = 0; i < u.size(); i++)
+        for (unsigned j = 0; j < n; j++)
+            u[i][j] = p[j].Min() + u[i][j] * p[j].Range();
+    return u;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// results file
+//
+namespace {
+
+const char *DesignName(SweepDesign d)
+{
+    switch (d) {
+    case SWEEP_GRID:  return "grid";
+    case SWEEP_LHS:   return "lhs";
+    default:          return "sobol";
+    }
+}
+
+class ResultFile {
+    FILE *f;
+    std::mutex lock;
+  public:
+    ResultFile(): f(0) {}
+    ~ResultFile() { if (f) std::fclose(f); }
+    void Open(const SweepOptions & o, const ParameterVector & p,
+              std::vector<SweepPoint> & res, std::vector<char> & done);
+    void Write(unsigned long i, unsigned long r, const SweepPoint & x);
+};
+
+std::string Header(const SweepOptions & o, const ParameterVector & p,
+                   unsigned long points)
+{
+    char s[200];
+    std::snprintf(s, sizeof(s), "# SIMLIB sweep design=%s points=%lu "
+                  "replications=%lu\npoint\treplication",
+                  DesignName(o.design), points, o.replications);
+    std::string h = s;
+    for (int j = 0; j < p.size(); j++) {
+        h += '\t';
+        if (p[j].Name())
+            h += p[j].Name();
+        else {
+            std::snprintf(s, sizeof(s), "x%d", j);
+            h += s;
+        }
+    }
+    return h + "\tvalue\n";
+}
+
+void Row(FILE *f, unsigned long i, unsigned long r, const SweepPoint & x)
+{
+    std::fprintf(f, "%lu\t%lu", i, r);
+    for (size_t j = 0; j < x.x.size(); j++)
+        std::fprintf(f, "\t%.17g", x.x[j]);
+    std::fprintf(f, "\t%.17g\n", x.y[r]);
+}
+
+// parse complete line of file: "i<TAB>r<TAB>x_0 ... x_n-1<TAB>value",
+// point must be the same as in design
+bool Parse(const std::string & line, const std::vector<SweepPoint> & res,
+           unsigned long R, unsigned long & i, unsigned long & r,
+           double & value)
+{
+    const char *s = line.c_str();
+    char *e;
+    if (!std::isdigit((unsigned char) *s))
+        return false;
+    i = std::strtoul(s, &e, 10);
+    if (*e != '\t' || i >= res.size() || !std::isdigit((unsigned char) e[1]))
+        return false;
+    r = std::strtoul(e + 1, &e, 10);
+    if (*e != '\t' || r >= R)
+        return false;
+    for (size_t j = 0; j < res[i].x.size(); j++) {
+        s = e + 1;
+        double x = std::strtod(s, &e);
+        if (e == s || *e != '\t' || x != res[i].x[j])
+            return false;
+    }
+    s = e + 1;
+    value = std::strtod(s, &e);
+    return e != s && *e == '\0';
+}
+
+// open file, read results of previous session (resume)
+//
+// valid file of the same sweep is not rewritten: new lines are appended,
+// incomplete last line (crash during write) is removed
+void ResultFile::Open(const SweepOptions & o, const ParameterVector & p,
+                      std::vector<SweepPoint> & res, std::vector<char> & done)
+{
+    if (o.file == 0)
+        return;
+    std::string header = Header(o, p, res.size());
+    std::string old;
+    if (o.resume && (f = std::fopen(o.file, "r")) != 0) {
+        char tmp[4096];
+        size_t k;
+        while ((k = std::fread(tmp, 1, sizeof(tmp), f)) > 0)
+            old.append(tmp, k);
+        std::fclose(f);
+        f = 0;
+    }
+    if (old.empty()) {                  // new file
+        f = std::fopen(o.file, "w");
+        if (f == 0)
+            SIMLIB_error(SweepFileError);
+        std::fputs(header.c_str(), f);
+        std::fflush(f);
+        return;
+    }
+    if (old.compare(0, header.size(), header) != 0)
+        SIMLIB_error(SweepFileError);           // other sweep
+    size_t pos = header.size();
+    const unsigned long R = o.replications;
+    for (size_t end; (end = old.find('\n', pos)) != std::string::npos;
+         pos = end + 1) {
+        std::string line(old, pos, end - pos);  // complete line only
+        unsigned long i, r;
+        double value;
+        if (!Parse(line, res, R, i, r, value))
+            SIMLIB_error(SweepFileError);       // malformed line
+        res[i].y[r] = value;
+        done[i * R + r] = 1;
+    }
+    if (pos < old.size()) {     // remove incomplete line: temporary file
+        std::string tmp = std::string(o.file) + ".tmp";
+        FILE *t = std::fopen(tmp.c_str(), "w");
+        if (t == 0)
+            SIMLIB_error(SweepFileError);
+        bool ok = std::fwrite(old.data(), 1, pos, t) == pos;
+        ok = std::fclose(t) == 0 && ok;
+        if (!ok || std::rename(tmp.c_str(), o.file) != 0)
+            SIMLIB_error(SweepFileError);
+    }
+    f = std::fopen(o.file, "a");
+    if (f == 0)
+        SIMLIB_error(SweepFileError);
+}
+
+void ResultFile::Write(unsigned long i, unsigned long r, const SweepPoint & x)
+{
+    if (f == 0)
+        return;
+    std::lock_guard<std::mutex> g(lock);
+    Row(f, i, r, x);
+    std::fflush(f);             // finished jobs survive crash
+}
+
+} // local namespace
+
+//////////////////////////////////////////////////////////////////////////////
+// Sweep --- run all (point x replication) jobs
+//
+std::vector<SweepPoint> Sweep(sweep_function_t f, const ParameterVector & p,
+                              const SweepOptions & o)
+{
+    if (f == 0 || o.replications == 0)
+        SIMLIB_error(SweepError);
+    std::vector<std::vector<double> > x = SweepPoints(p, o.design, o.points);
+    const unsigned long R = o.replications;
+    std::vector<SweepPoint> res(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        res[i].x = x[i];
+        res[i].y.assign(R, NAN);
+    }
+    std::vector<char> done(x.size() * R, 0);
+    ResultFile file;
+    file.Open(o, p, res, done);
+    const unsigned long long master = SIMLIB_RandomMasterSeed();
+    auto point = [&](unsigned long i) {
+        ParameterVector q(p);
+        for (int j = 0; j < q.size(); j++)
+            q[j] = x[i][j];
+        return q;
+    };
+    // random streams of replications (common random numbers)
+    std::vector<RandomStream> streams;
+    std::vector<unsigned long long> keys;       // SIMLIB_RandomKey of them
+    RandomStream base = CurrentRandomStream();
+    for (unsigned long r = 0; r < R; r++) {
+        streams.push_back(base.Split());
+        keys.push_back(SIMLIB_RandomKey(master + 0x9e3779b97f4a7c15ULL
+                                        * (r + 1), streams[r]));
+    }
+    EvaluationCache *cache = SIMLIB_OptCache();
+    std::vector<unsigned long> jobs;    // not finished yet
+    for (unsigned long k = 0; k < done.size(); k++) {
+        if (done[k])
+            continue;
+        unsigned long i = k / R, r = k % R;
+        if (cache && cache->Find(point(i), keys[r], r, res[i].y[r]))
+            file.Write(i, r, res[i]);
+        else
+            jobs.push_back(k);
+    }
+    Dprintf(("Sweep: %lu points, %lu replications, %lu jobs to run",
+             (unsigned long) x.size(), R, (unsigned long) jobs.size()));
+    SIMLIB_OptJobs(jobs.size(), o.threads, o.fork,
+                   [&](unsigned long k) {
+                       unsigned long i = jobs[k] / R, r = jobs[k] % R;
+                       SIMLIB_RandomReplica(master + 0x9e3779b97f4a7c15ULL
+                                            * (r + 1), streams[r]);
+                       return f(point(i), r);
+                   },
+                   [&](unsigned long k, double y) {
+                       unsigned long i = jobs[k] / R, r = jobs[k] % R;
+                       res[i].y[r] = y;        // each job has own item
+                       file.Write(i, r, res[i]);
+                       if (cache)
+                           cache->Store(point(i), keys[r], r, y);
+                   });
+    return res;
+}
+
+}
+// end
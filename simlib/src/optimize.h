@@ -12,8 +12,12 @@
 #ifndef __SIMLIB_OPTIMIZE_H
 #define __SIMLIB_OPTIMIZE_H
 
+#include <vector>
+
 namespace simlib3 {
 
+class Stat;                     // simlib.h
+
 class Param
 {
     const char *name;           // name of parameter  c-string
@@ -82,6 +86,42 @@ class ParameterVector
 // Type of function to optimize
 typedef double (*opt_function_t) (const ParameterVector & p);
 
+////////////////////////////////////////////////////////////////////////////
+// evaluation cache (memoization of simulation results)
+//
+// Key: values of parameters quantized to `quantum` (absolute value), the
+// key of random input of the run (hash of master seed and state of
+// default stream given to the run) and replication number. The cache set
+// by SetEvaluationCache() is consulted by parallel Optimize_* methods
+// (ParallelOptions), Sweep(), SensitivityAnalysis() and SelectBest()
+// before each simulation run. Sequential methods do not use it: their
+// runs continue the random stream of the caller. One cache is for one
+// function.
+// Optional file: results of previous sessions are read, new results are
+// appended as they are stored. The cache can be shared by threads.
+
+class EvaluationCache
+{
+    struct Data;
+    Data *d;
+    EvaluationCache(const EvaluationCache &) = delete;
+    EvaluationCache & operator = (const EvaluationCache &) = delete;
+  public:
+    explicit EvaluationCache(double quantum = 1e-9, const char *file = 0);
+   ~EvaluationCache();
+    bool Find(const ParameterVector & p, unsigned long long random,
+              unsigned long replication, double & y);
+    void Store(const ParameterVector & p, unsigned long long random,
+               unsigned long replication, double y);
+    unsigned long Size() const;         // number of results
+    unsigned long Hits() const;         // successful Find() calls
+    unsigned long Misses() const;       // unsuccessful Find() calls
+};
+
+// cache used by optimization methods and Sweep() (0 = no cache)
+// returns the previous cache
+EvaluationCache *SetEvaluationCache(EvaluationCache * c);
+
 // Predefined optimization methods
 double Optimize_hooke(opt_function_t f, ParameterVector & p,
                       double rho, double epsilon, int itermax);
@@ -91,6 +131,149 @@ double Optimize_simann(opt_function_t f, ParameterVector & p, int MAXT);
 double Optimize_gradient(opt_function_t f, ParameterVector & p,
                          double MAXITER);
 
+////////////////////////////////////////////////////////////////////////////
+// parallel optimization methods
+//
+// Cost function evaluations independent of each other are evaluated at
+// once: exploratory moves of Hooke-Jeeves, components of finite
+// difference gradient, population of annealing candidates. All
+// evaluations use the same random numbers: the default stream is a copy
+// of the caller's current stream (common random numbers), so the result
+// depends on the seed only, not on the number of workers.
+// Thread workers: f creates the model (as in RunReplications()),
+// fork workers: f can use global model (as in ForkReplications()).
+
+struct ParallelOptions {
+    unsigned threads = 0;       // workers, 0 = number of CPUs
+    bool fork = false;          // workers are processes (POSIX)
+};
+
+double Optimize_hooke(opt_function_t f, ParameterVector & p,
+                      double rho, double epsilon, int itermax,
+                      const ParallelOptions & o);
+
+// population = candidates evaluated at each temperature
+double Optimize_simann(opt_function_t f, ParameterVector & p, int MAXT,
+                       unsigned population, const ParallelOptions & o);
+
+double Optimize_gradient(opt_function_t f, ParameterVector & p,
+                         double MAXITER, const ParallelOptions & o);
+
+////////////////////////////////////////////////////////////////////////////
+// parameter sweep (design of experiments)
+//
+
+// designs over parameter ranges
+enum SweepDesign {
+    SWEEP_GRID,                 // full factorial grid, `points` levels
+                                //   of each parameter (min..max)
+    SWEEP_LHS,                  // Latin hypercube, `points` points
+    SWEEP_SOBOL                 // Sobol sequence, `points` points
+};
+
+struct SweepOptions {
+    SweepDesign design = SWEEP_GRID;
+    unsigned long points = 10;  // see SweepDesign
+    unsigned long replications = 1;     // runs at each point
+    unsigned threads = 0;       // workers, 0 = number of CPUs
+    bool fork = false;          // workers are processes (POSIX)
+    const char *file = 0;       // results (TSV), written as jobs end
+    bool resume = false;        // skip jobs already in file
+};
+
+// values of parameters in design points (LHS depends on RandomSeed())
+std::vector<std::vector<double> > SweepPoints(const ParameterVector & p,
+                                              SweepDesign design,
+                                              unsigned long points);
+
+// results of one point
+struct SweepPoint {
+    std::vector<double> x;      // values of parameters
+    std::vector<double> y;      // results of replications
+};
+
+// Type of function evaluated by sweep (one simulation run)
+typedef double (*sweep_function_t) (const ParameterVector & p,
+                                    unsigned long replication);
+
+// run all (point x replication) jobs in parallel
+std::vector<SweepPoint> Sweep(sweep_function_t f, const ParameterVector & p,
+                              const SweepOptions & o);
+
+
+////////////////////////////////////////////////////////////////////////////
+// ranking and selection (OCBA: optimal computing budget allocation)
+//
+// Candidates get `initial` replications, then each stage adds `increment`
+// replications allocated by OCBA (most to candidates close to the best
+// and with high variance) until the estimated probability of correct
+// selection (approximate PCS, Bonferroni bound) reaches `pcs` or the
+// budget is spent (warning: PCS not reached). Candidates with means
+// closer than `indifference` to the best are also correct selections;
+// without indifference zone the PCS of equal candidates stays low and
+// the whole budget is used. Replication r of all candidates uses the
+// same random numbers (as in Sweep()), results do not depend on workers.
+
+struct SelectionOptions {
+    double pcs = 0.95;          // requested probability of correct selection
+    unsigned long initial = 10; // first replications of each candidate
+    unsigned long increment = 20;       // replications added by one stage
+    unsigned long budget = 10000;       // max. replications of all (> 0)
+    double indifference = 0;    // smaller difference of means is correct
+    bool maximize = false;      // select the greatest mean (else least)
+    unsigned threads = 0;       // workers, 0 = number of CPUs
+    bool fork = false;          // workers are processes (POSIX)
+};
+
+// select the best candidate by replications of f
+// results: Stat of each candidate (empty, or replications 0..n-1 of
+// previous call), pcs: estimated probability of correct selection
+// returns index of the best candidate
+unsigned SelectBest(sweep_function_t f,
+                    const std::vector<ParameterVector> & candidates,
+                    Stat * results, const SelectionOptions & o,
+                    double *pcs = 0);
+
+
+////////////////////////////////////////////////////////////////////////////
+// global sensitivity analysis
+//
+// Sobol indices: Saltelli design of N(d+2) runs (matrices A, B of the
+// Sobol sequence in 2d dimensions, d <= 16, and A with i-th column of B),
+// first-order indices (Saltelli 2010) and total indices (Jansen); all
+// indices use the same runs, confidence intervals by bootstrap of the
+// rows. Morris: r trajectories of d+1 runs on grid of `levels`, mean of
+// elementary effects, mean of absolute values and standard deviation
+// (parameters scaled to range 0..1). Runs are evaluated as replication 0
+// of Sweep() (common random numbers, workers, evaluation cache).
+
+enum SensitivityMethod {
+    SENSITIVITY_SOBOL,          // variance based indices
+    SENSITIVITY_MORRIS          // elementary effects (screening)
+};
+
+struct SensitivityOptions {
+    SensitivityMethod method = SENSITIVITY_SOBOL;
+    unsigned long samples = 256;        // Sobol: N, Morris: trajectories
+    unsigned levels = 4;                // Morris grid
+    unsigned long bootstrap = 200;      // Sobol: resamples (0 = no CI)
+    double confidence = 0.95;           // of intervals
+    unsigned threads = 0;       // workers, 0 = number of CPUs
+    bool fork = false;          // workers are processes (POSIX)
+};
+
+// indices of one parameter
+struct Sensitivity {
+    const char *name;           // parameter name
+    double first, first_low, first_high;        // S_i, interval
+    double total, total_low, total_high;        // S_Ti, interval
+    double mu, mu_star, sigma;  // Morris: mean, mean |EE|, std. deviation
+};
+
+std::vector<Sensitivity> SensitivityAnalysis(sweep_function_t f,
+                                             const ParameterVector & p,
+                                             const SensitivityOptions & o);
+
 }
 
 #endif // __SIMLIB_OPTIMIZE_H
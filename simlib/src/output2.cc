@@ -45,7 +45,7 @@ void Facility::Output() const
     sprintf(s," Time interval = %g - %g ",tstat.StartTime(), (double)Time);
     Print(  "| %-56s |\n", s);
     Print(  "|  Number of requests = %-28ld       |\n", tstat.Number());
-    if (Time>tstat.StartTime())
+    if (Time>tstat.StartTime() && StatisticsLevel()==STAT_FULL)
       Print("|  Average utilization = %-27g       |\n", tstat.MeanValue());
   }
   Print("+----------------------------------------------------------+\n");
@@ -116,7 +116,8 @@ void Process::Output() const
 void Queue::Output() const
 {
   Print("+----------------------------------------------------------+\n");
-  Print("| QUEUE %-39s %10s |\n", Name().c_str(), StatN.Number()?"":"not used");
+  Print("| QUEUE %-39s %10s |\n", Name().c_str(), StatN.Number() ? "" :
+        StatisticsLevel()==STAT_NONE ? "no stat" : "not used");
   if (StatN.Number() > 0)
   {
     Print("+----------------------------------------------------------+\n");
@@ -126,6 +127,10 @@ void Queue::Output() const
     Print(  "|  Incoming  %-26ld                    |\n", StatN.Number());
     Print(  "|  Outcoming  %-26ld                   |\n", StatDT.Number());
     Print(  "|  Current length = %-26lu             |\n", size());
+    if (StatisticsLevel()!=STAT_FULL) { // only counters collected
+      Print("+----------------------------------------------------------+\n");
+      return;
+    }
     Print(  "|  Maximal length = %-25g              |\n", StatN.Max());
     double dt = double(Time) - StatN.StartTime();
     if(dt>0)
@@ -142,6 +147,15 @@ void Queue::Output() const
       if (StatDT.Number()>99)
         Print("|  Standard deviation = %-25g          |\n",
                StatDT.StdDev());
+      if (_WaitQuantiles && _WaitQuantiles->Centroids()>0)
+      {
+        Print("|  Time quantiles:                                         |\n");
+        static const double p[] = { 0.5, 0.9, 0.95, 0.99 };
+        for (unsigned i = 0; i < sizeof(p)/sizeof(p[0]); i++) {
+          sprintf(s,"  %2g%% = %g ", p[i]*100, _WaitQuantiles->Quantile(p[i]));
+          Print("| %-56s |\n", s);
+        }
+      }
     }
   }
   Print("+----------------------------------------------------------+\n");
@@ -198,6 +212,9 @@ void Store::Output() const
     sprintf(s," Time interval = %g - %g ",tstat.StartTime(), (double)Time);
     Print(  "| %-56s |\n", s);
     Print(  "|  Number of Enter operations = %-24ld   |\n", tstat.Number());
+  }
+  if (tstat.n>0 && StatisticsLevel()==STAT_FULL)
+  {
     Print(  "|  Minimal used capacity = %-30g  |\n", tstat.Min());
     Print(  "|  Maximal used capacity = %-30g  |\n", tstat.Max());
     if (Time>tstat.StartTime())
@@ -0,0 +1,277 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file preempt.cc  Implementation of PreemptiveFacility
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class PreemptiveFacility implementation
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "preempt.h"
+#include "internal.h"
+
+#include <algorithm>    // push_heap, pop_heap
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+#define CHECKENTITY(fptr)   if (!fptr) SIMLIB_error(EntityRefError)
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+PreemptiveFacility::PreemptiveFacility(Policy_t p) :
+    policy(p), seq(0), start(0), duration(-1)
+{
+    Dprintf(("PreemptiveFacility::PreemptiveFacility(%d)", int(p)));
+}
+
+PreemptiveFacility::PreemptiveFacility(const char *name, Policy_t p) :
+    Facility(name), policy(p), seq(0), start(0), duration(-1)
+{
+    Dprintf(("PreemptiveFacility::PreemptiveFacility(\"%s\",%d)", name, int(p)));
+}
+
+PreemptiveFacility::PreemptiveFacility(const char *name, Queue * queue, Policy_t p) :
+    Facility(name, queue), policy(p), seq(0), start(0), duration(-1)
+{
+    Dprintf(("PreemptiveFacility::PreemptiveFacility(\"%s\",%s,%d)",
+             name, queue->Name().c_str(), int(p)));
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+PreemptiveFacility::~PreemptiveFacility()
+{
+    Dprintf(("PreemptiveFacility::~PreemptiveFacility()  // \"%s\" ",
+             Name().c_str()));
+    Forget();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  heap ordering: a has lower precedence than b
+//
+// higher service priority first, then higher priority, then FIFO
+//
+bool PreemptiveFacility::lower(const Interrupted &a, const Interrupted &b)
+{
+    if (a.sprio != b.sprio)
+        return a.sprio < b.sprio;
+    if (a.prio != b.prio)
+        return a.prio < b.prio;
+    return a.seq > b.seq;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Preempt -- interrupt current service
+//
+// the entity in service is removed from calendar (O(1) via its notice)
+//
+void PreemptiveFacility::Preempt()
+{
+    Dprintf((" %s: service of %s interrupted", Name().c_str(),
+             in->Name().c_str()));
+    if (in->Idle())     // currently serviced entity is not scheduled
+        SIMLIB_error(FacInterruptError);
+    double end = in->ActivationTime();
+    Interrupted item;
+    item.e = in;
+    item.sprio = in->_SPrio;
+    item.prio = in->Priority;
+    item.seq = seq++;
+    item.duration = (duration < 0) ? end - start : duration;
+    item.service = (policy == PREEMPT_RESTART) ? item.duration : end - Time;
+    in->Passivate();    // cancel end of service
+    if (policy == PREEMPT_DISCARD) {
+        in->_Discarded = this;  // its Release() is ignored
+        Discarded(in);
+        return;
+    }
+    in->_Interrupted = this;    // removed if cancelled
+    heap.push_back(item);
+    std::push_heap(heap.begin(), heap.end(), lower);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Remove -- remove interrupted request of entity e (cancelled)
+//
+// linear search, the heap is rebuilt (rare operation)
+//
+void PreemptiveFacility::Remove(Entity *e)
+{
+    Dprintf((" %s: interrupted %s removed", Name().c_str(), e->Name().c_str()));
+    for (size_t i = 0; i < heap.size(); i++)
+        if (heap[i].e == e) {
+            heap[i] = heap.back();
+            heap.pop_back();
+            std::make_heap(heap.begin(), heap.end(), lower);
+            break;
+        }
+    e->_Interrupted = 0;
+}
+
+void PreemptiveFacility::Cancelled(Entity *e)
+{
+    static_cast<PreemptiveFacility*>(e->_Interrupted)->Remove(e);
+}
+
+void SIMLIB_InterruptedRemove(Entity *e)
+{
+    PreemptiveFacility::Cancelled(e);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Forget -- interrupted entities are not in facility
+//
+void PreemptiveFacility::Forget()
+{
+    for (size_t i = 0; i < heap.size(); i++)
+        heap[i].e->_Interrupted = 0;
+    heap.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Discarded -- discarded entity leaves facility now
+//
+void PreemptiveFacility::Discarded(Entity *e)
+{
+    e->Activate();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Seize -- seize facility by entity e
+//
+void PreemptiveFacility::Seize(Entity * e, ServicePriority_t sp)
+{
+    Dprintf(("%s.Seize(%s,%u)", Name().c_str(), e->Name().c_str(), (unsigned) sp));
+    CHECKENTITY(e);
+    if (e != Current)
+        SIMLIB_error(EntityRefError);
+    e->_SPrio = sp;
+    if (e->_Discarded == this)
+        e->_Discarded = 0;      // new request after discarded service
+    if (Busy() && sp <= in->_SPrio) {   // go into main queue
+        QueueIn(e, sp);
+        e->Passivate();         // wait in queue, activated by Release()
+        // =======================================================
+        // continue after activation
+        Dprintf(("%s.Seize(%s,%u) from Q1", Name().c_str(), e->Name().c_str(),
+                 (unsigned) sp));
+        return;
+    }
+    if (Busy())
+        Preempt();
+    in = e;                     // seize by entity
+    start = Time;
+    duration = -1;
+    SIMLIB_STAT_RECORD(_StatLevel, tstat, 1); // update statistics
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Release -- release facility by entity e
+//
+void PreemptiveFacility::Release(Entity * e)
+{
+    Dprintf(("%s.Release(%s)", Name().c_str(), e->Name().c_str()));
+    CHECKENTITY(e);
+    if (e->_Discarded == this) {        // ignore release of discarded entity
+        e->_Discarded = 0;
+        return;
+    }
+    if (!in)
+        SIMLIB_error(ReleaseNotSeized); // not seized
+    if (e != in)
+        SIMLIB_error(ReleaseError);     // seized by other entity
+    in = NULL;                  // empty
+    SIMLIB_STAT_UPDATE(_StatLevel, tstat, 0); // record
+    bool flag = false;          // Q1 has higher service priority
+    if (!(Q1->empty() || heap.empty()))
+        flag = Q1->front()->_SPrio > heap.front().sprio;
+    if (!flag && !heap.empty()) { // seize from interrupted requests
+        Interrupted item = heap.front();
+        std::pop_heap(heap.begin(), heap.end(), lower);
+        heap.pop_back();
+        Dprintf(("%s.Seize(%s,%u) resumed", Name().c_str(),
+                 item.e->Name().c_str(), (unsigned) item.sprio));
+        in = item.e;            // seize again
+        in->_Interrupted = 0;
+        start = Time;
+        duration = item.duration;
+        SIMLIB_STAT_UPDATE(_StatLevel, tstat, 1);
+        in->Activate(Time + item.service);  // schedule end of service
+        return;
+    }
+    if (!Q1->empty()) {         // input queue not empty -- seize from Q1
+        Entity *ent = Q1->front();
+        ent->Out();             // remove from queue
+        in = ent;
+        start = Time;
+        duration = -1;
+        SIMLIB_STAT_RECORD(_StatLevel, tstat, 1); // update statistics
+        ent->Activate();        // activation of entity behavior
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  initialization
+//
+void PreemptiveFacility::Clear()
+{
+    Dprintf(("%s.Clear()", Name().c_str()));
+    Facility::Clear();
+    Forget();
+    seq = 0;
+    duration = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output -- print statistics
+//
+void PreemptiveFacility::Output() const
+{
+    static const char *policy_name[] = { "resume", "restart", "discard" };
+    char s[100];
+    Print("+----------------------------------------------------------+\n");
+    Print("| PREEMPTIVE FACILITY %-36s |\n", Name().c_str());
+    Print("+----------------------------------------------------------+\n");
+    sprintf(s, " Status = %s ", (Busy()) ? "BUSY" : "not BUSY");
+    Print("| %-56s |\n", s);
+    sprintf(s, " Preemption policy = %s ", policy_name[policy]);
+    Print("| %-56s |\n", s);
+    if (tstat.Number() > 0) {
+        sprintf(s, " Time interval = %g - %g ", tstat.StartTime(), (double)Time);
+        Print(  "| %-56s |\n", s);
+        Print(  "|  Number of requests = %-28ld       |\n", tstat.Number());
+        Print(  "|  Number of interrupts = %-26lu       |\n", seq);
+        Print(  "|  Interrupted waiting = %-27u       |\n", InterruptedLen());
+        if (Time > tstat.StartTime() && StatisticsLevel() == STAT_FULL)
+            Print("|  Average utilization = %-27g       |\n", tstat.MeanValue());
+    }
+    Print("+----------------------------------------------------------+\n");
+    if (OwnQueue()) {
+        if (Q1->StatN.Number() > 0) { // used
+            Print("  Input queue '%s.Q1'\n", Name().c_str());
+            Q1->Output();
+        }
+    }
+    else
+        Print("  External input queue '%s'\n", Q1->Name().c_str());
+    Print("\n");
+}
+
+}
+// end
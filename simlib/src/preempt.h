@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file preempt.h     Facility with preemptive service interface
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  This is the interface for preemptive facility
+//
+//  Interrupted requests are stored in binary heap ordered by service
+//  priority, entity priority and order of interruption, so each
+//  interruption/resumption is O(log n) instead of linear scan of Q2.
+//
+
+#ifndef __SIMLIB__
+#   error "preempt.h: 16: you should include simlib.h first"
+#endif
+#if __SIMLIB__ < 0x0308
+#   error "preempt.h: 19: requires SIMLIB version 3.08 and higher"
+#endif
+
+#include <vector>
+
+namespace simlib3 {
+
+////////////////////////////////////////////////////////////////////////////
+//! Facility with preemptive service
+//! Entity with higher service priority interrupts current service.
+//! The interrupted entity is handled according to the policy:
+//!  - PREEMPT_RESUME:  continues with remaining service time
+//!  - PREEMPT_RESTART: repeats whole service time
+//!  - PREEMPT_DISCARD: leaves facility (is activated at interrupt time,
+//!                     its later Release() is ignored, the entity
+//!                     is marked until Release() or next Seize())
+//! Interrupted entity which is cancelled or deleted is removed.
+//! \ingroup simlib
+class PreemptiveFacility : public Facility {
+ public:
+  enum Policy_t { PREEMPT_RESUME, PREEMPT_RESTART, PREEMPT_DISCARD };
+ protected:
+  //! item of interrupted requests heap
+  struct Interrupted {
+    Entity *e;                  //!< interrupted entity
+    ServicePriority_t sprio;    //!< service priority
+    EntityPriority_t prio;      //!< entity priority
+    unsigned long seq;          //!< order of interruption (FIFO)
+    double service;             //!< service time to do after resumption
+    double duration;            //!< whole service time (for restart)
+  };
+  static bool lower(const Interrupted &a, const Interrupted &b);
+  std::vector<Interrupted> heap;        //!< interrupted requests
+  Policy_t policy;              //!< preemption policy
+  unsigned long seq;            //!< interruption counter
+  double start;                 //!< start of current service
+  double duration;              //!< whole service time (<0 if unknown)
+  void Preempt();               // interrupt current service
+  void Remove(Entity *e);       // remove interrupted request of e
+  static void Cancelled(Entity *e); // e is in heap of its facility
+  void Forget();                // clear marks of interrupted entities
+  friend void SIMLIB_InterruptedRemove(Entity *e);  // cancelled entity
+  //! called for each discarded entity, default: activate now
+  virtual void Discarded(Entity *e);
+ public:
+  explicit PreemptiveFacility(Policy_t p = PREEMPT_RESUME);
+  explicit PreemptiveFacility(const char *_name, Policy_t p = PREEMPT_RESUME);
+  PreemptiveFacility(const char *_name, Queue *_queue1, Policy_t p = PREEMPT_RESUME);
+  virtual ~PreemptiveFacility();
+  virtual void Output() const override;         //!< print statistics
+  Policy_t Policy() const { return policy; }
+  void SetPolicy(Policy_t p) { policy = p; }    //!< change policy
+  unsigned long Interrupts() const { return seq; } //!< number of interrupts
+  unsigned InterruptedLen() const { return heap.size(); }
+  virtual void Seize(Entity *e, ServicePriority_t sp=DEFAULT_PRIORITY) override;
+  virtual void Release(Entity *e) override;
+  virtual void Clear() override;                //!< initialize
+}; // class PreemptiveFacility
+
+} // namespace
+
@@ -31,7 +31,7 @@ SIMLIB_IMPLEMENTATION;
 
 // This singleton solves module initialization order problem
 class _FileWrap {
-    static FILE *OutFile;
+    static thread_local FILE *OutFile;
     static FILE *get() {
         if(!OutFile)
             OutFile = stdout;
@@ -42,7 +42,7 @@ class _FileWrap {
     void operator = (FILE *f)   { OutFile=f; }
 } OutFile;
 
-FILE *_FileWrap::OutFile = 0;
+thread_local FILE *_FileWrap::OutFile = 0;
 
 ////////////////////////////////////////////////////////////////////////////
 //  SetOutput
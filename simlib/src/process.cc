@@ -125,12 +125,12 @@ struct P_Context_t {
 
 ////////////////////////////////////////////////////////////////////////////
 // global variables (should be volatile)
-static jmp_buf P_DispatcherStatusBuffer; //!< setjmp() state before dispatch
-static char *volatile P_StackBase = 0;   //!< global start of stack area
-static char *volatile P_StackBase2 = 0;  //!< for checking start of stack
+static thread_local jmp_buf P_DispatcherStatusBuffer; //!< setjmp() state before dispatch
+static thread_local char *volatile P_StackBase = 0;   //!< global start of stack area
+static thread_local char *volatile P_StackBase2 = 0;  //!< for checking start of stack
 
-static P_Context_t *volatile P_Context = 0; //!< temporary global process state
-static volatile size_t P_StackSize = 0;     //!< temporary global stack size
+static thread_local P_Context_t *volatile P_Context = 0; //!< temporary global process state
+static thread_local volatile size_t P_StackSize = 0;     //!< temporary global stack size
 
 ////////////////////////////////////////////////////////////////////////////
 // Support for THREADS implementation debugging:
@@ -413,6 +413,8 @@ void Process::Terminate()
     }
     if (!Idle())
         SQS::Get(this);         // remove from calendar
+    if (_Interrupted)           // remove interrupted service
+        SIMLIB_InterruptedRemove(this);
 
     // End of thread
     if (isCurrent()) {          // if currently running process
@@ -493,7 +495,7 @@ void Process::_Run() noexcept // no exceptions
 #if EXTRA_DEBUG
     DEBUG(DBG_THREAD,("| THREAD_STACK_BASE=%016p", P_StackBase));
     // CHECK if the P_StackBase position is the same in each call
-    static char *P_StackBase0=0;
+    static thread_local char *P_StackBase0=0;
     if(P_StackBase0==0)
         P_StackBase0=P_StackBase;
     else if (P_StackBase!=P_StackBase0)
@@ -0,0 +1,225 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file quantile.cc  Statistics with quantile estimates (t-digest)
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class QuantileStat implementation
+//
+//  Merging t-digest (T. Dunning): recorded values are buffered, the buffer
+//  is sorted and merged with existing centroids when full. Size of
+//  centroids is limited by the scale function k(q) = delta/(2*pi)*asin(2q-1)
+//  -- each centroid covers at most unit interval of k, so there are at most
+//  about delta centroids and centroids near q=0 and q=1 are small.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <algorithm>    // sort, merge
+#include <cmath>        // asin, sin, ceil
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+static bool by_mean(const QuantileStat::Centroid &a,
+                    const QuantileStat::Centroid &b)
+{
+  return a.mean < b.mean;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+QuantileStat::QuantileStat(double compression) :
+  delta(compression)
+{
+  Dprintf(("QuantileStat::QuantileStat(%g)", compression));
+  Init();
+}
+
+QuantileStat::QuantileStat(const char *name, double compression) :
+  Stat(name), delta(compression)
+{
+  Dprintf(("QuantileStat::QuantileStat(\"%s\",%g)", name, compression));
+  Init();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Init --- allocate arrays (memory is not changed after this)
+//
+void QuantileStat::Init()
+{
+  if (delta < 10)
+    SIMLIB_error(QuantileError);
+  cap = 2 * unsigned(ceil(delta)) + 4;   // centroids (at most delta+2)
+  bufcap = 5 * unsigned(ceil(delta));
+  c = new Centroid[cap];
+  buf = new Centroid[bufcap];
+  tmp = new Centroid[cap + bufcap];
+  nc = nb = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+QuantileStat::~QuantileStat()
+{
+  Dprintf(("QuantileStat::~QuantileStat() // \"%s\" ", Name().c_str()));
+  delete [] c;
+  delete [] buf;
+  delete [] tmp;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Clear --- initialize
+//
+void QuantileStat::Clear()
+{
+  Stat::Clear();
+  nc = nb = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Add --- add value x with weight w into buffer
+//
+void QuantileStat::Add(double x, double w)
+{
+  if (nb == bufcap)
+    Compress();
+  buf[nb].mean = x;
+  buf[nb].weight = w;
+  ++nb;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator ()  --- record value
+//
+void QuantileStat::operator () (double x)
+{
+  Stat::operator()(x);
+  Add(x, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Merge --- add all records of other digest
+//
+void QuantileStat::Merge(const QuantileStat &x)
+{
+  Dprintf(("QuantileStat::Merge(\"%s\")", x.Name().c_str()));
+  Stat::Merge(x);
+  for (unsigned i = 0; i < x.nc; i++)
+    Add(x.c[i].mean, x.c[i].weight);
+  for (unsigned i = 0; i < x.nb; i++)
+    Add(x.buf[i].mean, x.buf[i].weight);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Compress --- merge buffered values into centroids
+//
+void QuantileStat::Compress() const
+{
+  if (nb == 0)
+    return;
+  std::sort(buf, buf + nb, by_mean);
+  std::merge(c, c + nc, buf, buf + nb, tmp, by_mean);
+  unsigned m = nc + nb;
+  double W = 0;                 // total weight
+  for (unsigned i = 0; i < m; i++)
+    W += tmp[i].weight;
+  const double kmax = delta / 4;        // k(1)
+  const double scale = delta / (2 * M_PI);
+  nc = nb = 0;
+  double wsofar = 0;            // weight of finished centroids
+  double limit = W * (sin((-kmax + 1) / scale) + 1) / 2;
+  Centroid cur = tmp[0];
+  for (unsigned i = 1; i < m; i++) {
+    double w = cur.weight + tmp[i].weight;
+    if (wsofar + w <= limit) {  // add to current centroid
+      cur.mean += (tmp[i].mean - cur.mean) * tmp[i].weight / w;
+      cur.weight = w;
+    } else {                    // start new centroid
+      wsofar += cur.weight;
+      c[nc++] = cur;
+      double q = wsofar / W;
+      double k = scale * asin(2 * q - 1) + 1;
+      limit = (k >= kmax) ? W : W * (sin(k / scale) + 1) / 2;
+      cur = tmp[i];
+    }
+  }
+  c[nc++] = cur;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Quantile --- estimate of q-quantile
+//
+// interpolation between centroid means, min and max are used at ends
+//
+double QuantileStat::Quantile(double q) const
+{
+  if (q < 0 || q > 1)
+    SIMLIB_error(QuantileError);
+  Compress();
+  if (nc == 0)
+    SIMLIB_error(StatNoRecError);
+  if (nc == 1)
+    return c[0].mean;
+  double W = 0;
+  for (unsigned i = 0; i < nc; i++)
+    W += c[i].weight;
+  double target = q * W;
+  double cum = c[0].weight / 2;         // position of first mean
+  if (target < cum)                     // between min and first mean
+    return min + (c[0].mean - min) * target / cum;
+  for (unsigned i = 0; i + 1 < nc; i++) {
+    double dw = (c[i].weight + c[i+1].weight) / 2;
+    if (target < cum + dw)
+      return c[i].mean + (c[i+1].mean - c[i].mean) * (target - cum) / dw;
+    cum += dw;
+  }
+  double last = c[nc-1].weight / 2;     // between last mean and max
+  double x = c[nc-1].mean + (max - c[nc-1].mean) * (target - cum) / last;
+  return (x > max) ? max : x;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print statistics and selected quantiles
+//
+void QuantileStat::Output() const
+{
+  Print("+----------------------------------------------------------+\n");
+  Print("| QUANTILE STATISTIC %-37s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  if (n == 0 || Centroids() == 0)
+    Print("|  no record                                               |\n");
+  else
+  {
+    char s[100];
+    Print(  "|  Min = %-15g         Max = %-15g     |\n", min, max);
+    Print(  "|  Number of records = %-26ld          |\n", n);
+    Print(  "|  Average value = %-25g               |\n", MeanValue());
+    if (n > 99)
+      Print("|  Standard deviation = %-25g          |\n", StdDev());
+    static const double p[] = { 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 };
+    for (unsigned i = 0; i < sizeof(p)/sizeof(p[0]); i++) {
+      sprintf(s, " %2g%% quantile = %g ", p[i] * 100, Quantile(p[i]));
+      Print("| %-56s |\n", s);
+    }
+  }
+  Print("+----------------------------------------------------------+\n");
+}
+
+} // namespace
+
@@ -26,12 +26,13 @@ SIMLIB_IMPLEMENTATION;
 ////////////////////////////////////////////////////////////////////////////
 //  constructors
 //
-Queue::Queue()
+Queue::Queue() : _StatLevel(SIMLIB_StatisticsLevel), _WaitQuantiles(0)
 {
   Dprintf(("Queue{%p}::Queue()", this));
 }
 
-Queue::Queue(const char *name)
+Queue::Queue(const char *name) : _StatLevel(SIMLIB_StatisticsLevel),
+  _WaitQuantiles(0)
 {
   Dprintf(("Queue{%p}::Queue(\"%s\")", this, name));
   SetName(name);
@@ -104,7 +105,7 @@ void Queue::PredIns(Entity *ent, iterator pos)
   Dprintf(("%s::PredIns(%s,pos:%p)", Name().c_str(), ent->Name().c_str(), *pos ));
   List::PredIns(ent, *pos); // insert before pos, can be end()
   ent->_MarkTime = Time;    // marks input time
-  StatN(size());            // length statistic
+  SIMLIB_STAT_RECORD(_StatLevel, StatN, size()); // length statistic
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -134,11 +135,29 @@ Entity *Queue::Get(iterator pos)
 {
   Dprintf(("%s::Get(pos:%p)", Name().c_str(), *pos));
   Entity *ent = static_cast<Entity*>(List::Get(*pos));
-  StatDT(Time - ent->_MarkTime);
-  StatN(size());  StatN.n--; // the number of samples correction
+  SIMLIB_STAT_RECORD(_StatLevel, StatDT, Time - ent->_MarkTime);
+  if(_WaitQuantiles)
+    SIMLIB_STAT_RECORD(_StatLevel, *_WaitQuantiles, Time - ent->_MarkTime);
+  SIMLIB_STAT_UPDATE(_StatLevel, StatN, size());
   return ent;
 }
 
+////////////////////////////////////////////////////////////////////////////
+// SetStatisticsLevel --- change level of statistics
+//
+void Queue::SetStatisticsLevel(StatisticsLevel_t level)
+{
+  Dprintf(("%s::SetStatisticsLevel(%d)", Name().c_str(), int(level)));
+  StatisticsLevel_t l = SIMLIB_StatLevelLimit(level);
+  if (l != _StatLevel) {        // do not mix records of different levels
+    StatN.Clear(size());
+    StatDT.Clear();
+    if (_WaitQuantiles)
+      _WaitQuantiles->Clear();
+  }
+  _StatLevel = l;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //  clear - initialization of list
 //
@@ -150,6 +169,8 @@ void Queue::clear()
   List::clear(); // problem with WARNING
   StatN.Clear();
   StatDT.Clear();
+  if(_WaitQuantiles)
+    _WaitQuantiles->Clear();
 }
 
 #if 0
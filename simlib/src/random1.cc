@@ -10,6 +10,9 @@
 // base random number generator
 // generate uniform distribution in the range 0 .. 0.99999999999....
 //
+// xoshiro256** by D. Blackman and S. Vigna (2018), 64bit state words
+// are initialized from seed using splitmix64
+//
 
 ////////////////////////////////////////////////////////////////////////////
 // interface
@@ -33,59 +36,190 @@ void   SetBaseRandomGenerator(double (*new_gen)()); // change base gen.
 SIMLIB_IMPLEMENTATION;
 
 
-// TODO: change the basic generator to something better
+////////////////////////////////////////////////////////////////////////////
+// splitmix64 --- generator used for initialization of state
+//
+static unsigned long long splitmix64(unsigned long long &x)
+{
+  unsigned long long z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
 
-#if (LONG_MAX<(1ULL<<32))
-typedef long myint32;     // long has 32 bits
-#else
-typedef int myint32;      // long has >32 bits
-#endif
+////////////////////////////////////////////////////////////////////////////
+// RandomStream --- constructor, initialization
+//
+RandomStream::RandomStream(unsigned long long seed) :
+  amask(0)
+{
+  Seed(seed);
+}
 
 ////////////////////////////////////////////////////////////////////////////
-// some constants for base generator
+// master seed --- the last RandomSeed() value, base of component streams
 //
+SIMLIB_CONSTINIT static thread_local unsigned long long master_seed = 1537;
 
-const myint32 INICONST   = 1537L;
-const myint32 MULCONST   = 1220703125L;
-// period = 536870912 only!
+////////////////////////////////////////////////////////////////////////////
+// ForComponent --- stream for model component (common random numbers)
+//
+// seed = FNV-1a hash of name xor scrambled master seed
+//
+RandomStream RandomStream::ForComponent(const char *name)
+{
+  unsigned long long h = 0xcbf29ce484222325ULL;
+  for(const unsigned char *p = reinterpret_cast<const unsigned char*>(name); *p; p++)
+    h = (h ^ *p) * 0x100000001b3ULL;
+  unsigned long long m = master_seed;
+  return RandomStream(h ^ splitmix64(m));
+}
 
-const myint32 MAXLONGINT = 0x7FFFFFFFUL;
-const myint32 SIGNBIT    = 0x80000000UL;
+void RandomStream::Seed(unsigned long long seed)
+{
+  for(int i=0; i<4; i++)
+    s[i] = splitmix64(seed);    // never all zeros
+}
 
 ////////////////////////////////////////////////////////////////////////////
-// random generator seed
+// jump --- skip numbers given by jump polynomial
 //
+void RandomStream::jump(const unsigned long long *poly)
+{
+  unsigned long long t[4] = { 0, 0, 0, 0 };
+  for(int i=0; i<4; i++)
+    for(int b=0; b<64; b++) {
+      if(poly[i] & (1ULL << b))
+        for(int j=0; j<4; j++)
+          t[j] ^= s[j];
+      Next();
+    }
+  for(int j=0; j<4; j++)
+    s[j] = t[j];
+}
+
+void RandomStream::Jump()
+{
+  static const unsigned long long JUMP[] = {
+    0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+  jump(JUMP);
+}
+
+void RandomStream::LongJump()
+{
+  static const unsigned long long LONG_JUMP[] = {
+    0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+    0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+  jump(LONG_JUMP);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Split --- returns copy of this stream and moves this stream 2^128 ahead
+//
+RandomStream RandomStream::Split()
+{
+  RandomStream r(*this);
+  Jump();
+  return r;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// default stream and current stream used by Random()
+//
+// initial state is the same as after Seed(1537) (constant initialization,
+// so Random() can be used in constructors of global objects)
+//
+SIMLIB_CONSTINIT static thread_local RandomStream default_stream(0x0a472171fcd0d7beULL,
+                0xa4ef5808fb4d4847ULL, 0xbcf6a3e88632a7a2ULL, 0xe4efae577bb3a127ULL);
+// 0 = default_stream (address of thread_local is not a constant)
+SIMLIB_CONSTINIT static thread_local RandomStream *current_stream = 0;
+
+static inline RandomStream *Stream()
+{
+  return current_stream ? current_stream : &default_stream;
+}
 
-static myint32 SIMLIB_RandomSeed = INICONST ;
+RandomStream *SetRandomStream(RandomStream *s)
+{
+  RandomStream *prev = Stream();
+  current_stream = s;
+  return prev;
+}
+
+RandomStream &CurrentRandomStream()
+{
+  return *Stream();
+}
 
 ////////////////////////////////////////////////////////////////////////////
-// RandomSeed - initialization of random generator
+// RandomSeed - initialization of random generator (current stream)
 //
 void RandomSeed(long seed)
 {
-  SIMLIB_RandomSeed = seed;
+  master_seed = static_cast<unsigned long long>(seed);
+  Stream()->Seed(master_seed);
 }
 
 ////////////////////////////////////////////////////////////////////////////
-// SIMLIB_RandomBase --- default base uniform random number generator
+// SIMLIB_RandomMasterSeed --- master seed of current thread
 //
-// uses linear congruential method
-// (not very good)
+unsigned long long SIMLIB_RandomMasterSeed()
+{
+  return master_seed;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_RandomReplica --- set random state of replication (worker thread)
+//
+void SIMLIB_RandomReplica(unsigned long long master, const RandomStream &s)
+{
+  master_seed = master;
+  default_stream = s;
+  current_stream = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_RandomKey --- key of random state of replication (evaluation cache)
+//
+// hash of master seed and state of stream: runs with the same key use
+// the same random numbers
+//
+unsigned long long SIMLIB_RandomKey(unsigned long long master, const RandomStream &s)
+{
+  unsigned long long h = master;
+  for(int i=0; i<4; i++) {
+    h ^= s.State(i);
+    h = splitmix64(h);
+  }
+  return s.Antithetic() ? ~h : h;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_RandomDefault --- default stream of current thread (checkpoint)
+//
+RandomStream &SIMLIB_RandomDefault()
+{
+  return default_stream;
+}
+
+void SIMLIB_RandomSetMasterSeed(unsigned long long master)
+{
+  master_seed = master;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_RandomBase --- default base uniform random number generator
 //
 double SIMLIB_RandomBase()  // range <0..1)
 {
-  SIMLIB_RandomSeed *= MULCONST;
-  SIMLIB_RandomSeed &= MAXLONGINT; // strip sign bit
-//  _Print("random=%lx\n", (long)SIMLIB_RandomSeed);
-  double r = static_cast<double>(SIMLIB_RandomSeed)/MAXLONGINT;
-  // assert: if( r<0.0 || r>=1.0 ) SIMLIB_error("Random() out of range");
-  return r;
+  return Stream()->Random();
 }
 
 ////////////////////////////////////////////////////////////////////////////
 // pointer to base generator
 //
-static double (*SIMLIB_RandomBasePtr)() = SIMLIB_RandomBase;
+static thread_local double (*SIMLIB_RandomBasePtr)() = SIMLIB_RandomBase;
 
 ////////////////////////////////////////////////////////////////////////////
 // Random --- base uniform random number generator
@@ -108,6 +242,20 @@ void SetBaseRandomGenerator(double (*new_gen)())
     SIMLIB_RandomBasePtr = SIMLIB_RandomBase; // default value
 }
 
+////////////////////////////////////////////////////////////////////////////
+// SIMLIB_RandomBits --- 64 random bits for fast generators (random3.cc)
+//
+// user-defined base generator is used for 2x32 bits
+//
+unsigned long long SIMLIB_RandomBits()
+{
+  if(SIMLIB_RandomBasePtr == SIMLIB_RandomBase)
+    return Stream()->Next();
+  unsigned long long hi = static_cast<unsigned long long>(Random() * 4294967296.0);
+  unsigned long long lo = static_cast<unsigned long long>(Random() * 4294967296.0);
+  return (hi << 32) | lo;
+}
+
 }
 // end
 
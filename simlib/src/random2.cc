@@ -29,6 +29,136 @@ namespace simlib3 {
 
 SIMLIB_IMPLEMENTATION;
 
+////////////////////////////////////////////////////////////////////////////
+//  Uniform - uniform random number generator
+//
+double Uniform(double l, double h)
+{
+  if( l >= h ) SIMLIB_error(BadUniformParam);
+  return(l+(h-l)*Random());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Weibul
+//
+// TODO: check
+double Weibul(double lambda, double alfa)
+{
+  double R,W;
+
+  if (lambda<=0.0 || alfa<=1.0)  SIMLIB_error(WeibullError);
+
+  while ((R=Random()) == 0 || R == 1) { /*empty*/ }
+  W= pow (-1.0/lambda*log(1.0-R), 1.0/alfa);
+  return (W);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  NegBin
+//
+int NegBin(double q, int k)
+{
+  double IS,XLOGQ,R;
+  int i;
+
+  if (k<=0 || q<=0)  SIMLIB_error(NegBinError);
+
+  IS = 0;
+  XLOGQ = log(q);
+  for (i=1; i<=k; i++)
+  {
+    while ((R=Random()) == 0) { /*empty*/ }
+    IS += log(R)/XLOGQ;
+  }
+  return int(IS);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//
+//
+int NegBinM(double p, int m)
+{
+  int i,ix;
+
+  if (m<=0)        SIMLIB_error(NegBinMError1);
+  if (p<0 || p>1)  SIMLIB_error(NegBinMError2);
+  ix = i = 0;
+  do{
+    if (Random() <= p)  ix++;
+    i++;
+  }while (i <= m);
+  return (ix);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Triag(mod,min,max)
+//
+double Triag(double mod, double min, double max)
+{
+  double RN,BMA,CMA,TR;
+
+  RN=Random();
+  BMA=mod-min;
+  CMA=max-min;
+  if  (RN<BMA/CMA)
+    TR=min+sqrt(BMA*CMA*RN);
+  else
+    TR=max-sqrt(CMA*(1.0-RN)*(max-mod));
+  return (TR);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Rayle(delta)
+//
+double Rayle(double delta)
+{
+  double R;
+  while ((R=Random()) == 0) { /*empty*/ }
+  return  delta * sqrt(-log(R));
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Geom(q)
+//
+int Geom(double q)
+{
+  double X,R;
+
+  if (q<=0)  SIMLIB_error(GeomError);
+  while ((R=Random()) == 0) { /*empty*/ }
+  X = log(R)/log(q);
+  return int(X);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  HyperGeometric
+//
+int HyperGeom(double p, int n, int m)
+{
+  int IX,i;
+  if (m <= 0)           SIMLIB_error(HyperGeomError1);
+  if (p<0 || p>1)       SIMLIB_error(HyperGeomError2);
+  IX=0;
+  for (i=1; i<=n; i++)
+  {
+    if (Random() > p)
+      p =m*p/(m-1);
+    else
+    {
+      IX++;
+      p=(m*p-1.0)/(m-1);
+    }
+    m--;
+  }
+  return (IX);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  legacy generators (SIMLIB 3.08 and older, approximate/slow methods)
+//  kept for reproducibility of old experiments, see random3.cc
+//
+namespace legacy {
+
 ////////////////////////////////////////////////////////////////////////////
 //  _gam
 //
@@ -65,15 +195,6 @@ static double _gam(double AK)
   return (G);
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  Uniform - uniform random number generator
-//
-double Uniform(double l, double h)
-{
-  if( l >= h ) SIMLIB_error(BadUniformParam);
-  return(l+(h-l)*Random());
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Normal(mi,sigma)
 //  mi    = mean value
@@ -87,21 +208,6 @@ double Normal(double mi, double sigma)
   return (SUM-6.0)*sigma + mi;
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  Weibul
-//
-// TODO: check
-double Weibul(double lambda, double alfa)
-{
-  double R,W;
-
-  if (lambda<=0.0 || alfa<=1.0)  SIMLIB_error(WeibullError);
-
-  while ((R=Random()) == 0 || R == 1) { /*empty*/ }
-  W= pow (-1.0/lambda*log(1.0-R), 1.0/alfa);
-  return (W);
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Erlang
 //
@@ -115,26 +221,6 @@ double Erlang(double alfa, int beta)
   return -alfa*log(ER);
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  NegBin
-//
-int NegBin(double q, int k)
-{
-  double IS,XLOGQ,R;
-  int i;
-
-  if (k<=0 || q<=0)  SIMLIB_error(NegBinError);
-
-  IS = 0;
-  XLOGQ = log(q);
-  for (i=1; i<=k; i++)
-  {
-    while ((R=Random()) == 0) { /*empty*/ }
-    IS += log(R)/XLOGQ;
-  }
-  return int(IS);
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Gamma
 //
@@ -158,23 +244,6 @@ double Exponential(double mv)
 
 
 
-////////////////////////////////////////////////////////////////////////////
-//
-//
-int NegBinM(double p, int m)
-{
-  int i,ix;
-
-  if (m<=0)        SIMLIB_error(NegBinMError1);
-  if (p<0 || p>1)  SIMLIB_error(NegBinMError2);
-  ix = i = 0;
-  do{
-    if (Random() <= p)  ix++;
-    i++;
-  }while (i <= m);
-  return (ix);
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Beta
 //
@@ -187,23 +256,6 @@ double Beta(double th, double fi, double min, double max)
   return (X);
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  Triag(mod,min,max)
-//
-double Triag(double mod, double min, double max)
-{
-  double RN,BMA,CMA,TR;
-
-  RN=Random();
-  BMA=mod-min;
-  CMA=max-min;
-  if  (RN<BMA/CMA)
-    TR=min+sqrt(BMA*CMA*RN);
-  else
-    TR=max-sqrt(CMA*(1.0-RN)*(max-mod));
-  return (TR);
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Log
 //
@@ -213,16 +265,6 @@ double Logar(double mi, double delta)
   return exp(VA);
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  Rayle(delta)
-//
-double Rayle(double delta)
-{
-  double R;
-  while ((R=Random()) == 0) { /*empty*/ }
-  return  delta * sqrt(-log(R));
-}
-
 ////////////////////////////////////////////////////////////////////////////
 //  Poisson(double lambda)
 //
@@ -251,66 +293,7 @@ int Poisson(double lambda)
   return PSSN;
 }
 
-////////////////////////////////////////////////////////////////////////////
-//  Geom(q)
-//
-int Geom(double q)
-{
-  double X,R;
-
-  if (q<=0)  SIMLIB_error(GeomError);
-  while ((R=Random()) == 0) { /*empty*/ }
-  X = log(R)/log(q);
-  return int(X);
-}
-
-////////////////////////////////////////////////////////////////////////////
-//  HyperGeometric
-//
-int HyperGeom(double p, int n, int m)
-{
-  int IX,i;
-  if (m <= 0)           SIMLIB_error(HyperGeomError1);
-  if (p<0 || p>1)       SIMLIB_error(HyperGeomError2);
-  IX=0;
-  for (i=1; i<=n; i++)
-  {
-    if (Random() > p)
-      p =m*p/(m-1);
-    else
-    {
-      IX++;
-      p=(m*p-1.0)/(m-1);
-    }
-    m--;
-  }
-  return (IX);
-}
-
-////////////////////////////////////////////////////////////////////////////
-//  Binom(n,theta)
-//  n     = # of experiments (pocet pokusu)
-//  theta = probability
-//
-/*
-int Binom(unsigned n, double theta)
-{
-  int BNM;
-  double SUM,R,TT,x;
-  if (theta<0 || theta>1) SIMLIB_error(BinomError);
-  SUM = R = pow(1-theta,n);
-  TT = theta/(1-theta);
-  BNM = 0;
-  x = Random();
-  while(x-SUM > 0)
-  {
-    R *= (n-BNM)/(BNM+1)*TT;
-    SUM += R;
-    BNM++;
-  }
-  return (BNM);
-}
-*/
+} // namespace legacy
 
 } // end
 
@@ -0,0 +1,739 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file random3.cc  Random number generators - fast exact methods
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  random number generators (dependent on Random())
+//
+//  Normal, Exponential:  ziggurat (G. Marsaglia, W. W. Tsang 2000),
+//                        128/256 layers, layer index and value are taken
+//                        from different bits of one 64bit number
+//  Gamma, Erlang, Beta:  G. Marsaglia, W. W. Tsang (2000)
+//  Poisson:              inversion (lambda<10),
+//                        PTRS transformed rejection (W. Hormann 1993)
+//  Binom:                inversion (n*p<=30),
+//                        BTPE (V. Kachitvichyanukul, B. W. Schmeiser 1988)
+//
+//  original (approximate) generators are in namespace legacy (random2.cc)
+//
+//  FillUniform, FillNormal, FillExponential: bulk generation, 4 interleaved
+//  xoshiro256** streams (seeded from given stream) are computed by SIMD
+//  kernel (AVX2 or SSE2, selected at run time) or by portable code -- all
+//  variants give the same numbers. In exact mode (SetFillExact) the
+//  result is the same as n calls of Uniform/Normal/Exponential.
+//
+
+////////////////////////////////////////////////////////////////////////////
+// interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cmath>  // exp() floor() log() lgamma() pow() sqrt()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMLIB_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////
+// implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+////////////////////////////////////////////////////////////////////////////
+//  ziggurat tables
+//
+//  layer i (1..N-1) is rectangle [0,x[i]] x [f(x[i]),f(x[i+1])],
+//  layer 0 is the base strip including tail (virtual width x[0]=V/f(R))
+//
+namespace {
+
+const int NN = 128;                             // normal distribution
+const double NR = 3.442619855899;               // start of tail
+const double NV = 9.91256303526217e-3;          // area of layer
+
+const int EN = 256;                             // exponential distribution
+const double ER = 7.69711747013104972;
+const double EV = 3.949659822581572e-3;
+
+struct Ziggurat {
+  double nx[NN+1], nf[NN+1];    // normal: layer widths and f(x)
+  double ex[EN+1], ef[EN+1];    // exponential
+  Ziggurat() {
+    nx[0] = NV / exp(-0.5 * NR * NR);
+    nx[1] = NR;
+    for (int i = 1; i < NN - 1; i++)
+      nx[i+1] = sqrt(-2 * log(NV / nx[i] + exp(-0.5 * nx[i] * nx[i])));
+    nx[NN] = 0;
+    for (int i = 0; i <= NN; i++)
+      nf[i] = exp(-0.5 * nx[i] * nx[i]);
+    ex[0] = EV / exp(-ER);
+    ex[1] = ER;
+    for (int i = 1; i < EN - 1; i++)
+      ex[i+1] = -log(EV / ex[i] + exp(-ex[i]));
+    ex[EN] = 0;
+    for (int i = 0; i <= EN; i++)
+      ef[i] = exp(-ex[i]);
+  }
+};
+
+// tables are computed at first use (generators can be used by
+// constructors of global objects)
+const Ziggurat &Tables()
+{
+  static const Ziggurat z;
+  return z;
+}
+
+const double TWO_M53 = 1.0 / 9007199254740992.0;        // 2^-53
+
+// source of random bits for ziggurat: base generator
+struct BaseBits {
+  unsigned long long operator () () { return SIMLIB_RandomBits(); }
+};
+
+// uniform in range 0..0.99999 (the same as Random() for RandomStream)
+template <class Bits>
+inline double Uniform01(Bits &bits)
+{
+  return (bits() >> 11) * TWO_M53;
+}
+
+// uniform in range (0,1] --- argument of log()
+template <class Bits>
+inline double UniformPos(Bits &bits)
+{
+  return 1.0 - Uniform01(bits);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ZigNormal --- N(0,1), b = first random word
+//
+template <class Bits>
+double ZigNormal(unsigned long long b, Bits &bits, const Ziggurat &z)
+{
+  for (;; b = bits()) {
+    int i = int(b & (NN - 1));                          // 7 bits
+    double u = 2 * ((b >> 11) * TWO_M53) - 1;           // 53 bits
+    double x = u * z.nx[i];
+    if (fabs(x) < z.nx[i+1])                    // inside (usual case)
+      return x;
+    if (i == 0) {                               // tail
+      double a, c;
+      do {
+        a = -log(UniformPos(bits)) / NR;
+        c = -log(UniformPos(bits));
+      } while (2 * c < a * a);
+      return u < 0 ? -(NR + a) : NR + a;
+    }
+    if (z.nf[i] + Uniform01(bits) * (z.nf[i+1] - z.nf[i]) < exp(-0.5 * x * x))
+      return x;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ZigExponential --- exponential distribution with mean value 1,
+//                     b = first random word
+//
+template <class Bits>
+double ZigExponential(unsigned long long b, Bits &bits, const Ziggurat &z)
+{
+  double tail = 0;
+  for (;; b = bits()) {
+    int i = int(b & (EN - 1));                          // 8 bits
+    double x = (b >> 11) * TWO_M53 * z.ex[i];           // 53 bits
+    if (x < z.ex[i+1])
+      return tail + x;
+    if (i == 0)                                 // tail: memoryless
+      tail += ER;
+    else if (z.ef[i] + Uniform01(bits) * (z.ef[i+1] - z.ef[i]) < exp(-x))
+      return tail + x;
+  }
+}
+
+// uniform in range (0,1] --- argument of log()
+inline double RandomPos()
+{
+  return 1.0 - Random();
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  StdNormal --- N(0,1)
+//
+static double StdNormal()
+{
+  BaseBits bits;
+  return ZigNormal(bits(), bits, Tables());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  StdExponential --- exponential distribution with mean value 1
+//
+static double StdExponential()
+{
+  BaseBits bits;
+  return ZigExponential(bits(), bits, Tables());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  StdGamma --- gamma distribution with shape a, scale 1
+//
+static double StdGamma(double a)
+{
+  if (a < 1)                    // boost: G(a) = G(a+1) * U^(1/a)
+    return StdGamma(a + 1) * pow(RandomPos(), 1 / a);
+  const double d = a - 1.0 / 3;
+  const double c = 1 / sqrt(9 * d);
+  for (;;) {
+    double x, v;
+    do {
+      x = StdNormal();
+      v = 1 + c * x;
+    } while (v <= 0);
+    v = v * v * v;
+    double u = RandomPos();
+    double x2 = x * x;
+    if (u < 1 - 0.0331 * x2 * x2)               // squeeze
+      return d * v;
+    if (log(u) < 0.5 * x2 + d * (1 - v + log(v)))
+      return d * v;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Normal(mi,sigma)
+//  mi    = mean value
+//  sigma = standard deviation
+//
+double Normal(double mi, double sigma)
+{
+  return mi + sigma * StdNormal();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Exponential(mv)
+//
+double Exponential(double mv)
+{
+  return mv * StdExponential();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Gamma(alfa,beta)
+//  alfa = shape
+//  beta = scale
+//
+double Gamma(double alfa, double beta)
+{
+  if (alfa <= 0 || beta <= 0)  SIMLIB_error(GammaError);
+  return StdGamma(alfa) * beta;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Erlang(alfa,beta) --- sum of beta exponentials with mean value alfa
+//
+double Erlang(double alfa, int beta)
+{
+  if (beta<1)  SIMLIB_error(ErlangError);
+  if (beta == 1)
+    return alfa * StdExponential();
+  return alfa * StdGamma(beta);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Beta
+//
+double Beta(double th, double fi, double min, double max)
+{
+  if (th <= 0 || fi <= 0)  SIMLIB_error(GammaError);
+  double X = StdGamma(th);
+  X = X / (X + StdGamma(fi));
+  return X * (max - min) + min;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Logar --- log-normal distribution
+//
+double Logar(double mi, double delta)
+{
+  return exp(Normal(mi, delta));
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Poisson(lambda)
+//
+int Poisson(double lambda)
+{
+  if (lambda<=0) SIMLIB_error(PoissonError);
+  if (lambda < 10) {            // inversion (sequential search)
+    double p = exp(-lambda);
+    double u = Random();
+    int k = 0;
+    while (u > p && p > 0) {
+      u -= p;
+      ++k;
+      p *= lambda / k;
+    }
+    return k;
+  }
+  // PTRS
+  const double slam = sqrt(lambda);
+  const double loglam = log(lambda);
+  const double b = 0.931 + 2.53 * slam;
+  const double a = -0.059 + 0.02483 * b;
+  const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+  const double vr = 0.9277 - 3.6224 / (b - 2);
+  for (;;) {
+    double U = Random() - 0.5;
+    double V = Random();
+    double us = 0.5 - fabs(U);
+    double k = floor((2 * a / us + b) * U + lambda + 0.43);
+    if (us >= 0.07 && V <= vr)
+      return int(k);
+    if (k < 0 || (us < 0.013 && V > us))
+      continue;
+    if (log(V) + log(invalpha) - log(a / (us * us) + b) <=
+        -lambda + k * loglam - lgamma(k + 1))
+      return int(k);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  BinomInversion --- small n*p (p<=0.5)
+//
+static int BinomInversion(int n, double p)
+{
+  const double q = 1 - p;
+  const double qn = exp(n * log(q));
+  const double np = n * p;
+  const double bound = fmin(n, np + 10 * sqrt(np * q + 1));
+  int X = 0;
+  double px = qn;
+  double U = Random();
+  while (U > px) {
+    ++X;
+    if (X > bound) {            // numerical problem: restart
+      X = 0;
+      px = qn;
+      U = Random();
+    } else {
+      U -= px;
+      px = ((n - X + 1) * p * px) / (X * q);
+    }
+  }
+  return X;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  BinomBTPE --- large n*p (p<=0.5)
+//
+static int BinomBTPE(int n, double p)
+{
+  const double r = p;
+  const double q = 1 - r;
+  const double fm = n * r + r;
+  const double m = floor(fm);
+  const double p1 = floor(2.195 * sqrt(n * r * q) - 4.6 * q) + 0.5;
+  const double xm = m + 0.5;
+  const double xl = xm - p1;
+  const double xr = xm + p1;
+  const double c = 0.134 + 20.5 / (15.3 + m);
+  double a = (fm - xl) / (fm - xl * r);
+  const double laml = a * (1 + a / 2);
+  a = (xr - fm) / (xr * q);
+  const double lamr = a * (1 + a / 2);
+  const double p2 = p1 * (1 + 2 * c);
+  const double p3 = p2 + c / laml;
+  const double p4 = p3 + c / lamr;
+  const double nrq = n * r * q;
+  for (;;) {
+    double u = Random() * p4;
+    double v = Random();
+    double y;
+    if (u <= p1)                        // triangular region: accept
+      return int(floor(xm - p1 * v + u));
+    if (u <= p2) {                      // parallelograms
+      double x = xl + (u - p1) / c;
+      v = v * c + 1 - fabs(m - x + 0.5) / p1;
+      if (v > 1)
+        continue;
+      y = floor(x);
+    } else if (u <= p3) {               // left exponential tail
+      y = floor(xl + log(v) / laml);
+      if (y < 0 || v == 0)
+        continue;
+      v = v * (u - p2) * laml;
+    } else {                            // right exponential tail
+      y = floor(xr - log(v) / lamr);
+      if (y > n || v == 0)
+        continue;
+      v = v * (u - p3) * lamr;
+    }
+    double k = fabs(y - m);
+    if (k <= 20 || k >= nrq / 2 - 1) {  // explicit evaluation
+      double s = r / q;
+      double aa = s * (n + 1);
+      double F = 1;
+      if (m < y)
+        for (double i = m + 1; i <= y; i++)
+          F *= (aa / i - s);
+      else if (m > y)
+        for (double i = y + 1; i <= m; i++)
+          F /= (aa / i - s);
+      if (v > F)
+        continue;
+      return int(y);
+    }
+    // squeezing using upper and lower bounds on log(f(x))
+    double rho = (k / nrq) * ((k * (k / 3 + 0.625) + 0.16666666666666666) / nrq + 0.5);
+    double t = -k * k / (2 * nrq);
+    double A = log(v);
+    if (A < t - rho)
+      return int(y);
+    if (A > t + rho)
+      continue;
+    // final acceptance test (Stirling's formula)
+    double x1 = y + 1, f1 = m + 1, z = n + 1 - m, w = n - y + 1;
+    double x2 = x1 * x1, f2 = f1 * f1, z2 = z * z, w2 = w * w;
+    if (A > (xm * log(f1 / x1) + (n - m + 0.5) * log(z / w) +
+             (y - m) * log(w * r / (x1 * q)) +
+             (13680.-(462.-(132.-(99.-140./f2)/f2)/f2)/f2)/f1/166320. +
+             (13680.-(462.-(132.-(99.-140./z2)/z2)/z2)/z2)/z/166320. +
+             (13680.-(462.-(132.-(99.-140./x2)/x2)/x2)/x2)/x1/166320. +
+             (13680.-(462.-(132.-(99.-140./w2)/w2)/w2)/w2)/w/166320.))
+      continue;
+    return int(y);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Binom(n,p)
+//  n = number of experiments
+//  p = probability of success
+//
+int Binom(int n, double p)
+{
+  if (n < 0 || p < 0 || p > 1)  SIMLIB_error(BinomError);
+  if (n == 0 || p == 0)
+    return 0;
+  if (p == 1)
+    return n;
+  double r = (p <= 0.5) ? p : 1 - p;
+  int x = (n * r <= 30) ? BinomInversion(n, r) : BinomBTPE(n, r);
+  return (p <= 0.5) ? x : n - x;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  bulk generation
+//
+namespace {
+
+thread_local bool fill_exact = false;        // Fill* give the same numbers as scalar calls
+
+const unsigned long FILL_MIN = 64;      // shorter arrays: scalar calls
+const unsigned BLOCK = 256;             // numbers generated by one kernel call
+
+// state of 4 interleaved generators (structure of arrays: s[word][lane])
+struct Lanes {
+  unsigned long long s[4][4];
+};
+
+inline unsigned long long rotl(unsigned long long x, int k)
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+// uniform numbers l+w*u, u = 53 high bits of b[i] * 2^-53 as in Random()
+// (exact conversion in all variants, so the results are the same)
+void ToUniformGeneric(const unsigned long long *b, double *x, unsigned n,
+                      double l, double w)
+{
+  for (unsigned i = 0; i < n; i++)
+    x[i] = l + w * ((b[i] >> 11) * TWO_M53);
+}
+
+// portable kernel, n is multiple of 4
+void KernelGeneric(Lanes &L, unsigned long long *out, unsigned n)
+{
+  for (unsigned j = 0; j < n; j += 4)
+    for (int k = 0; k < 4; k++) {
+      unsigned long long *s0 = &L.s[0][k], *s1 = &L.s[1][k];
+      unsigned long long *s2 = &L.s[2][k], *s3 = &L.s[3][k];
+      out[j + k] = rotl(*s1 * 5, 7) * 9;
+      unsigned long long t = *s1 << 17;
+      *s2 ^= *s0; *s3 ^= *s1; *s1 ^= *s2; *s0 ^= *s3;
+      *s2 ^= t;
+      *s3 = rotl(*s3, 45);
+    }
+}
+
+#ifdef SIMLIB_SIMD_X86
+// multiplications by 5 and 9 are done by shift and add
+__attribute__((target("sse2")))
+void KernelSSE2(Lanes &L, unsigned long long *out, unsigned n)
+{
+  __m128i s[4][2];
+  for (int w = 0; w < 4; w++)
+    for (int h = 0; h < 2; h++)
+      s[w][h] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&L.s[w][2*h]));
+  for (unsigned j = 0; j < n; j += 4)
+    for (int h = 0; h < 2; h++) {
+      __m128i &s0 = s[0][h], &s1 = s[1][h], &s2 = s[2][h], &s3 = s[3][h];
+      __m128i x = _mm_add_epi64(s1, _mm_slli_epi64(s1, 2));            // *5
+      x = _mm_or_si128(_mm_slli_epi64(x, 7), _mm_srli_epi64(x, 57));
+      x = _mm_add_epi64(x, _mm_slli_epi64(x, 3));                       // *9
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j + 2*h), x);
+      __m128i t = _mm_slli_epi64(s1, 17);
+      s2 = _mm_xor_si128(s2, s0);
+      s3 = _mm_xor_si128(s3, s1);
+      s1 = _mm_xor_si128(s1, s2);
+      s0 = _mm_xor_si128(s0, s3);
+      s2 = _mm_xor_si128(s2, t);
+      s3 = _mm_or_si128(_mm_slli_epi64(s3, 45), _mm_srli_epi64(s3, 19));
+    }
+  for (int w = 0; w < 4; w++)
+    for (int h = 0; h < 2; h++)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&L.s[w][2*h]), s[w][h]);
+}
+
+// conversion: (y | exponent of 2^52) as double - 2^52 = y for y < 2^52,
+// b>>11 = 2*(b>>12) + bit 11 of b (exact, less than 2^53)
+__attribute__((target("sse2")))
+void ToUniformSSE2(const unsigned long long *b, double *x, unsigned n,
+                   double l, double w)
+{
+  const __m128i e = _mm_set1_epi64x(0x4330000000000000LL);
+  const __m128i bit = _mm_set1_epi64x(1);
+  const __m128d e52 = _mm_set1_pd(4503599627370496.0);
+  const __m128d scale = _mm_set1_pd(TWO_M53);
+  const __m128d vl = _mm_set1_pd(l), vw = _mm_set1_pd(w);
+  unsigned i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128d hi = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(v, 12), e));
+    __m128d lo = _mm_castsi128_pd(_mm_or_si128(
+                   _mm_and_si128(_mm_srli_epi64(v, 11), bit), e));
+    hi = _mm_sub_pd(hi, e52);
+    __m128d u = _mm_add_pd(_mm_add_pd(hi, hi), _mm_sub_pd(lo, e52));
+    u = _mm_mul_pd(u, scale);
+    _mm_storeu_pd(x + i, _mm_add_pd(vl, _mm_mul_pd(vw, u)));
+  }
+  ToUniformGeneric(b + i, x + i, n - i, l, w);
+}
+
+__attribute__((target("avx2")))
+void ToUniformAVX2(const unsigned long long *b, double *x, unsigned n,
+                   double l, double w)
+{
+  const __m256i e = _mm256_set1_epi64x(0x4330000000000000LL);
+  const __m256i bit = _mm256_set1_epi64x(1);
+  const __m256d e52 = _mm256_set1_pd(4503599627370496.0);
+  const __m256d scale = _mm256_set1_pd(TWO_M53);
+  const __m256d vl = _mm256_set1_pd(l), vw = _mm256_set1_pd(w);
+  unsigned i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256d hi = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 12), e));
+    __m256d lo = _mm256_castsi256_pd(_mm256_or_si256(
+                   _mm256_and_si256(_mm256_srli_epi64(v, 11), bit), e));
+    hi = _mm256_sub_pd(hi, e52);
+    __m256d u = _mm256_add_pd(_mm256_add_pd(hi, hi), _mm256_sub_pd(lo, e52));
+    u = _mm256_mul_pd(u, scale);
+    _mm256_storeu_pd(x + i, _mm256_add_pd(vl, _mm256_mul_pd(vw, u)));
+  }
+  ToUniformGeneric(b + i, x + i, n - i, l, w);
+}
+
+__attribute__((target("avx2")))
+void KernelAVX2(Lanes &L, unsigned long long *out, unsigned n)
+{
+  __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(L.s[0]));
+  __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(L.s[1]));
+  __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(L.s[2]));
+  __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(L.s[3]));
+  for (unsigned j = 0; j < n; j += 4) {
+    __m256i x = _mm256_add_epi64(s1, _mm256_slli_epi64(s1, 2));         // *5
+    x = _mm256_or_si256(_mm256_slli_epi64(x, 7), _mm256_srli_epi64(x, 57));
+    x = _mm256_add_epi64(x, _mm256_slli_epi64(x, 3));                   // *9
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j), x);
+    __m256i t = _mm256_slli_epi64(s1, 17);
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(L.s[0]), s0);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(L.s[1]), s1);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(L.s[2]), s2);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(L.s[3]), s3);
+}
+#endif
+
+struct Kernels {
+  void (*next)(Lanes &, unsigned long long *, unsigned);
+  void (*uniform)(const unsigned long long *, double *, unsigned, double, double);
+};
+
+// run-time selection of kernels
+Kernels SelectKernels()
+{
+  Kernels k = { KernelGeneric, ToUniformGeneric };
+#ifdef SIMLIB_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    k.next = KernelAVX2;
+    k.uniform = ToUniformAVX2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    k.next = KernelSSE2;
+    k.uniform = ToUniformSSE2;
+  }
+#endif
+  return k;
+}
+
+const Kernels &Selected()
+{
+  static const Kernels k = SelectKernels();
+  return k;
+}
+
+// buffered source of random bits for bulk generation
+class BulkBits {
+  Lanes L;
+  unsigned long long buf[BLOCK];
+  unsigned pos;
+  unsigned long long amask;     // antithetic mode of source stream
+ public:
+  const Kernels &kernel;
+  // lane k starts at state of s after k Jump()s (non-overlapping parts
+  // of the stream), s continues after 4 jumps; antithetic stream gives
+  // the same lanes and complemented results
+  explicit BulkBits(RandomStream &s) :
+    pos(BLOCK), amask(s.Antithetic() ? RandomStream::ANTI_MASK : 0),
+    kernel(Selected()) {
+    for (int lane = 0; lane < 4; lane++) {
+      for (int w = 0; w < 4; w++)
+        L.s[w][lane] = s.State(w);
+      s.Jump();
+    }
+  }
+  // next block of BLOCK numbers (buffer is not used by operator())
+  void Block(unsigned long long *out) {
+    kernel.next(L, out, BLOCK);
+    if (amask)
+      for (unsigned i = 0; i < BLOCK; i++)
+        out[i] ^= amask;
+  }
+  unsigned long long operator () () {
+    if (pos == BLOCK) {
+      Block(buf);
+      pos = 0;
+    }
+    return buf[pos++];
+  }
+};
+
+// stream for Fill* (0 = current stream)
+inline RandomStream &FillStream(RandomStream *s)
+{
+  return s ? *s : CurrentRandomStream();
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  SetFillExact --- Fill* give the same numbers as scalar generators
+//
+void SetFillExact(bool exact)
+{
+  fill_exact = exact;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  FillUniform --- n numbers of uniform distribution in range l..h
+//
+void FillUniform(double *x, unsigned long n, double l, double h,
+                 RandomStream *s)
+{
+  if( l >= h ) SIMLIB_error(BadUniformParam);
+  if (fill_exact || n < FILL_MIN) {
+    RandomStream *prev = SetRandomStream(&FillStream(s));
+    for (unsigned long i = 0; i < n; i++)
+      x[i] = Uniform(l, h);
+    SetRandomStream(prev);
+    return;
+  }
+  BulkBits bits(FillStream(s));
+  unsigned long long buf[BLOCK];
+  for (unsigned long i = 0; i < n; i += BLOCK) {
+    bits.Block(buf);
+    unsigned m = (n - i < BLOCK) ? unsigned(n - i) : BLOCK;
+    bits.kernel.uniform(buf, x + i, m, l, h - l);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  FillNormal --- n numbers of normal distribution
+//
+void FillNormal(double *x, unsigned long n, double mi, double sigma,
+                RandomStream *s)
+{
+  if (fill_exact || n < FILL_MIN) {
+    RandomStream *prev = SetRandomStream(&FillStream(s));
+    for (unsigned long i = 0; i < n; i++)
+      x[i] = Normal(mi, sigma);
+    SetRandomStream(prev);
+    return;
+  }
+  BulkBits bits(FillStream(s));
+  const Ziggurat &z = Tables();
+  for (unsigned long i = 0; i < n; i++) {
+    unsigned long long b = bits();
+    int k = int(b & (NN - 1));
+    double v = (2 * ((b >> 11) * TWO_M53) - 1) * z.nx[k];
+    if (fabs(v) >= z.nx[k+1])                   // rare case (<1.5%)
+      v = ZigNormal(b, bits, z);
+    x[i] = mi + sigma * v;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  FillExponential --- n numbers of exponential distribution
+//
+void FillExponential(double *x, unsigned long n, double mv, RandomStream *s)
+{
+  if (fill_exact || n < FILL_MIN) {
+    RandomStream *prev = SetRandomStream(&FillStream(s));
+    for (unsigned long i = 0; i < n; i++)
+      x[i] = Exponential(mv);
+    SetRandomStream(prev);
+    return;
+  }
+  BulkBits bits(FillStream(s));
+  const Ziggurat &z = Tables();
+  for (unsigned long i = 0; i < n; i++) {
+    unsigned long long b = bits();
+    int k = int(b & (EN - 1));
+    double v = (b >> 11) * TWO_M53 * z.ex[k];
+    if (v >= z.ex[k+1])                         // rare case (<1.5%)
+      v = ZigExponential(b, bits, z);
+    x[i] = mv * v;
+  }
+}
+
+} // end
+
@@ -0,0 +1,295 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file replicate.cc  Parallel replications of simulation experiment
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  SIMLIB_ParallelFor, RunReplications, ReplicationMerge implementation
+//
+//  Work stealing: indexes 0..n-1 are divided into contiguous ranges, one
+//  per worker thread. Worker takes indexes from the beginning of its own
+//  range; when it is empty, it steals upper half of the largest range of
+//  other workers. Ranges are protected by mutexes -- replications are
+//  long, so locking is not critical.
+//
+//  Replication i runs in worker thread with its own Simulator (all
+//  simulation state is thread-local). Results are kept in slot i and
+//  merged by the calling thread after all replications end, in order of
+//  index, so the results do not depend on number of threads.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+namespace {
+
+struct WorkRange {                      // indexes assigned to worker
+  std::mutex lock;
+  unsigned long lo, hi;                 // [lo,hi) not started yet
+};
+
+// Take --- next index of own range
+bool Take(WorkRange &r, unsigned long &i)
+{
+  std::lock_guard<std::mutex> g(r.lock);
+  if (r.lo == r.hi)
+    return false;
+  i = r.lo++;
+  return true;
+}
+
+// Steal --- move upper half of the largest range to range w[self]
+bool Steal(std::vector<WorkRange> &w, unsigned self, unsigned long &i)
+{
+  for (;;) {
+    unsigned victim = self;
+    unsigned long most = 0;
+    for (unsigned k = 0; k < w.size(); k++) {
+      if (k == self)
+        continue;
+      std::lock_guard<std::mutex> g(w[k].lock);
+      if (w[k].hi - w[k].lo > most) {
+        most = w[k].hi - w[k].lo;
+        victim = k;
+      }
+    }
+    if (most == 0)
+      return false;             // all work started
+    unsigned long lo, hi;
+    {
+      std::lock_guard<std::mutex> g(w[victim].lock);
+      unsigned long size = w[victim].hi - w[victim].lo;
+      if (size == 0)
+        continue;               // taken meanwhile, try again
+      hi = w[victim].hi;
+      lo = hi - (size + 1) / 2;
+      w[victim].hi = lo;
+    }
+    std::lock_guard<std::mutex> g(w[self].lock);
+    w[self].lo = lo + 1;
+    w[self].hi = hi;
+    i = lo;
+    return true;
+  }
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  SIMLIB_ParallelFor --- call f(i) for i=0..n-1 in worker threads
+//
+void SIMLIB_ParallelFor(unsigned long n, unsigned threads,
+                        const std::function<void(unsigned long)> &f)
+{
+  if (n == 0)
+    return;
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads == 0)
+    threads = 1;
+  if (threads > n)
+    threads = unsigned(n);
+  std::vector<WorkRange> w(threads);
+  for (unsigned k = 0; k < threads; k++) {      // contiguous ranges
+    w[k].lo = n * k / threads;
+    w[k].hi = n * (k + 1) / threads;
+  }
+  std::mutex error_lock;
+  std::exception_ptr error;
+  bool failed = false;
+  auto worker = [&](unsigned self) {
+    unsigned long i;
+    while (Take(w[self], i) || Steal(w, self, i)) {
+      {
+        std::lock_guard<std::mutex> g(error_lock);
+        if (failed)
+          return;               // skip the rest of work
+      }
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> g(error_lock);
+        if (!failed) {
+          error = std::current_exception();
+          failed = true;
+        }
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned k = 0; k < threads; k++)
+    pool.push_back(std::thread(worker, k));
+  for (unsigned k = 0; k < threads; k++)
+    pool[k].join();
+  if (error)
+    std::rethrow_exception(error);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  results of replications
+//
+namespace {
+
+struct Result {                 // recorded by ReplicationMerge
+  SimObject *target;
+  SimObject *result;            // owned, 0 for value
+  double value;
+  void (*merge)(Result &);
+};
+typedef std::vector<Result> ResultList;
+
+// results of replication running in this thread (0 = merge now)
+thread_local ResultList *results = 0;
+
+void MergeValue(Result &r)
+{
+  (*static_cast<Stat*>(r.target))(r.value);
+}
+
+// result objects (and statistics inside) are removed from registry
+void Unregister(Stat *s)  { SIMLIB_StatRegistry::Unregister(s); }
+void Unregister(TStat *s) { SIMLIB_StatRegistry::Unregister(s); }
+void Unregister(Histogram *h)
+{
+  SIMLIB_StatRegistry::Unregister(h);
+  SIMLIB_StatRegistry::Unregister(&h->stat);
+}
+void Unregister(LogHistogram *h)
+{
+  SIMLIB_StatRegistry::Unregister(h);
+  SIMLIB_StatRegistry::Unregister(&h->stat);
+}
+
+template <class T> void MergeObject(Result &r)
+{
+  static_cast<T*>(r.target)->Merge(*static_cast<T*>(r.result));
+  delete r.result;
+}
+
+void Record(SimObject *target, SimObject *result, double value,
+            void (*merge)(Result &))
+{
+  Result r = { target, result, value, merge };
+  if (results)
+    results->push_back(r);
+  else
+    merge(r);
+}
+
+template <class T> void RecordObject(T &target, T *result)
+{
+  if (result) {
+    if (!result->isAllocated())         // we delete it after merge
+      SIMLIB_error(ReplicationError);
+    Unregister(result);                 // not reset by ResetStatistics
+  }
+  Record(&target, result, 0, MergeObject<T>);
+}
+
+} // local namespace
+
+bool SIMLIB_StatDerived(const SimObject *o)
+{
+  return dynamic_cast<const QuantileStat*>(o) || dynamic_cast<const BatchMeans*>(o);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ReplicationMerge --- record result of replication
+//
+void ReplicationMerge(Stat &target, double x)
+{
+  Record(&target, 0, x, MergeValue);
+}
+
+void ReplicationMerge(Stat &target, Stat *result)
+{
+  if (SIMLIB_StatDerived(&target) || SIMLIB_StatDerived(result))
+    SIMLIB_error(ReplicationError);     // only base part would be merged
+  RecordObject(target, result);
+}
+
+void ReplicationMerge(TStat &target, TStat *result)
+{
+  RecordObject(target, result);
+}
+
+void ReplicationMerge(QuantileStat &target, QuantileStat *result)
+{
+  RecordObject(target, result);
+}
+
+void ReplicationMerge(Histogram &target, Histogram *result)
+{
+  RecordObject(target, result);
+}
+
+void ReplicationMerge(LogHistogram &target, LogHistogram *result)
+{
+  RecordObject(target, result);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  RunReplications --- run n independent replications in parallel
+//
+// random streams: i-th Split() of current stream, master seed of
+// ForComponent() streams is derived from the caller's one and i
+//
+void RunReplications(unsigned long n, unsigned threads,
+                     void (*fn)(unsigned long i))
+{
+  Dprintf(("RunReplications(%lu,%u)", n, threads));
+  if (fn == 0)
+    SIMLIB_error(ReplicationError);
+  std::vector<RandomStream> streams;
+  streams.reserve(n);
+  RandomStream base = CurrentRandomStream();
+  for (unsigned long i = 0; i < n; i++)
+    streams.push_back(base.Split());
+  const unsigned long long master = SIMLIB_RandomMasterSeed();
+  std::vector<ResultList> slots(n);
+  try {
+    SIMLIB_ParallelFor(n, threads, [&](unsigned long i) {
+      Simulator sim;            // frees data of replication at the end
+      SIMLIB_RandomReplica(master + 0x9e3779b97f4a7c15ULL * (i + 1), streams[i]);
+      results = &slots[i];
+      try {
+        fn(i);
+      } catch (...) {
+        results = 0;
+        throw;
+      }
+      results = 0;
+    });
+  } catch (...) {               // delete unmerged results
+    for (unsigned long i = 0; i < n; i++)
+      for (ResultList::iterator r = slots[i].begin(); r != slots[i].end(); ++r)
+        delete r->result;
+    throw;
+  }
+  for (unsigned long i = 0; i < n; i++)         // merge in fixed order
+    for (ResultList::iterator r = slots[i].begin(); r != slots[i].end(); ++r)
+      r->merge(*r);
+}
+
+} // namespace
+
@@ -18,6 +18,7 @@
 #include "simlib.h"
 #include "internal.h"
 #include <cstdlib> // exit()
+#include <exception> // uncaught_exceptions()
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -36,35 +37,24 @@ SIMLIB_IMPLEMENTATION;
 //
 
 
-// time-related variables
-double SIMLIB_StartTime;       // time of simulation start
-double SIMLIB_Time;            // simulation time
-double SIMLIB_NextTime;        // next-event time
-double SIMLIB_EndTime;         // time of simulation end
-
-// read-only references to time variables
+// time-related variables (read-only for models)
 // ASSERTION: StartTime <= Time <= NextTime <= EndTime
-const double & StartTime = SIMLIB_StartTime;    // time of simulation start
-const double & Time      = SIMLIB_Time;         // simulation time
-const double & NextTime  = SIMLIB_NextTime;     // next-event time
-const double & EndTime   = SIMLIB_EndTime;      // time of simulation end
+SIMLIB_CONSTINIT thread_local double StartTime = 0;   // time of simulation start
+SIMLIB_CONSTINIT thread_local double Time = 0;        // simulation time
+SIMLIB_CONSTINIT thread_local double NextTime = 0;    // next-event time
+SIMLIB_CONSTINIT thread_local double EndTime = 0;     // time of simulation end
 
 // current entity pointer
-Entity *SIMLIB_Current = NULL;
-Entity *const &Current = SIMLIB_Current;        // read-only reference
+SIMLIB_CONSTINIT thread_local Entity *Current = NULL;
 
 // phase of simulation experiment
-SIMLIB_Phase_t SIMLIB_Phase = START;
-const SIMLIB_Phase_t & Phase = SIMLIB_Phase;    // read-only reference
+SIMLIB_CONSTINIT thread_local SIMLIB_Phase_t SIMLIB_Phase = START;
 
 // experiment counter
-unsigned long SIMLIB_experiment_no = 0;
+thread_local unsigned long SIMLIB_experiment_no = 0;
 
 ////////////////////////////////////////////////////////////////////////////
 /// internal statistical information
-SIMLIB_statistics_t::SIMLIB_statistics_t() {
-    Init();
-}
 void SIMLIB_statistics_t::Init() {
     StepCount = 0;
     MinStep = -1;
@@ -74,13 +64,12 @@ void SIMLIB_statistics_t::Init() {
     EndTime = -1;
 }
 
-static SIMLIB_statistics_t SIMLIB_run_statistics;
-const SIMLIB_statistics_t &SIMLIB_statistics = SIMLIB_run_statistics;
+SIMLIB_CONSTINIT thread_local SIMLIB_statistics_t SIMLIB_statistics;
 
 ////////////////////////////////////////////////////////////////////////////
 // private module variables
 
-static bool StopFlag = false;           // if set, stop simulation run
+static thread_local bool StopFlag = false;           // if set, stop simulation run
 
 ////////////////////////////////////////////////////////////////////////////
 // support for Delay blocks (internal)
@@ -105,6 +94,12 @@ void InstallBreak(void (*f)()) { // for user interface (in simlib.h)
     INSTALL_HOOK( Break, f );
 }
 
+////////////////////////////////////////////////////////////////////////////
+// support for checkpoints (internal)
+//
+DEFINE_HOOK(Checkpoint);        // called in Run() after each event
+SIMLIB_CONSTINIT thread_local bool SIMLIB_Restored = false; // state set by RestoreEventCheckpoint()
+
 ////////////////////////////////////////////////////////////////////////////
 // support for Samplers (internal)
 //
@@ -130,15 +125,21 @@ void SIMLIB_WUClear() // should be removed -- ise CALL_HOOK instead
 DEFINE_HOOK(WUget_next);
 ////////////////////////////////////////////////////////////////////////////
 // SIMLIB_DoActions --- central calling of interruptable procedures
-// WARNING: SIMLIB_Current->_Run() should be called from this place only!
+// WARNING: Current->_Run() should be called from this place only!
 //
 void SIMLIB_DoActions()
 {
   do {
-    SIMLIB_Current->_Run(); // perform event-dispatch
-    SIMLIB_Current = 0;
+    RandomStream *rs = Current->_RandomStream; // entity can be deleted
+    if (rs) {
+      RandomStream *prev = SetRandomStream(rs);
+      Current->_Run(); // perform event-dispatch
+      SetRandomStream(prev);
+    } else
+      Current->_Run(); // perform event-dispatch
+    Current = 0;
     CALL_HOOK(WUget_next);  // check and activate next in WUlist
-  }while( SIMLIB_Current != 0 );
+  }while( Current != 0 );
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -190,6 +191,7 @@ void SIMLIB_Init(double T0, double T1, unsigned version)
   if( SIMLIB_Phase == INITIALIZATION ) SIMLIB_error(TwiceInitError);
   if( SIMLIB_Phase == SIMULATION ) SIMLIB_error(InitInRunError);
   SIMLIB_Phase = INITIALIZATION;
+  SIMLIB_Restored = false;
   /////////////////////////////////////////////////////////////////
   if( T0 < SIMLIB_MINTIME ) SIMLIB_error(InitError);
   if( T1 > SIMLIB_MAXTIME ) SIMLIB_error(InitError);
@@ -222,6 +224,33 @@ void SIMLIB_Init(double T0, double T1, unsigned version)
 }
 
 
+////////////////////////////////////////////////////////////////////////////
+// Simulator --- context of current thread
+//
+static thread_local Simulator *SIMLIB_Simulator = 0;
+
+Simulator::Simulator()
+{
+  Dprintf(("Simulator::Simulator()"));
+  if( SIMLIB_Simulator ) SIMLIB_error(SimulatorError);
+  SIMLIB_Simulator = this;
+}
+
+Simulator::~Simulator()
+{
+  Dprintf(("Simulator::~Simulator()"));
+  if( SIMLIB_Phase == SIMULATION && !std::uncaught_exceptions() )
+    SIMLIB_error(SimulatorError);
+  SIMLIB_atexit_call();         // free calendar etc. of this thread
+  SIMLIB_Phase = START;
+  SIMLIB_Simulator = 0;
+}
+
+Simulator *Simulator::Current()
+{
+  return SIMLIB_Simulator;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Run --- main simulation control
 //
@@ -240,14 +269,18 @@ void Run() {
   SIMLIB_Phase = SIMULATION;
   StopFlag = false;               // flag for stop simulation
 
-  SIMLIB_run_statistics.Init();       // initialize internal statistics
-  SIMLIB_run_statistics.StartTime = Time;
+  SIMLIB_statistics.Init();       // initialize internal statistics
+  SIMLIB_statistics.StartTime = Time;
 
   // call init functions
-  SIMLIB_ContinueInit();          // initialize status variables 2 ###
-
-  CALL_HOOK(ZDelayTimerInit);     // activate all ZDelayTimers
-  CALL_HOOK(SamplerAct);          // activate all Samplers
+  if( SIMLIB_Restored ) {         // state restored from checkpoint
+      SIMLIB_Restored = false;
+      SIMLIB_ContinueRestore();
+  } else {
+      SIMLIB_ContinueInit();      // initialize status variables 2 ###
+      CALL_HOOK(ZDelayTimerInit); // activate all ZDelayTimers
+      CALL_HOOK(SamplerAct);      // activate all Samplers
+  }
   CALL_HOOK(Break);               // user can stop simulation by any key?
 
 // TODO: try using special lowest priority end-event to stop simulation
@@ -270,14 +303,14 @@ void Run() {
                                            // until scheduled event or end ...
                   IntegrationMethod::StepSim(); // *** continuous step ***
 
-                  SIMLIB_run_statistics.StepCount++; // some runtime statistics
-                  if(SIMLIB_run_statistics.MinStep<0) {
-                      SIMLIB_run_statistics.MinStep = StepSize;
-                      SIMLIB_run_statistics.MaxStep = StepSize;
-                  } else if(SIMLIB_run_statistics.MinStep>StepSize)
-                      SIMLIB_run_statistics.MinStep = StepSize;
-                  else if(SIMLIB_run_statistics.MaxStep<StepSize)
-                      SIMLIB_run_statistics.MaxStep = StepSize;
+                  SIMLIB_statistics.StepCount++; // some runtime statistics
+                  if(SIMLIB_statistics.MinStep<0) {
+                      SIMLIB_statistics.MinStep = StepSize;
+                      SIMLIB_statistics.MaxStep = StepSize;
+                  } else if(SIMLIB_statistics.MinStep>StepSize)
+                      SIMLIB_statistics.MinStep = StepSize;
+                  else if(SIMLIB_statistics.MaxStep<StepSize)
+                      SIMLIB_statistics.MaxStep = StepSize;
 
                   SIMLIB_DoConditions();   // perform state events
                   CALL_HOOK(Delay);        // DELAY: sample input at each step
@@ -301,17 +334,19 @@ void Run() {
       while( Time >= NextTime && !StopFlag && !SQS::Empty() ) {
           // there are events scheduled at current Time
           // >= because of rounding errors
-          SIMLIB_Current = SQS::GetFirst(); // get first record from calendar
+          Current = SQS::GetFirst(); // get first record from calendar
           SIMLIB_DoActions();  // perform actions (see waitunti.cc)
-          SIMLIB_run_statistics.EventCount++;   // internal statistics
-          // assert: SIMLIB_Current is NULL
+          SIMLIB_statistics.EventCount++;   // internal statistics
+          // assert: Current is NULL
+          CALL_HOOK(Checkpoint); // save requested by SaveEventCheckpoint()
           CALL_HOOK(Break); // Callback: user can stop simulation by key or GUI
         }
   } // main loop
+  CALL_HOOK(Checkpoint);                // save requested at end of run
   IntegrationMethod::IntegrationDone(); // terminate integration run
   SQS::Clear();                         // terminate all scheduled events/processes
   SIMLIB_Phase = TERMINATION;
-  SIMLIB_run_statistics.EndTime = Time;
+  SIMLIB_statistics.EndTime = Time;
   Dprintf(("\n\t ********** Run() --- END \n"));
 }
 
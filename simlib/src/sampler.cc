@@ -31,7 +31,7 @@ namespace simlib3 {
 SIMLIB_IMPLEMENTATION;
 
 // init
-Sampler *Sampler::First = 0;
+SIMLIB_CONSTINIT thread_local Sampler *Sampler::First = 0;
 
 ////////////////////////////////////////////////////////////////////////////
 // constructor
@@ -8,7 +8,8 @@
 
 //
 //  class Semaphore implementation
-//  TODO: correct too simple semantics, add capacity=1 default
+//  counting semaphore: P(k) waits until k units are available,
+//  V(k) returns k units and releases all satisfied requests at once
 //  it is like Store, but without statistics (different queue sort order?)
 //
 
@@ -30,17 +31,26 @@ SIMLIB_IMPLEMENTATION;
 ////////////////////////////////////////////////////////////////////////////
 //  constructors
 //
-Semaphore::Semaphore()
+Semaphore::Semaphore() :
+  n(1), n0(1), maxn(1)
 {
   Dprintf(("Semaphore::Semaphore()"));
-  n = 1;
 }
 
-Semaphore::Semaphore(const char *name)
+Semaphore::Semaphore(const char *name) :
+  n(1), n0(1), maxn(1)
 {
   Dprintf(("Semaphore::Semaphore(\"%s\")",name));
   SetName(name);
-  n = 1;
+}
+
+Semaphore::Semaphore(const char *name, int initial, int limit) :
+  n(initial), n0(initial), maxn(limit)
+{
+  Dprintf(("Semaphore::Semaphore(\"%s\",%d,%d)",name,initial,limit));
+  SetName(name);
+  if(initial < 0 || limit < 0 || (limit > 0 && initial > limit))
+    SIMLIB_error(SemaphoreError);
 }
 
 
@@ -58,7 +68,7 @@ Semaphore::~Semaphore()
 //
 void Semaphore::Clear() {
   Dprintf(("%s.Clear()", Name().c_str()));
-  n = 1;
+  n = n0;
   Q.Clear(); // queue initialization ###!!!
 }
 
@@ -72,31 +82,45 @@ void Semaphore::Output() const {
 
 
 ////////////////////////////////////////////////////////////////////////////
+//  P --- wait for k units
+//  units are assigned by V() before the waiting process is activated
+//  (V() removes it from Q), process activated otherwise waits again
+//  at its original position in Q
 //
-//
-void Semaphore::P()
+void Semaphore::P(unsigned k)
 {
-  Dprintf(("Semaphore'%s'.P()", Name().c_str()));
-
-  while(n == 0) {
-    Q.Insert(Current);  // Current==this
-    Passivate(Current);
-    Q.Get(Current);
+  Dprintf(("Semaphore'%s'.P(%u)", Name().c_str(), k));
+  if(maxn > 0 && k > unsigned(maxn))
+    SIMLIB_error(SemaphoreError);       // can not be satisfied
+  if(Q.empty() && unsigned(n) >= k) {   // FIFO order
+    n -= k;             // no waiting
+    return;
   }
-  n--;
-}
+  Current->_RequiredCapacity = k;
+  Q.Wait(Current);      // Current==this
+  while(Current->Where() == &Q)         // activated by other event:
+    Current->Passivate();               // not satisfied, keeps its place
+}                       // activated by V(), units assigned
 
 ////////////////////////////////////////////////////////////////////////////
+//  V --- return k units, activate all satisfied entities at once
 //
-//
-void Semaphore::V()
+void Semaphore::V(unsigned k)
 {
-  Dprintf(("%s.V()", Name().c_str()));
-  if(n>=1)
+  Dprintf(("%s.V(%u)", Name().c_str(), k));
+  if(maxn > 0 && n + k > unsigned(maxn))
     SIMLIB_error(SemaphoreError);
-  n++;
-  Entity *p = Q.front(); // first entity in queue
-  if(p) p->Activate();
+  n += k;
+  unsigned count = 0;   // number of satisfied requests
+  for(WaitQueue::iterator p = Q.begin(); p != Q.end(); ++p) {
+    Entity *e = static_cast<Entity*>(*p);
+    if(e->_RequiredCapacity > unsigned(n))
+      break;            // no overtaking
+    n -= e->_RequiredCapacity;
+    ++count;
+  }
+  if(count)
+    Q.Release(count);
 }
 
 }
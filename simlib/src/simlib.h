@@ -51,7 +51,11 @@
 // includes
 #include <cstdlib>      // size_t
 #include <list>         // std::list<>
+#include <initializer_list> // ForkReplications()
 #include <string>       // std::string
+#include <functional>   // CheckpointClass()
+#include <type_traits>  // CheckpointData::Value()
+#include <typeinfo>     // CheckpointClass()
 
 // /////////////////////////////////////////////////////////////////////////
 //! \namespace simlib3  Main SIMLIB (version 3+) namespace.
@@ -90,6 +94,16 @@ const char *SIMLIB_version_string();    // get SIMLIB version string
 # error  "SIMLIB is not implemented for this system/compiler"
 #endif
 
+// constant initialization of thread-local variables: access from other
+// modules needs no call of TLS wrapper (initialization) function
+#if defined(__cpp_constinit)
+# define SIMLIB_CONSTINIT constinit
+#elif defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 10
+# define SIMLIB_CONSTINIT __constinit
+#else
+# define SIMLIB_CONSTINIT
+#endif
+
 ////////////////////////////////////////////////////////////////////////////
 // DEBUGGING: print debug info ON/OFF/mode
 //
@@ -149,28 +163,30 @@ const double SIMLIB_MAXTIME = 1.0e30; //!< maximum time (1e30 works for float, t
 
 ////////////////////////////////////////////////////////////////////////////
 // CATEGORY: global variables
-// Warning: NOT THREAD-SAFE! --- TODO: change to methods of SimulationContext
+// all simulation state is thread-local: each thread runs its own
+// independent simulator (see class Simulator)
+// the variables are set by simulator only -- read-only for models
 
-extern Entity *const &Current;    //!< pointer to active (now running) entity
+SIMLIB_CONSTINIT extern thread_local Entity *Current;  //!< pointer to active (now running) entity
 
 // time values:
-extern const double & StartTime;       //!< time of simulation start
-extern const double & NextTime;        //!< next-event time
-extern const double & EndTime;         //!< time of simulation end
+SIMLIB_CONSTINIT extern thread_local double StartTime; //!< time of simulation start
+SIMLIB_CONSTINIT extern thread_local double NextTime;  //!< next-event time
+SIMLIB_CONSTINIT extern thread_local double EndTime;   //!< time of simulation end
 
 // WARNING: Time cannot be used in block expressions!
-extern const double & Time;            //!< model time (is NOT the block)
+SIMLIB_CONSTINIT extern thread_local double Time;      //!< model time (is NOT the block)
 extern aContiBlock  & T;               //!< model time (continuous block)
 
-// read-only step limits of numerical integration method
-extern const double &MinStep;     //!< minimal step size
-extern const double &StepSize;    //!< current step size
-extern const double &OptStep;     //!< optimal step size
-extern const double &MaxStep;     //!< maximal step size
+// step limits of numerical integration method (use SetStep)
+SIMLIB_CONSTINIT extern thread_local double MinStep;   //!< minimal step size
+SIMLIB_CONSTINIT extern thread_local double StepSize;  //!< current step size
+SIMLIB_CONSTINIT extern thread_local double OptStep;   //!< optimal step size
+SIMLIB_CONSTINIT extern thread_local double MaxStep;   //!< maximal step size
 
-// error params for numerical integration methods
-extern const double &AbsoluteError; //!< max absolute error
-extern const double &RelativeError; //!< max relative error
+// error params for numerical integration methods (use SetAccuracy)
+SIMLIB_CONSTINIT extern thread_local double AbsoluteError; //!< max absolute error
+SIMLIB_CONSTINIT extern thread_local double RelativeError; //!< max relative error
 
 ////////////////////////////////////////////////////////////////////////////
 // CATEGORY: global functions ...
@@ -204,10 +220,29 @@ void SetAccuracy(double abserr, double relerr);
 //! @param relerr  tolerance relative to integrator value
 void SetAccuracy(double relerr);
 
+////////////////////////////////////////////////////////////////////////////
+//! simulator context of current thread
+//! Simulation state (time, calendar, lists of blocks, processes, random
+//! streams, ...) is thread-local, so each thread has one independent
+//! simulator, the main thread uses it implicitly. Simulator object marks
+//! the context of a thread, destructor frees its internal data (calendar,
+//! WaitUntil list, ...). Model objects must not be shared between threads.
+//! \ingroup simlib
+class Simulator {
+  Simulator(const Simulator&) = delete;
+  Simulator &operator=(const Simulator&) = delete;
+ public:
+  Simulator();                  //!< bind to current thread (at most one)
+  ~Simulator();                 //!< free data of this thread's simulator
+  static Simulator *Current();  //!< simulator of current thread or 0
+};
+
 //! run simulation experiment
 void Run();
 //! stop current simulation run
 void Stop();
+//! stop each run when all BatchMeans with target precision reach it
+void SetPrecisionStop(bool on);
 //! end simulation program
 void Abort();
 
@@ -248,11 +283,69 @@ void ContractStep(double time);
 ////////////////////////////////////////////////////////////////////////////
 // CATEGORY: pseudorandom number generators
 
-//! initialize random number seed
+////////////////////////////////////////////////////////////////////////////
+//! independent stream of pseudorandom numbers
+//! xoshiro256** generator (period 2^256-1), the state is initialized
+//! from 64bit seed by splitmix64. Jump() skips 2^128 numbers, so streams
+//! created by successive Split() calls do not overlap.
+//! Common random numbers: ForComponent(name) gives the same stream for
+//! the same model component in all compared scenarios.
+//! Antithetic mode complements all bits of Next() except the lowest 8
+//! (used as ziggurat layer index), so Random() gives 1-U and Normal()
+//! gives -x of the original stream (rejection methods keep the pairing
+//! until the first rejection).
+//! \ingroup simlib
+class RandomStream {
+  unsigned long long s[4];      // generator state
+  unsigned long long amask;     // antithetic mode: ANTI_MASK, else 0
+  static unsigned long long rotl(unsigned long long x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+  void jump(const unsigned long long *poly);
+ public:
+  explicit RandomStream(unsigned long long seed);
+  //! state given directly (must not be all zeros)
+  constexpr RandomStream(unsigned long long s0, unsigned long long s1,
+                         unsigned long long s2, unsigned long long s3) :
+    s{s0, s1, s2, s3}, amask(0) {}
+  //! stream of model component given by name, seed is computed from
+  //! name and the last RandomSeed() value
+  static RandomStream ForComponent(const char *name);
+  void Seed(unsigned long long seed);   //!< initialize state
+  //! bits complemented in antithetic mode
+  static constexpr unsigned long long ANTI_MASK = ~0xFFULL;
+  //! switch antithetic mode on/off
+  void SetAntithetic(bool on) { amask = on ? ANTI_MASK : 0; }
+  bool Antithetic() const { return amask != 0; }
+  //! next 64bit number
+  unsigned long long Next() {
+    unsigned long long r = rotl(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return r ^ amask;
+  }
+  //! uniform distribution in range 0-0.999999... (53 bits)
+  double Random() { return (Next() >> 11) * (1.0 / 9007199254740992.0); }
+  void Jump();                          //!< skip 2^128 numbers
+  void LongJump();                      //!< skip 2^192 numbers
+  RandomStream Split();                 //!< copy of stream, then Jump()
+  //! word i of generator state (i=0..3)
+  unsigned long long State(int i) const { return s[i]; }
+};
+
+//! select stream used by Random() and RandomSeed() (0 = default stream)
+//! @returns previous stream
+RandomStream *SetRandomStream(RandomStream *s);
+//! stream currently used by Random()
+RandomStream &CurrentRandomStream();
+
+//! initialize random number seed (of current stream)
 //! @param seed initial value of generator state
 void   RandomSeed(long seed);
 //! base uniform generator (range 0-0.999999...)
-//! the default implementation is simple LCG 32bit
+//! the default implementation uses current RandomStream
 double Random();
 //! set another random generator
 //! default Random() implementation can be replaced
@@ -260,13 +353,19 @@ double Random();
 void   SetBaseRandomGenerator(double (*new_gen)());
 
 // following generators depend on Random()
+// Normal, Exponential, Gamma, Erlang, Beta, Poisson and Binom use fast exact
+// methods (ziggurat, Marsaglia-Tsang, PTRS, BTPE), original generators
+// are available in namespace legacy
 //! Beta distribution generator @param th @param fi @param min @param max
 double Beta(double th, double fi, double min, double max);
+//! Binomial distribution generator
+//! @param n number of experiments @param p probability of success
+int    Binom(int n, double p);
 //! Erlang distribution generator @param alfa @param beta
 double Erlang(double alfa, int beta);
 //! Exponential distribution generator @param mv mean value
 double Exponential(double mv);
-//! Gamma distribution generator @param alfa @param beta
+//! Gamma distribution generator @param alfa shape @param beta scale
 double Gamma(double alfa, double beta);
 
 int    Geom(double q);
@@ -286,6 +385,34 @@ double Uniform(double l, double h);
 //! Weibul distribution generator @param lambda @param alfa
 double Weibul(double lambda, double alfa);
 
+// bulk generation into array x[0..n-1], stream s (0 = current stream)
+// fast mode uses SIMD and 4 lanes: states of s after 0..3 Jump() (s is
+// moved by 4 jumps), uniform numbers have 53 bits as Random();
+// exact mode gives the same numbers as n calls of Uniform/Normal/...
+//! fill array by uniform distribution @param l low limit @param h high limit
+void FillUniform(double *x, unsigned long n, double l=0, double h=1,
+                 RandomStream *s=0);
+//! fill array by normal distribution
+//! @param mi mean value @param sigma std. deviation
+void FillNormal(double *x, unsigned long n, double mi=0, double sigma=1,
+                RandomStream *s=0);
+//! fill array by exponential distribution @param mv mean value
+void FillExponential(double *x, unsigned long n, double mv=1,
+                     RandomStream *s=0);
+//! exact mode of FillUniform etc. (slower scalar generation)
+void SetFillExact(bool exact);
+
+//! original generators of SIMLIB 3.08 (for reproducibility of results)
+namespace legacy {
+double Beta(double th, double fi, double min, double max);
+double Erlang(double alfa, int beta);
+double Exponential(double mv);
+double Gamma(double alfa, double beta);
+double Logar(double mi, double delta);
+double Normal(double mi, double sigma);
+int    Poisson(double lambda);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 // CATEGORY: basics
@@ -374,7 +501,7 @@ struct EventNotice;     // we use only pointer to this class here
 //! \ingroup simlib
 class Entity : public Link {
   protected:
-    static unsigned long _Number;   //!< current number of entities
+    SIMLIB_CONSTINIT static thread_local unsigned long _Number;   //!< current number of entities
     unsigned long _Ident;           //!< unique identification number of entity
     ////////////////////////////////////////////////////////////////////////////
     // TODO: next attributes will be changed/removed:
@@ -384,14 +511,20 @@ class Entity : public Link {
     double _MarkTime;               // beginning of waiting in queue ###!!!
     // Facility and Store use these data
     friend class Facility;
+    friend class PreemptiveFacility;
     friend class Store;
+    friend class Semaphore;
+    friend struct SIMLIB_Checkpoint;    // save/restore (checkpoint.cc)
     // TODO: this should be stored in queues at Facility/Store
     union {
         double _RemainingTime; // rest of time of interrupted service (Facility) ###
-        unsigned long _RequiredCapacity; // required store capacity of Store
+        unsigned long _RequiredCapacity; // required store capacity of Store/Semaphore
     };
     ServicePriority_t _SPrio;           //!< priority of service in Facility
+    Facility *_Discarded;               //!< service discarded by (preempt.h)
+    Facility *_Interrupted;             //!< waits for resumption in (preempt.h)
     ////////////////////////////////////////////////////////////////////////////
+    RandomStream *_RandomStream;        //!< stream used by Behavior() or 0
   public:
     unsigned long id() const { return _Ident; }
     typedef EntityPriority_t Priority_t;
@@ -413,6 +546,9 @@ class Entity : public Link {
     void Cancel() { Terminate(); }      //!< end Behavior() and remove entity
 //    virtual void Into(Queue *q);         // insert itself into queue
     virtual void Out() override;        //!< remove entity from queue
+    //! Random() uses stream s during Behavior() (0 = no change)
+    void BindRandomStream(RandomStream *s) { _RandomStream = s; }
+    RandomStream *BoundRandomStream() const { return _RandomStream; }
 
   private:
     // Simulation control algorithm interface:
@@ -451,6 +587,7 @@ class Process : public Entity {
   bool isTerminated() const { return (_status==_TERMINATED);  } // zombie
 
   friend class WaitUntilList;
+  friend struct SIMLIB_Checkpoint;      // only prepared process is saved
   bool _wait_until;                     // waiting for condition
   void _WaitUntilRemove();
 
@@ -504,8 +641,9 @@ class Event : public Entity {
 //!  (typicaly used for output of continuous model)
 //! \ingroup simlib
 class Sampler: public Event {
-    static Sampler *First;              // list of objects TODO: use container
+    SIMLIB_CONSTINIT static thread_local Sampler *First;              // list of objects TODO: use container
     Sampler *Next;                      // next object
+    friend struct SIMLIB_Checkpoint;    // save/restore (checkpoint.cc)
   protected:
     void (*function)(); //!< function to call periodically
     double last;        //!< last sample time -- prevents sample duplication
@@ -557,51 +695,246 @@ class aStat : public SimObject {
 };
 #endif
 
+////////////////////////////////////////////////////////////////////////////
+//! level of statistics collected by Queue, Facility and Store
+//! \ingroup simlib
+enum StatisticsLevel_t {
+  STAT_NONE = 0,        //!< no statistics (fastest)
+  STAT_COUNTERS = 1,    //!< number of requests only (Number() is valid)
+  STAT_FULL = 2         //!< all statistics (default)
+};
+//! set default statistics level for new Queue, Facility and Store objects
+void SetStatisticsLevel(StatisticsLevel_t level);
+//! get default statistics level
+StatisticsLevel_t StatisticsLevel();
+//! clear all statistics objects (Stat, TStat, Histogram, LogHistogram
+//! including statistics of Queue, Facility and Store), model state is kept
+void ResetStatistics();
+//! call ResetStatistics() at time t of current run (end of warm-up)
+void ResetStatisticsAt(double t);
+
+////////////////////////////////////////////////////////////////////////////
+//! link of statistics object in registry of ResetStatistics() (internal)
+//! The object is linked into the list of the thread which constructed it,
+//! unlink is O(1).
+struct SIMLIB_StatLink {
+  SIMLIB_StatLink *prev, *next; // neighbours in list (0 = not registered)
+  SimObject *obj;               // registered object
+  void (*reset)(SimObject *);   // clear function for its type
+  SIMLIB_StatLink() : prev(0), next(0), obj(0), reset(0) {}
+};
+
 ////////////////////////////////////////////////////////////////////////////
 //! class for statistical information gathering
 //! \ingroup simlib
 class Stat : public SimObject {
  protected:
-  double sx;                    // sum of values
-  double sx2;                   // sum of value square
+  double mean;                  // mean value (Welford)
+  double m2;                    // sum of squared deviations from mean
   double min;                   // min value
   double max;                   // max value
   unsigned long n;              // number of values recorded
+  SIMLIB_StatLink _reg;         // registry of ResetStatistics()
+  friend struct SIMLIB_StatCount; // counters only statistics
+  friend struct SIMLIB_Snapshot; // binary copy (ForkReplications)
+  friend struct SIMLIB_StatRegistry; // ResetStatistics()
  public:
   Stat();
   explicit Stat(const char *name);
   ~Stat();
   virtual void Clear();         //!< initialize
-  void operator () (double x);  //!< record the value
+  virtual void operator () (double x);  //!< record the value
 // Stat &operator = (Stat &x);  // TODO: copy semantics
-// Stat &operator += (Stat &x); // sum two statistics + template operator +
+  //! add all records of x (exact, O(1)), moments only: use Merge of
+  //! derived class (QuantileStat) to merge its data
+  void Merge(const Stat &x);
+  Stat &operator += (const Stat &x) { Merge(x); return *this; }
   virtual void Output() const override;  //!< print statistics
   unsigned long Number() const { return n; }
   double Min() const           { /* TODO: test n==0 */ return min; }
   double Max() const           { /* test n==0 */ return max; }
-  double Sum() const           { return sx; }
-  double SumSquare() const     { return sx2; }
+  double Sum() const           { return mean*n; }
+  double SumSquare() const     { return m2 + mean*mean*n; }
   double MeanValue() const;
   double StdDev() const;
 };
 
+////////////////////////////////////////////////////////////////////////////
+//! statistics with quantile estimates (percentiles)
+//! Values are summarized by merging t-digest: at most about
+//! `compression` centroids are kept (bounded memory), the error is lowest
+//! for extreme quantiles (p1, p99). Digests of replications can be merged.
+//! \ingroup simlib
+class QuantileStat : public Stat {
+ public:
+  struct Centroid { double mean, weight; };   //!< cluster of values
+ protected:
+  double delta;                 // compression parameter
+  unsigned cap;                 // capacity of centroid array
+  unsigned bufcap;              // capacity of buffer
+  mutable Centroid *c;          // centroids sorted by mean
+  mutable unsigned nc;          // number of centroids
+  mutable Centroid *buf;        // values not merged into centroids yet
+  mutable unsigned nb;          // number of buffered values
+  mutable Centroid *tmp;        // work space for Compress()
+  void Init();                  // allocate arrays
+  void Add(double x, double w); // add value x with weight w
+  void Compress() const;        // merge buffer into centroids
+ public:
+  explicit QuantileStat(double compression=100);
+  QuantileStat(const char *name, double compression=100);
+  ~QuantileStat();
+  virtual void Clear() override;        //!< initialize
+  virtual void operator () (double x) override; //!< record the value
+  void Merge(const QuantileStat &x);    //!< add all records of x
+  QuantileStat &operator += (const QuantileStat &x) { Merge(x); return *this; }
+  virtual void Output() const override; //!< print statistics and quantiles
+  double Compression() const { return delta; }
+  unsigned Centroids() const { Compress(); return nc; }
+  double Quantile(double q) const;      //!< estimate of q-quantile, 0<=q<=1
+  double Median() const { return Quantile(0.5); }
+};
+
+////////////////////////////////////////////////////////////////////////////
+//! batch means: steady-state mean with confidence interval
+//! Observations are grouped into non-overlapping batches. When there are
+//! 2*batches complete batches, adjacent ones are merged and the batch size
+//! is doubled (constant memory). HalfWidth() of the confidence interval
+//! is computed from batch means using Student's t distribution.
+//! With SetTarget() the statistic takes part in run-length control
+//! (see SetPrecisionStop()).
+//! \ingroup simlib
+class BatchMeans : public Stat {
+ protected:
+  double *bm;                   // means of complete batches
+  unsigned nbm;                 // number of complete batches
+  unsigned maxb;                // number of batches after merge
+  unsigned long bsize;          // current batch size
+  unsigned long bn;             // number of values in current batch
+  double bsum;                  // sum of values in current batch
+  double level;                 // confidence level
+  double relprec;               // target relative precision (0 = none)
+  BatchMeans *next;             // list of objects with target
+  void Init();                  // check parameters, allocate
+  void Batch();                 // close current batch
+ public:
+  explicit BatchMeans(unsigned batches=20, double level=0.95);
+  BatchMeans(const char *name, unsigned batches=20, double level=0.95);
+  ~BatchMeans();
+  virtual void Clear() override;        //!< initialize
+  virtual void operator () (double x) override; //!< record the value
+  virtual void Output() const override; //!< print statistics
+  unsigned Batches() const { return nbm; }       //!< complete batches
+  unsigned long BatchSize() const { return bsize; }
+  double BatchMean(unsigned i) const;   //!< mean of i-th batch
+  double GrandMean() const;             //!< mean of complete batches
+  double Level() const { return level; }
+  double HalfWidth() const;             //!< half-width of conf. interval
+  //! target relative precision HalfWidth/|GrandMean| (0 = no target)
+  void SetTarget(double relative_precision);
+  double Target() const { return relprec; }
+  bool Precise() const;                 //!< target precision reached
+};
+
+////////////////////////////////////////////////////////////////////////////
+//! detection of initial transient (warm-up period) by MSER-5 rule
+//! Recorded values of output series are averaged in batches of 5 and
+//! the truncation point minimizing the marginal standard error of the
+//! remaining batch means is found. Batches are merged (batch size doubled)
+//! when the buffer is full, so memory is constant.
+//! \ingroup simlib
+class WarmupDetector : public SimObject {
+ protected:
+  double *z;                    // batch means
+  double *te;                   // end time of each batch
+  unsigned nz;                  // number of complete batches
+  unsigned maxz;                // capacity of arrays
+  unsigned long bsize;          // current batch size
+  unsigned long bn;             // values in current batch
+  double bsum;                  // sum of current batch
+  double t0;                    // start time of first batch
+  unsigned Truncate() const;    // MSER truncation batch index
+  void Init();                  // allocate
+ public:
+  explicit WarmupDetector(unsigned capacity=1000);
+  WarmupDetector(const char *name, unsigned capacity=1000);
+  ~WarmupDetector();
+  void Clear();                         //!< initialize
+  void operator () (double x);          //!< record value of series
+  virtual void Output() const override; //!< print result
+  unsigned Batches() const { return nz; }
+  unsigned long BatchSize() const { return bsize; }
+  bool Detected() const;                //!< truncation in first half
+  unsigned long Truncation() const;     //!< number of values to delete
+  double WarmupTime() const;            //!< time of truncation point
+};
+
+
+////////////////////////////////////////////////////////////////////////////
+//! time series of time dependent statistic (TStat) in fixed time windows
+//! Time-weighted mean, min and max of the value are accumulated for each
+//! window of given width into preallocated ring buffer (O(1) per update).
+//! Complete windows are written to output file as lines "start mean min max"
+//! when the buffer is full or by Flush(). Without output file the buffer
+//! keeps the last complete windows.
+//! \ingroup simlib
+class TStatRecorder : public SimObject {
+ public:
+  //! statistics of single time window
+  struct Window { double start, mean, min, max; };
+ protected:
+  Window *ring;                 // buffer of complete windows
+  unsigned capacity;            // size of buffer
+  unsigned head;                // oldest window in buffer
+  unsigned count;               // number of windows in buffer
+  void *file;                   // output file (FILE*) or 0
+  double width;                 // window width
+  double t0;                    // start of first window
+  unsigned long k;              // index of current window
+  double ts;                    // start of part of window not written yet
+  double sum;                   // integral of value in current window
+  double wmin, wmax;            // min, max in current window
+  double tl, xl;                // last update time and value
+  void Close();                 // close current window
+ public:
+  explicit TStatRecorder(double width, unsigned capacity=1024);
+  TStatRecorder(const char *name, double width, unsigned capacity=1024);
+  ~TStatRecorder();
+  void SetOutput(const char *filename); //!< output file for windows
+  void Start(double t, double x);       //!< start recording at time t
+  void Update(double t, double x);      //!< value changed to x at time t
+  //! write complete windows, partial: also the current one up to Time
+  //! (the rest of it is written later as a window starting at Time)
+  void Flush(bool partial=false);
+  double Width() const { return width; }
+  unsigned Count() const { return count; }  //!< windows in buffer
+  const Window &operator[](unsigned i) const; //!< i-th window (0=oldest)
+  virtual void Output() const override;     //!< print buffered windows
+};
 
 ////////////////////////////////////////////////////////////////////////////
 //! time dependent statistic
 //! \ingroup simlib
 class TStat : public SimObject {
  protected:
-  double sxt;                   // sum of x*time
-  double sx2t;                  // sum of squares
+  double wt;                    // total time of recorded periods (weight)
+  double mean;                  // time-weighted mean of recorded periods
+  double m2;                    // time-weighted sum of squared deviations
   double min;                   // min value x
   double max;                   // max value x
   double t0;                    // time of initialization
   double tl;                    // last record time
   double xl;                    // last recorded value x
   unsigned long n;              // number of records
+  TStatRecorder *rec;           // time series recorder (optional)
+  SIMLIB_StatLink _reg;         // registry of ResetStatistics()
   friend class Facility; // needs to correct n -- TODO: remove
   friend class Store;
   friend class Queue;
+  friend struct SIMLIB_StatCount; // counters only statistics
+  friend struct SIMLIB_Snapshot; // binary copy (ForkReplications)
+  friend struct SIMLIB_StatRegistry; // ResetStatistics()
+  void Add(double x, double dt); // add period dt with value x
  public:
   explicit TStat(double initval=0.0);
   explicit TStat(const char *name, double initval=0.0);
@@ -609,11 +942,16 @@ class TStat : public SimObject {
   virtual void Clear(double initval=0.0);        //!< initialize
   virtual void Output() const override;          //!< print object to default output
   virtual void operator () (double x);           //!< record the value
+  void SetRecorder(TStatRecorder *r);            //!< attach time series recorder
+  TStatRecorder *Recorder() const { return rec; }
+  void Merge(const TStat &x);    //!< add recorded periods of x (exact, O(1))
+  TStat &operator += (const TStat &x) { Merge(x); return *this; }
   unsigned long Number() const { return n; }
   double Min() const           { /*TODO: only if(n>0)*/ return min; }
   double Max() const           { return max; }
-  double Sum() const           { return sxt; }
-  double SumSquare() const     { return sx2t; }
+  double Weight() const        { return wt; }  //!< time of recorded periods
+  double Sum() const           { return mean*wt; }      //!< sum of x*time
+  double SumSquare() const     { return m2 + mean*mean*wt; } //!< sum of x*x*time
   double StartTime() const     { return t0; }
   double LastTime() const      { return tl; }
   double LastValue() const     { return xl; }
@@ -686,6 +1024,8 @@ class Queue : public List { // don't inherit interface for now
 //TODO:remove
     friend class Facility;
     friend class Store;
+    unsigned char _StatLevel;           // level of statistics
+    QuantileStat *_WaitQuantiles;       // quantiles of waiting time (optional)
   public:
     typedef List::iterator iterator;
     TStat StatN;
@@ -696,6 +1036,12 @@ class Queue : public List { // don't inherit interface for now
     //virtual const char *Name() const;
     virtual void Output() const override;         //!< print statistics
     operator Queue* () { return this; }  // allows Queue instead Queue*
+    //! change statistics level, statistics are cleared if it differs
+    void SetStatisticsLevel(StatisticsLevel_t level);
+    StatisticsLevel_t StatisticsLevel() const { return StatisticsLevel_t(_StatLevel); }
+    //! record waiting time also into q (0 = none), q is not owned by queue
+    void SetWaitQuantiles(QuantileStat *q) { _WaitQuantiles = q; }
+    QuantileStat *WaitQuantiles() const { return _WaitQuantiles; }
     iterator begin()   { return List::begin(); }
     iterator end()     { return List::end(); }
     Entity *front()    { return static_cast<Entity*>(List::front()); }
@@ -727,6 +1073,9 @@ class Histogram : public SimObject {
   double   low;              // low bound
   double   step;             // interval width
   unsigned count;            // number of intervals
+  SIMLIB_StatLink _reg;      // registry of ResetStatistics()
+  friend struct SIMLIB_Snapshot; // binary copy (ForkReplications)
+  friend struct SIMLIB_StatRegistry; // ResetStatistics()
  public:
   Stat     stat;             // statistics
   Histogram();
@@ -736,6 +1085,7 @@ class Histogram : public SimObject {
   virtual void Output() const override;         //!< print to default output
   void Init(double low, double step, unsigned count);
   void operator () (double x);         // record value x
+  void Merge(const Histogram &h);      // add counts of h (same intervals)
   virtual void Clear();                // initialize (zero) value array
   double Low() const     { return low; }
   double High() const    { return low + step*count; }
@@ -744,6 +1094,120 @@ class Histogram : public SimObject {
   unsigned operator [](unsigned i) const;  // # of items in interval[i]
 };
 
+////////////////////////////////////////////////////////////////////////////
+//! log-linear (HDR) histogram
+//! Covers values from `unit` up to 2^63*unit with relative precision
+//! given by number of significant decimal digits. Bins have equal width
+//! inside each power of 2 range, bin index is computed by shifts only.
+//! Auto-ranging: the bin array grows when a larger value is recorded
+//! (unless the highest value is given).
+//! \ingroup simlib
+class LogHistogram : public SimObject {
+ protected:
+  unsigned long *counts;     // bin counters
+  unsigned len;              // number of bins
+  double unit;               // smallest distinguished value
+  double rate;               // 1/unit
+  double highest;            // fixed highest value (0 = auto-ranging)
+  unsigned digits;           // significant decimal digits
+  unsigned halfmag;          // log2(half of subbuckets)
+  unsigned long total;       // number of values in bins
+  unsigned long under;       // values < 0
+  unsigned long over;        // values over highest value
+  SIMLIB_StatLink _reg;      // registry of ResetStatistics()
+  friend struct SIMLIB_StatRegistry; // ResetStatistics()
+  unsigned Index(unsigned long long v) const;   // bin of scaled value
+  unsigned long long BinLow(unsigned i) const;  // scaled low bound of bin
+  void Init();               // check parameters, allocate bins
+  void Resize(unsigned n);   // change number of bins
+ public:
+  Stat     stat;             // statistics
+  LogHistogram(double unit, unsigned digits=2, double highest=0);
+  LogHistogram(const char *_name, double unit, unsigned digits=2,
+               double highest=0);
+  ~LogHistogram();
+  virtual void Output() const override;         //!< print non-empty bins
+  void operator () (double x);                  //!< record value x
+  void Merge(const LogHistogram &h);            //!< add counts of h
+  virtual void Clear();                         //!< zero all bins
+  double Quantile(double q) const;              //!< q-quantile estimate
+  double Unit() const         { return unit; }
+  unsigned Digits() const     { return digits; }
+  unsigned Count() const      { return len; }   //!< current number of bins
+  unsigned long Under() const { return under; }
+  unsigned long Over() const  { return over; }
+  double Low(unsigned i) const;                 //!< low bound of bin i
+  double High(unsigned i) const;                //!< high bound of bin i
+  unsigned long operator [](unsigned i) const;  //!< # of items in bin i
+};
+
+
+////////////////////////////////////////////////////////////////////////////
+//! empirical discrete distribution (Walker/Vose alias method)
+//! one Random() per draw, O(1) time
+//! data: values with weights, observed samples (weights = counts) or
+//! file with lines "value weight" or "value" (samples), # = comment
+//! \ingroup simlib
+class EmpiricalDiscrete : public SimObject {
+ protected:
+  double *val;               // values
+  double *prob;              // probability of values (normalized)
+  double *cut;               // alias table: threshold of own value
+  unsigned *alias;           // alias table: other value
+  unsigned n;                // number of values
+  void Build();              // create alias table from prob
+  void Free();
+ public:
+  EmpiricalDiscrete();                          //!< empty, use Set/Read
+  EmpiricalDiscrete(const double *values, const double *weights, unsigned n);
+  EmpiricalDiscrete(const double *samples, unsigned n);
+  explicit EmpiricalDiscrete(const char *filename);
+  ~EmpiricalDiscrete();
+  //! values with weights (sorted, weights of equal values are added)
+  void Set(const double *values, const double *weights, unsigned n);
+  void SetSamples(const double *samples, unsigned n);
+  void Read(const char *filename);              //!< load data from file
+  double operator () ();                        //!< draw (current stream)
+  double Sample(RandomStream &s);               //!< draw from stream s
+  unsigned Count() const { return n; }          //!< number of distinct values
+  double Value(unsigned i) const;               //!< i-th value (sorted)
+  double Probability(unsigned i) const;         //!< probability of i-th value
+  virtual void Output() const override;
+};
+
+////////////////////////////////////////////////////////////////////////////
+//! empirical continuous distribution (piecewise-linear inverse CDF)
+//! grid index over u = 0..1 gives O(1) expected time per draw
+//! data: CDF table (x, F(x)), observed samples (linear interpolation of
+//! empirical CDF) or file with lines "x F(x)" or "x" (samples)
+//! \ingroup simlib
+class EmpiricalContinuous : public SimObject {
+ protected:
+  double *x;                 // points of CDF (increasing)
+  double *F;                 // F(x) (nondecreasing, 0..1)
+  unsigned n;                // number of points
+  unsigned *grid;            // grid[j]: segment containing u=j/m
+  unsigned m;                // grid size
+  void Build();              // check data, create grid
+  void Free();
+ public:
+  EmpiricalContinuous();                        //!< empty, use Set/Read
+  EmpiricalContinuous(const double *x, const double *F, unsigned n);
+  EmpiricalContinuous(const double *samples, unsigned n);
+  explicit EmpiricalContinuous(const char *filename);
+  ~EmpiricalContinuous();
+  void Set(const double *x, const double *F, unsigned n);
+  void SetSamples(const double *samples, unsigned n);
+  void Read(const char *filename);              //!< load data from file
+  double operator () ();                        //!< draw (current stream)
+  double Sample(RandomStream &s);               //!< draw from stream s
+  double Quantile(double u) const;              //!< inverse CDF
+  unsigned Count() const { return n; }          //!< number of points
+  double Low() const;                           //!< minimal value
+  double High() const;                          //!< maximal value
+  virtual void Output() const override;
+};
+
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -753,10 +1217,12 @@ class Histogram : public SimObject {
 class Facility : public SimObject {
   unsigned char _Qflag;         //!< true if facility is owner of input queue
  protected:
+  unsigned char _StatLevel;  //!< level of statistics
   Entity *in;                //!< Entity currently in service
   Queue  *Q1;                //!< Input queue
   Queue  *Q2;                //!< Interrupted requests queue
   TStat tstat;               //!< usage statistics
+  friend struct SIMLIB_Checkpoint; // save/restore (checkpoint.cc)
  public:
   Facility();                   // for arrays only, TODO: FacilityArray
   explicit Facility(const char *_name);
@@ -770,6 +1236,10 @@ class Facility : public SimObject {
   bool Busy() const { return in!=nullptr; }     //!< in service
   Entity * In() const { return in; }            //!< current entity or nullptr
   unsigned QueueLen() const { return Q1->size(); }
+  //! change statistics level, statistics are cleared if it differs
+  void SetStatisticsLevel(StatisticsLevel_t level);
+  StatisticsLevel_t StatisticsLevel() const { return StatisticsLevel_t(_StatLevel); }
+  void SetRecorder(TStatRecorder *r) { tstat.SetRecorder(r); } //!< usage time series
   virtual void Seize(Entity *e, ServicePriority_t sp=DEFAULT_PRIORITY);
   virtual void Release(Entity *e);
   virtual void QueueIn(Entity *e, ServicePriority_t sp); // go into queue Q1
@@ -785,10 +1255,12 @@ class Facility : public SimObject {
 class Store : public SimObject {
   unsigned char _Qflag;         //!< true if store is owner of input queue
  protected:
+  unsigned char _StatLevel;     //!< level of statistics
   unsigned long capacity;       //!< Capacity of store
   unsigned long used;           //!< Currently used capacity
   Queue *Q;                     //!< input queue
   TStat tstat;                  //!< usage statistics
+  friend struct SIMLIB_Checkpoint; // save/restore (checkpoint.cc)
  public:
   Store();
   explicit Store(unsigned long _capacity);
@@ -807,6 +1279,10 @@ class Store : public SimObject {
   bool Empty() const  { return Used() == 0; }           //!< store is empty
   bool OwnQueue() const;
   unsigned QueueLen() const { return Q->size(); }
+  //! change statistics level, statistics are cleared if it differs
+  void SetStatisticsLevel(StatisticsLevel_t level);
+  StatisticsLevel_t StatisticsLevel() const { return StatisticsLevel_t(_StatLevel); }
+  void SetRecorder(TStatRecorder *r) { tstat.SetRecorder(r); } //!< usage time series
   virtual void Enter(Entity *e, unsigned long rcap);    //!< allocate capacity
   virtual void Leave(unsigned long rcap);               //!< deallocate capacity
   virtual void QueueIn(Entity *e, unsigned long c);     //!< insert entity into queue
@@ -985,7 +1461,7 @@ class aContiBlock3 : public aContiBlock {
 //TODO: move to implementation header
 class IntegratorContainer {
 private:
-  static std::list<Integrator*> * ListPtr;  // list of integrators
+  SIMLIB_CONSTINIT static thread_local std::list<Integrator*> * ListPtr;  // list of integrators
   IntegratorContainer();  // forbid constructor
   static std::list<Integrator*> * Instance(void);  // return list (& create)
 public:
@@ -1020,7 +1496,7 @@ public:
 //TODO: move to implementation header
 class StatusContainer {
 private:
-  static std::list<Status*>* ListPtr;  // list of integrators
+  SIMLIB_CONSTINIT static thread_local std::list<Status*>* ListPtr;  // list of integrators
   StatusContainer();  // forbid constructor
   static std::list<Status*>* Instance(void);  // return list (& create)
 public:
@@ -1059,8 +1535,9 @@ class IntegrationMethod {
     IntegrationMethod(const IntegrationMethod&) = delete;
     IntegrationMethod&operator=(const IntegrationMethod&) = delete;
 private:
-  static IntegrationMethod* CurrentMethodPtr;  // method used at present
-  static std::list<IntegrationMethod*>* MthLstPtr; // list of registrated methods
+  SIMLIB_CONSTINIT static thread_local IntegrationMethod* CurrentMethodPtr;  // method used at present (0=default)
+  static IntegrationMethod* CurrentMethod(void);  // method used, creates methods
+  SIMLIB_CONSTINIT static thread_local std::list<IntegrationMethod*>* MthLstPtr; // list of registrated methods
   std::list<IntegrationMethod*>::iterator ItList;  // position in the list
   const char* method_name;  // C-string --- the name of the method
 protected:  //## repair
@@ -1069,14 +1546,14 @@ protected:  //## repair
 private:   //## repair
   size_t PrevINum;  // # of integrators in previous step
   std::list<Memory*> MList;  // list of auxiliary memories
-  static std::list<Memory*> * PtrMList;  // pointer to list being filled
+  SIMLIB_CONSTINIT static thread_local std::list<Memory*> * PtrMList;  // pointer to list being filled
   IntegrationMethod();  // forbid implicit constructor
   IntegrationMethod(IntegrationMethod&);  // forbid implicit copy-constructor
   static bool Prepare(void);  // prepare system for integration step
   static void Iterate(void);  // compute new values of state blocks
   static void Summarize(void);  // set up new state after integration
 protected:
-  static bool IsEndStepEvent; // flag - will be event at the end of the step?
+  SIMLIB_CONSTINIT static thread_local bool IsEndStepEvent; // flag - will be event at the end of the step?
   typedef IntegratorContainer::iterator Iterator;  // iterator of intg. list
   static Iterator FirstIntegrator(void) {  // it. to first integrator in list
     return IntegratorContainer::Begin();
@@ -1119,11 +1596,11 @@ public:
   virtual void Resize(size_t size);  // resize all memories to given size
   static void StepSim(void);  // single step of numerical integration method
   static void IntegrationDone(void) {  // terminate integration
-    CurrentMethodPtr->TurnOff();  // suspend present method
+    CurrentMethod()->TurnOff();  // suspend present method
   }
   static void SetMethod(const char* name);  // set method which will be used
   static const char* GetMethod(void) {  // get name of method which is used
-    return CurrentMethodPtr->method_name;
+    return CurrentMethod()->method_name;
   }
   // auxiliary functions (interface) for user to add own method
   static void InitStep(double step_frag); // initialize step
@@ -1188,7 +1665,7 @@ private:
   StatusMethod(const StatusMethod&) = delete;
   size_t PrevStatusNum;  // # of status variables in previous step
   std::list<Memory*> StatusMList;  // list of auxiliary memories
-  static std::list<Memory*>* PtrStatusMList;  // pointer to list being filled
+  SIMLIB_CONSTINIT static thread_local std::list<Memory*>* PtrStatusMList;  // pointer to list being filled
 protected:
   typedef StatusContainer::iterator StatusIterator;  // iterator of intg. list
   static StatusIterator FirstStatus(void) {  // it. to first status in list
@@ -1482,7 +1959,7 @@ class Function2 : public aContiBlock2 {
 //! changes its boolean value
 //! \ingroup simlib
 class aCondition : public aBlock {
-  static aCondition *First;            // list of all state conditions
+  SIMLIB_CONSTINIT static thread_local aCondition *First;            // list of all state conditions
   aCondition *Next;                    // next condition in list
   void operator= (const aCondition&) = delete;
   aCondition(const aCondition&) = delete;
@@ -1750,22 +2227,208 @@ std::string GetName(SimObject *o);
 void InstallBreak(void (*f)());
 
 
+////////////////////////////////////////////////////////////////////////////
+//! RunReplications --- run n independent replications in parallel
+//! fn(i) performs i-th replication: it creates the model (objects local
+//! to fn or allocated by new, global model objects can not be used),
+//! calls Init() and Run() and passes results to ReplicationMerge().
+//! Each replication runs in worker thread with its own Simulator, its
+//! default random stream is i-th Split() of the caller's current stream
+//! and ForComponent() streams depend on i, too. The streams are the same
+//! for each call with the same seed (common random numbers for compared
+//! variants). Replications are distributed over threads by work stealing.
+//! @param n        number of replications
+//! @param threads  number of worker threads (0 = number of CPUs)
+//! @param fn       replication function
+//! \ingroup simlib
+void RunReplications(unsigned long n, unsigned threads,
+                     void (*fn)(unsigned long i));
+
+//! record result of replication, results are merged into target objects
+//! after all replications in order of replication index (the same
+//! result for any number of threads). Result objects must be allocated
+//! by new, they are deleted after merging. Outside of RunReplications()
+//! the result is merged immediately. QuantileStat must be merged by its
+//! overload, QuantileStat or BatchMeans passed as Stat is an error (its
+//! data would be lost).
+//! \ingroup simlib
+void ReplicationMerge(Stat &target, double x);  //!< record value x
+void ReplicationMerge(Stat &target, Stat *result);
+void ReplicationMerge(TStat &target, TStat *result);
+void ReplicationMerge(QuantileStat &target, QuantileStat *result);
+void ReplicationMerge(Histogram &target, Histogram *result);
+void ReplicationMerge(LogHistogram &target, LogHistogram *result);
+
+////////////////////////////////////////////////////////////////////////////
+//! ForkReplications --- run n replications in child processes (POSIX)
+//! The model is prepared by the caller (Init(), global objects, data),
+//! each replication is a child process created by fork() from this state
+//! (copy-on-write), so global objects can be used. fn(i) usually calls
+//! Run(); the default random stream and ForComponent() streams are set
+//! as in RunReplications(), other streams must be reseeded by fn.
+//! Result objects (Stat, TStat, Histogram; QuantileStat, BatchMeans and
+//! LogHistogram are not supported) are cleared in each child before fn(i)
+//! and their final data is copied to shared memory; the caller merges
+//! them into its objects in order of replication index. Other objects of the caller are not
+//! changed, the next experiment can be started by Init().
+//! Use in single-threaded program only.
+//! @param n        number of replications
+//! @param workers  max. number of processes at once (0 = number of CPUs)
+//! @param fn       replication function
+//! @param results  statistics objects merged from all replications
+//! \ingroup simlib
+void ForkReplications(unsigned long n, unsigned workers,
+                      void (*fn)(unsigned long i),
+                      std::initializer_list<SimObject*> results);
+
+////////////////////////////////////////////////////////////////////////////
+//! Branch --- clone running simulation into k branches (POSIX)
+//! Called at branching time (e.g. by Behavior() of event scheduled at the
+//! end of common history). Branches 1..k-1 are child processes created
+//! by fork() (copy-on-write), all branches continue the same simulation
+//! with the same random streams (common random numbers) and after Run()
+//! the rest of main(). fn(b) is called in branch b (0 = calling process)
+//! to apply the parameter change of scenario b; it should redirect the
+//! output (SetOutput) to avoid mixing of branches.
+//! @param k   number of branches (including the calling one)
+//! @param fn  scenario setting function (can be 0)
+//! @returns   number of branch (0..k-1)
+//! \ingroup simlib
+unsigned Branch(unsigned k, void (*fn)(unsigned b));
+//! number of current branch (0 in original process)
+unsigned BranchNumber();
+//! wait for end of branch processes created by this process
+//! (called at exit automatically)
+//! @returns number of branches which failed
+unsigned WaitBranches();
+
+
+////////////////////////////////////////////////////////////////////////////
+//! data of checkpoint record
+//! Serializer function is called for both saving and restoring, it must
+//! pass the same values in the same order to Value() or Data().
+//! \ingroup simlib
+class CheckpointData {
+  std::string &buf;             // contents of checkpoint file
+  size_t pos;                   // read position
+  bool saving;                  // writing
+  friend struct SIMLIB_Checkpoint;
+  CheckpointData(std::string &b, bool save) : buf(b), pos(0), saving(save) {}
+ public:
+  bool Saving() const { return saving; }        //!< checkpoint is written
+  void Data(void *p, size_t n);                 //!< write/read n bytes at p
+  //! write/read value x (plain data without pointers)
+  template <class T> void Value(T &x) {
+    static_assert(std::is_trivially_copyable<T>::value &&
+                  !std::is_pointer<T>::value,
+                  "CheckpointData::Value: plain data required");
+    Data(&x, sizeof(T));
+  }
+  void Value(std::string &s);                   //!< write/read string
+};
+
+//! serializer of user data (global variables of model)
+typedef void (*CheckpointFunction)(CheckpointData &d);
+
+////////////////////////////////////////////////////////////////////////////
+//! CheckpointRegister --- register model object for event-only checkpoint
+//! The model is created by program as usual (objects, Init()), then
+//! RestoreEventCheckpoint() sets the state of registered objects. Key
+//! identifies object in checkpoint file (unique, the same in program
+//! which restores it). Entities in calendar and queues are saved if
+//! registered or if their class is registered (CheckpointClass).
+//! Facility and Store with own queue save the queue, too.
+//! \ingroup simlib
+void CheckpointRegister(const char *key, CheckpointFunction f);
+void CheckpointRegister(const char *key, Entity &e);
+void CheckpointRegister(const char *key, Queue &q);
+void CheckpointRegister(const char *key, Facility &f);
+void CheckpointRegister(const char *key, Store &s);
+void CheckpointRegister(const char *key, Stat &s);
+void CheckpointRegister(const char *key, TStat &s);
+void CheckpointRegister(const char *key, Histogram &h);
+void CheckpointRegister(const char *key, RandomStream &s);
+void CheckpointRegister(const char *key, Integrator &i);
+//! remove all registrations (objects, classes)
+void CheckpointClear();
+
+// internal: use CheckpointClass()
+void SIMLIB_CheckpointClass(const std::type_info &t, const char *name,
+                            Entity *(*create)(),
+                            std::function<void(CheckpointData &, Entity &)> data);
+
+//! CheckpointClass --- register class of dynamic entities (default
+//! constructor is used by restore, data is serializer of attributes)
+//! \ingroup simlib
+template <class T>
+void CheckpointClass(const char *name, void (*data)(CheckpointData &, T &) = 0)
+{
+  std::function<void(CheckpointData &, Entity &)> f;
+  if (data)
+    f = [data](CheckpointData &d, Entity &e) { data(d, static_cast<T &>(e)); };
+  SIMLIB_CheckpointClass(typeid(T), name, []() -> Entity * { return new T; }, f);
+}
+
+//! SaveEventCheckpoint --- write event-only checkpoint of simulation
+//! Saves time, calendar, registered objects, Samplers, default random
+//! stream and integration step. Called during Run() (e.g. by Behavior())
+//! the file is written after end of current event, between Init() and
+//! Run() immediately. Event-only: the calendar and queues may contain
+//! Events and prepared (not started) Processes only, the stack of started
+//! process can not be restored (error).
+//! \ingroup simlib
+void SaveEventCheckpoint(const char *filename);
+//! RestoreEventCheckpoint --- set state of model from event-only
+//! checkpoint (after Init(), before Run()), Run() continues the saved
+//! run exactly
+//! \ingroup simlib
+void RestoreEventCheckpoint(const char *filename);
+
+
+////////////////////////////////////////////////////////////////////////////
+//! queue of passive entities waiting for synchronization
+//! (shared by Barrier and Semaphore)
+//! Entities are linked directly (no allocation), ordered by priority
+//! and FIFO. All entities released by one call are scheduled at current
+//! time by single calendar operation.
+//! \ingroup simlib
+class WaitQueue : public List {
+ public:
+  WaitQueue();
+  explicit WaitQueue(const char *_name);
+  ~WaitQueue();                         // list destructor clears content
+  typedef List::iterator iterator;
+  iterator begin()   { return List::begin(); }
+  iterator end()     { return List::end(); }
+  Entity *front()    { return static_cast<Entity*>(List::front()); }
+  void Insert(Entity *e);               //!< priority insert
+  void Wait(Entity *e);                 //!< insert and passivate entity
+  unsigned Release(unsigned k);         //!< activate first k entities now
+  unsigned ReleaseAll() { return Release(size()); } //!< activate all now
+  void Clear() { clear(); }             //!< initialization
+  virtual void Output() const override; //!< print waiting entities
+};
+
 ////////////////////////////////////////////////////////////////////////////
 //! basic synchronization tool for processes
-//! simplified implementation
+//! counting semaphore, binary by default
 //! \ingroup simlib
 class Semaphore : public SimObject {
   protected:
-  int n;
+  int n;                //!< current value
+  int n0;               //!< initial value (for Clear)
+  int maxn;             //!< maximal value (0 = no limit)
  public:
-  Queue Q;                                      //!< internal quqeue
-  Semaphore();                                  // constructor
+  WaitQueue Q;                                  //!< internal queue
+  Semaphore();                                  // constructor (binary)
   explicit Semaphore(const char *_name);        // with associated name
+  Semaphore(const char *_name, int initial, int limit = 0); // counting
   virtual ~Semaphore();
   void Clear();                                 //!< initialization
   virtual void Output() const override;
-  virtual void P();                             //!< P operation
-  virtual void V();                             //!< V operation
+  int Value() const { return n; }               //!< current value
+  virtual void P(unsigned k = 1);               //!< P operation (wait for k)
+  virtual void V(unsigned k = 1);               //!< V operation (add k)
 //  operator Semaphore* () { return this; }
 };
 
@@ -1775,8 +2438,7 @@ class Semaphore : public SimObject {
 //! \ingroup simlib
 class Barrier : public SimObject {
  protected:
-  Entity **waiting;     //!< array of waiting entities (fixed size)
-  unsigned n;           //!< current number of waiting entities
+  WaitQueue waiting;    //!< waiting entities
   unsigned maxn;        //!< barrier height/size
   void Init();          //!< initialization
  public:
@@ -1785,6 +2447,7 @@ class Barrier : public SimObject {
   virtual ~Barrier();
   void ChangeHeight(unsigned new_maxn);         //!< change size
   unsigned Height() const { return maxn; }      //!< barrier size
+  unsigned Waiting() const { return waiting.size(); } //!< number waiting
   virtual void Enter(Entity *e);        //!< wait for barrier break TODO: remove/rename
   virtual bool Wait();                  //!< wait for barrier break (Current)
   virtual int Break();                  //!< activate all waiting entities
@@ -1805,16 +2468,18 @@ struct SIMLIB_statistics_t {
   long   StepCount;     // for continuous simulation
   double MinStep;
   double MaxStep;
-  //! constructor runs SIMLIB_statistics_t::Init()
-  SIMLIB_statistics_t();
+  //! constructor: the same values as SIMLIB_statistics_t::Init()
+  constexpr SIMLIB_statistics_t() :
+    StartTime(-1), EndTime(-1), EventCount(0), StepCount(0),
+    MinStep(-1), MaxStep(-1) {}
   //! initialize - used at the start of each Run()
   void Init();
   //! print run-time statistics to output
   void Output() const;
 };
 
-//! interface to internal run-time statistics structure
-extern const SIMLIB_statistics_t & SIMLIB_statistics;
+//! interface to internal run-time statistics structure (read-only)
+SIMLIB_CONSTINIT extern thread_local SIMLIB_statistics_t SIMLIB_statistics;
 
 } // namespace simlib3
 
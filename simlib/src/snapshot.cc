@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file snapshot.cc  Binary copy of statistics data
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  SIMLIB_Snapshot implementation
+//
+//  Data of statistics objects are copied as raw values (the same
+//  program on the same machine reads them, e.g. parent of forked
+//  process or restored checkpoint), merging uses Merge() of temporary
+//  object, Load() replaces all data (bit-exact copy).
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <cstring>      // memcpy
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+namespace {
+
+template <class T> void Put(char *&p, const T &x)
+{
+  std::memcpy(p, &x, sizeof(T));
+  p += sizeof(T);
+}
+
+template <class T> void Get(const char *&p, T &x)
+{
+  std::memcpy(&x, p, sizeof(T));
+  p += sizeof(T);
+}
+
+} // local namespace
+
+////////////////////////////////////////////////////////////////////////////
+//  Stat
+//
+size_t SIMLIB_Snapshot::Size(const Stat &)
+{
+  return 4 * sizeof(double) + sizeof(unsigned long);
+}
+
+void SIMLIB_Snapshot::Save(const Stat &s, char *&p)
+{
+  Put(p, s.mean);
+  Put(p, s.m2);
+  Put(p, s.min);
+  Put(p, s.max);
+  Put(p, s.n);
+}
+
+void SIMLIB_Snapshot::Merge(Stat &s, const char *&p)
+{
+  Stat x;
+  Get(p, x.mean);
+  Get(p, x.m2);
+  Get(p, x.min);
+  Get(p, x.max);
+  Get(p, x.n);
+  s.Merge(x);
+}
+
+void SIMLIB_Snapshot::Load(Stat &s, const char *&p)
+{
+  Get(p, s.mean);
+  Get(p, s.m2);
+  Get(p, s.min);
+  Get(p, s.max);
+  Get(p, s.n);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  TStat
+//
+size_t SIMLIB_Snapshot::Size(const TStat &)
+{
+  return 8 * sizeof(double) + sizeof(unsigned long);
+}
+
+void SIMLIB_Snapshot::Save(const TStat &s, char *&p)
+{
+  Put(p, s.wt);
+  Put(p, s.mean);
+  Put(p, s.m2);
+  Put(p, s.min);
+  Put(p, s.max);
+  Put(p, s.t0);
+  Put(p, s.tl);
+  Put(p, s.xl);
+  Put(p, s.n);
+}
+
+// the last period (from last record to current time) is recorded
+void SIMLIB_Snapshot::Close(TStat &s)
+{
+  s.Add(s.xl, double(Time) - s.tl);
+  s.tl = Time;
+}
+
+void SIMLIB_Snapshot::Merge(TStat &s, const char *&p)
+{
+  TStat x;
+  Get(p, x.wt);
+  Get(p, x.mean);
+  Get(p, x.m2);
+  Get(p, x.min);
+  Get(p, x.max);
+  Get(p, x.t0);
+  Get(p, x.tl);
+  Get(p, x.xl);
+  Get(p, x.n);
+  s.Merge(x);
+}
+
+void SIMLIB_Snapshot::Load(TStat &s, const char *&p)
+{
+  Get(p, s.wt);
+  Get(p, s.mean);
+  Get(p, s.m2);
+  Get(p, s.min);
+  Get(p, s.max);
+  Get(p, s.t0);
+  Get(p, s.tl);
+  Get(p, s.xl);
+  Get(p, s.n);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Histogram (the same intervals)
+//
+size_t SIMLIB_Snapshot::Size(const Histogram &h)
+{
+  return (h.count + 2) * sizeof(unsigned) + Size(h.stat);
+}
+
+void SIMLIB_Snapshot::Save(const Histogram &h, char *&p)
+{
+  for (unsigned i = 0; i < h.count + 2; i++)
+    Put(p, h.dptr[i]);
+  Save(h.stat, p);
+}
+
+void SIMLIB_Snapshot::Merge(Histogram &h, const char *&p)
+{
+  for (unsigned i = 0; i < h.count + 2; i++) {
+    unsigned k;
+    Get(p, k);
+    h.dptr[i] += k;
+  }
+  Merge(h.stat, p);
+}
+
+void SIMLIB_Snapshot::Load(Histogram &h, const char *&p)
+{
+  for (unsigned i = 0; i < h.count + 2; i++)
+    Get(p, h.dptr[i]);
+  Load(h.stat, p);
+}
+
+} // namespace
+
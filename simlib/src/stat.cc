@@ -9,6 +9,10 @@
 //
 // class Stat implementation
 //
+// mean and sum of squared deviations are updated by Welford's method,
+// statistics are merged using Chan's formula (no loss of precision
+// like with sums of x and x*x for long runs)
+//
 
 ////////////////////////////////////////////////////////////////////////////
 // interface
@@ -28,39 +32,79 @@ namespace simlib3 {
 
 SIMLIB_IMPLEMENTATION;
 
+////////////////////////////////////////////////////////////////////////////
+//  default statistics level of Queue, Facility and Store objects
+//
+SIMLIB_CONSTINIT thread_local StatisticsLevel_t SIMLIB_StatisticsLevel = StatisticsLevel_t(SIMLIB_STATISTICS);
+
+void SetStatisticsLevel(StatisticsLevel_t level)
+{
+  Dprintf(("SetStatisticsLevel(%d)", int(level)));
+  SIMLIB_StatisticsLevel = SIMLIB_StatLevelLimit(level);
+}
+
+StatisticsLevel_t StatisticsLevel()
+{
+  return SIMLIB_StatisticsLevel;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //  operator ()  --- record value
 //
 void Stat::operator () (double x)
 {
-  sx  += x;
-  sx2 += x*x;
+  double d = x - mean;
   if(++n==1) min=max=x;
   else {
     if(x<min) min = x;
     if(x>max) max = x;
   }
+  mean += d/n;
+  m2 += d*(x - mean);
 };
 
+////////////////////////////////////////////////////////////////////////////
+//  Merge --- add all records of other statistic
+//
+void Stat::Merge(const Stat &x)
+{
+  if(x.n==0) return;
+  if(n==0) {
+    mean = x.mean; m2 = x.m2;
+    min = x.min; max = x.max;
+    n = x.n;
+    return;
+  }
+  double nn = double(n) + double(x.n);
+  double d = x.mean - mean;
+  mean += d*(x.n/nn);
+  m2 += x.m2 + d*d*(double(n)*double(x.n)/nn);
+  if(x.min<min) min = x.min;
+  if(x.max>max) max = x.max;
+  n += x.n;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 //  constructors
 //
 Stat::Stat(const char *name) :
-  sx(0), sx2(0),
+  mean(0), m2(0),
   min(0), max(0),
   n(0)
 {
   Dprintf(("Stat::Stat(\"%s\")",name));
   SetName(name);
+  SIMLIB_StatRegistry::Register(this);
 }
 
 Stat::Stat() :
-  sx(0), sx2(0),
+  mean(0), m2(0),
   min(0), max(0),
   n(0)
 {
   Dprintf(("Stat::Stat()"));
+  SIMLIB_StatRegistry::Register(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -69,6 +113,7 @@ Stat::Stat() :
 Stat::~Stat()
 {
   Dprintf(("Stat::~Stat() // \"%s\" ", Name().c_str()));
+  SIMLIB_StatRegistry::Unregister(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -76,7 +121,7 @@ Stat::~Stat()
 //
 void Stat::Clear()
 {
-  sx = sx2 = 0;    // sums
+  mean = m2 = 0;
   min = max = 0;
   n = 0;           // # of records
 }
@@ -88,7 +133,7 @@ void Stat::Clear()
 double Stat::MeanValue() const
 {
   if (n==0) SIMLIB_error(StatNoRecError);
-  return sx/n;
+  return mean;
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -97,8 +142,7 @@ double Stat::MeanValue() const
 double Stat::StdDev() const
 {
   if (n<2)  SIMLIB_error(StatDispError);
-  double mv = sx/n;
-  return sqrt((sx2-n*mv*mv)/(n-1));
+  return sqrt(m2/(n-1));
 }
 
 }
@@ -37,6 +37,7 @@ SIMLIB_IMPLEMENTATION;
 //
 Store::Store() :
   _Qflag(_OWNQ),
+  _StatLevel(SIMLIB_StatisticsLevel),
   capacity(1L),
   used(0L),
   Q(new Queue("Q"))
@@ -46,6 +47,7 @@ Store::Store() :
 
 Store::Store(unsigned long _capacity) :
   _Qflag(_OWNQ),
+  _StatLevel(SIMLIB_StatisticsLevel),
   capacity(_capacity),
   used(0L),
   Q(new Queue("Q"))
@@ -55,6 +57,7 @@ Store::Store(unsigned long _capacity) :
 
 Store::Store(const char * name, unsigned long _capacity) :
   _Qflag(_OWNQ),
+  _StatLevel(SIMLIB_StatisticsLevel),
   capacity(_capacity),
   used(0L),
   Q(new Queue("Q"))
@@ -65,6 +68,7 @@ Store::Store(const char * name, unsigned long _capacity) :
 
 Store::Store(unsigned long _capacity, Queue *queue) :
   _Qflag(0),
+  _StatLevel(SIMLIB_StatisticsLevel),
   capacity(_capacity),
   used(0L),
   Q(queue)
@@ -75,6 +79,7 @@ Store::Store(unsigned long _capacity, Queue *queue) :
 
 Store::Store(const char *name, unsigned long _capacity, Queue *queue) :
   _Qflag(0),
+  _StatLevel(SIMLIB_StatisticsLevel),
   capacity(_capacity),
   used(0L),
   Q(queue)
@@ -122,6 +127,20 @@ void Store::SetQueue(Queue *queue)
   Q = queue;
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// SetStatisticsLevel
+/// - change level of statistics (including internal queue),
+///   statistics are cleared if the level differs
+void Store::SetStatisticsLevel(StatisticsLevel_t level)
+{
+  Dprintf(("%s.SetStatisticsLevel(%d)", Name().c_str(), int(level)));
+  StatisticsLevel_t l = SIMLIB_StatLevelLimit(level);
+  if (l != _StatLevel)          // do not mix records of different levels
+    tstat.Clear(used);
+  _StatLevel = l;
+  if (OwnQueue()) Q->SetStatisticsLevel(level);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 ///  Enter
 ///  - allocate requested capacity
@@ -143,7 +162,7 @@ void Store::Enter(Entity *e, unsigned long rcap)
     return;             // after activation is already allocated!
   }
   used += rcap;         // allocate capacity
-  tstat(used);          // update statistics
+  SIMLIB_STAT_RECORD(_StatLevel, tstat, used); // update statistics
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -155,7 +174,7 @@ void Store::Leave(unsigned long rcap)
   if (used<rcap)
     SIMLIB_error(LeaveManyError);
   used -= rcap ;           // free capacity
-  tstat(used);  tstat.n--; // fix: correction
+  SIMLIB_STAT_UPDATE(_StatLevel, tstat, used);
   if(Q->empty())
     return;
   // satisfy entities waiting in queue (starting from begin)
@@ -169,7 +188,7 @@ void Store::Leave(unsigned long rcap)
       Dprintf(("%s.Enter(%s,%lu) from queue",
                 Name().c_str(), p->Name().c_str(), p->_RequiredCapacity));
       used += p->_RequiredCapacity;  // allocate capacity
-      tstat(used);                   // update statistics
+      SIMLIB_STAT_RECORD(_StatLevel, tstat, used); // update statistics
       p->Activate();                 // reactivate now
       // will go to Store::Enter REACTIVATION
   } // while
@@ -17,6 +17,8 @@
 #include "simlib.h"
 #include "internal.h"
 
+#include <cstdio>   // fopen(), fprintf()
+
 ////////////////////////////////////////////////////////////////////////////
 // implementation
 //
@@ -30,24 +32,28 @@ SIMLIB_IMPLEMENTATION;
 //  constructors
 //
 TStat::TStat(double initval):
-  sxt(0), sx2t(0),
+  wt(0), mean(0), m2(0),
   min(initval), max(initval),
   t0(Time), tl(Time),     // time of initialization and last op
   xl(initval),            // last value
-  n(0UL)                  // number of records
+  n(0UL),                 // number of records
+  rec(0)
 {
   Dprintf(("TStat::TStat()"));
+  SIMLIB_StatRegistry::Register(this);
 }
 
 TStat::TStat(const char *name, double initval) :
-  sxt(0), sx2t(0),
+  wt(0), mean(0), m2(0),
   min(initval), max(initval),
   t0(Time), tl(Time),
   xl(initval),
-  n(0UL)
+  n(0UL),
+  rec(0)
 {
   Dprintf(("TStat::TStat(\"%s\")",name));
   SetName(name);
+  SIMLIB_StatRegistry::Register(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -56,6 +62,19 @@ TStat::TStat(const char *name, double initval) :
 TStat::~TStat()
 {
   Dprintf(("TStat::~TStat() // \"%s\" ", Name().c_str()));
+  SIMLIB_StatRegistry::Unregister(this);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Add --- add period of length dt with value x (weighted Welford update)
+//
+void TStat::Add(double x, double dt)
+{
+  if (dt<=0) return;
+  wt += dt;
+  double d = x - mean;
+  mean += d*(dt/wt);
+  m2 += dt*d*(x - mean);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -64,9 +83,7 @@ TStat::~TStat()
 void TStat::operator () (double x)
 {
   if (Time<tl) SIMLIB_warning(TStatNotInitialized);
-  double tt = xl*(double(Time)-tl);
-  sxt  += tt;
-  sx2t += xl*tt;
+  Add(xl, double(Time)-tl);
   xl = x;
   tl = Time;
   if(++n==1) min=max=x;   // TODO: check
@@ -75,6 +92,17 @@ void TStat::operator () (double x)
     if(x<min) min = x;
     if(x>max) max = x;
   }
+  if(rec) rec->Update(Time, x);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetRecorder --- attach time series recorder (0 = detach)
+//
+void TStat::SetRecorder(TStatRecorder *r)
+{
+  Dprintf(("TStat::SetRecorder(%p) // \"%s\" ", r, Name().c_str()));
+  rec = r;
+  if(rec) rec->Start(Time, xl);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -83,11 +111,12 @@ void TStat::operator () (double x)
 void TStat::Clear(double initval)
 {
   Dprintf(("TStat::Clear() // \"%s\" ", Name().c_str()));
-  sxt = sx2t = 0;
+  wt = mean = m2 = 0;
   min = max = initval;
   t0 = tl = Time;
   xl = initval;       // last value
   n = 0UL;
+  if(rec) rec->Start(Time, initval);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -98,9 +127,208 @@ double TStat::MeanValue() const
 //  if(n==0)     Error(111); // FIXME: error message
   if(Time<t0)
     SIMLIB_error(TStatNotInitialized);;
-  if(Time==t0)  return xl;
-  double sumxt = sxt + xl*(double(Time)-tl); // count last period
-  return sumxt/(double(Time)-t0);
+  double dt = double(Time)-tl;  // count last period
+  double w = wt + dt;
+  if(w<=0)  return xl;
+  return mean + (xl - mean)*(dt/w);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  TStat::Merge --- add recorded periods of other statistic
+//
+// the last (open) period of x is not included, record the final value
+// by x(x.LastValue()) before merging if it should be counted
+//
+void TStat::Merge(const TStat &x)
+{
+  if(x.n==0) return;
+  if(x.wt>0) {
+    double w = wt + x.wt;
+    double d = x.mean - mean;
+    mean += d*(x.wt/w);
+    m2 += x.m2 + d*d*(wt*x.wt/w);
+    wt = w;
+  }
+  if(n==0) { min = x.min; max = x.max; }
+  else {
+    if(x.min<min) min = x.min;
+    if(x.max>max) max = x.max;
+  }
+  n += x.n;
+}
+
+
+////////////////////////////////////////////////////////////////////////////
+//  TStatRecorder --- time series of TStat in fixed windows
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+TStatRecorder::TStatRecorder(double _width, unsigned _capacity) :
+  ring(0), capacity(_capacity), head(0), count(0), file(0),
+  width(_width), t0(Time), k(0), ts(Time),
+  sum(0), wmin(0), wmax(0), tl(Time), xl(0)
+{
+  Dprintf(("TStatRecorder::TStatRecorder(%g,%u)", _width, _capacity));
+  if (width <= 0 || capacity == 0)
+    SIMLIB_error(TStatRecorderError);
+  ring = new Window[capacity];
+}
+
+TStatRecorder::TStatRecorder(const char *name, double _width, unsigned _capacity) :
+  ring(0), capacity(_capacity), head(0), count(0), file(0),
+  width(_width), t0(Time), k(0), ts(Time),
+  sum(0), wmin(0), wmax(0), tl(Time), xl(0)
+{
+  Dprintf(("TStatRecorder::TStatRecorder(\"%s\",%g,%u)", name, _width, _capacity));
+  if (width <= 0 || capacity == 0)
+    SIMLIB_error(TStatRecorderError);
+  ring = new Window[capacity];
+  SetName(name);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor --- writes complete windows to output file
+//
+TStatRecorder::~TStatRecorder()
+{
+  Dprintf(("TStatRecorder::~TStatRecorder() // \"%s\" ", Name().c_str()));
+  if (file) {
+    Flush();
+    fclose(static_cast<FILE*>(file));
+  }
+  delete [] ring;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  SetOutput --- set output file for complete windows (0 or "" = no file)
+//
+void TStatRecorder::SetOutput(const char *filename)
+{
+  if (file) {
+    Flush();                    // complete windows to previous file
+    fclose(static_cast<FILE*>(file));
+  }
+  file = 0;
+  if (filename && *filename) {
+    file = fopen(filename, "wt");
+    if (!file)
+      SIMLIB_error(CantOpenOutFile);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Start --- start new window at time t with value x
+//
+void TStatRecorder::Start(double t, double x)
+{
+  t0 = tl = ts = t;
+  k = 0;
+  xl = wmin = wmax = x;
+  sum = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Close --- store current window into buffer, start next one
+//
+void TStatRecorder::Close()
+{
+  if (count == capacity) {      // buffer is full
+    if (file)
+      Flush();                  // write all windows
+    else {
+      head = (head + 1) % capacity;   // overwrite the oldest window
+      --count;
+    }
+  }
+  Window &w = ring[(head + count) % capacity];
+  double wend = t0 + (k + 1) * width;
+  w.start = ts;                 // start of window or time of Flush(true)
+  w.mean = sum / (wend - ts);
+  w.min = wmin;
+  w.max = wmax;
+  ++count;
+  ++k;
+  ts = wend;
+  sum = 0;
+  wmin = wmax = xl;             // value at start of next window
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Update --- value changed to x at time t
+//
+void TStatRecorder::Update(double t, double x)
+{
+  double wend;
+  while (t >= (wend = t0 + (k + 1) * width)) { // window(s) completed
+    sum += xl * (wend - tl);
+    tl = wend;
+    Close();
+  }
+  sum += xl * (t - tl);
+  tl = t;
+  xl = x;
+  if (x < wmin) wmin = x;
+  if (x > wmax) wmax = x;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Flush --- write buffered windows to output file
+//
+// partial: close windows up to current time and write also the current
+// incomplete window (its mean is computed for its actual length); the
+// written part is consumed, the rest of window starts at current time
+//
+void TStatRecorder::Flush(bool partial)
+{
+  if (partial)
+    Update(Time, xl);
+  if (file) {
+    FILE *f = static_cast<FILE*>(file);
+    for (unsigned i = 0; i < count; ++i) {
+      const Window &w = (*this)[i];
+      fprintf(f, "%g %g %g %g\n", w.start, w.mean, w.min, w.max);
+    }
+    head = count = 0;
+    if (partial && Time > ts) { // incomplete window (e.g. at end of run)
+      fprintf(f, "%g %g %g %g\n", ts, sum / (Time - ts), wmin, wmax);
+      ts = Time;                // written, not repeated by Close()
+      sum = 0;
+      wmin = wmax = xl;
+    }
+    fflush(f);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator [] --- i-th window in buffer (0 = oldest)
+//
+const TStatRecorder::Window &TStatRecorder::operator[](unsigned i) const
+{
+  if (i >= count)
+    SIMLIB_error(TStatRecorderIndexError);
+  return ring[(head + i) % capacity];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print buffered windows
+//
+void TStatRecorder::Output() const
+{
+  Print("+----------------------------------------------------------+\n");
+  Print("| TIME SERIES %-44s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  Print("|  Window width = %-40g |\n", width);
+  Print("+--------------+--------------+--------------+-------------+\n");
+  Print("|    start     |     mean     |     min      |     max     |\n");
+  Print("+--------------+--------------+--------------+-------------+\n");
+  for (unsigned i = 0; i < count; ++i) {
+    const Window &w = (*this)[i];
+    Print("| %12g | %12g | %12g | %11g |\n", w.start, w.mean, w.min, w.max);
+  }
+  Print("+--------------+--------------+--------------+-------------+\n");
+  Print("\n");
 }
 
 }
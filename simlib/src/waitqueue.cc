@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file waitqueue.cc  Queue of entities waiting for synchronization
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  class WaitQueue implementation
+//
+//  WaitQueue is used by Barrier and Semaphore. Waiting entities are
+//  linked into the list directly (via Link), so waiting does not allocate
+//  memory. Released entities are activated at current time using single
+//  calendar operation for all of them.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+// buffer for released entities (reused, grows to maximal batch size)
+static thread_local std::vector<Entity*> batch;
+
+////////////////////////////////////////////////////////////////////////////
+//  constructors
+//
+WaitQueue::WaitQueue()
+{
+  Dprintf(("WaitQueue::WaitQueue()"));
+}
+
+WaitQueue::WaitQueue(const char *name)
+{
+  Dprintf(("WaitQueue::WaitQueue(\"%s\")", name));
+  SetName(name);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+WaitQueue::~WaitQueue()
+{
+  Dprintf(("WaitQueue::~WaitQueue()  // \"%s\" ", Name().c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Insert --- priority insert (higher priority first, FIFO)
+//
+void WaitQueue::Insert(Entity *e)
+{
+  Dprintf(("%s.Insert(%s)", Name().c_str(), e->Name().c_str()));
+  iterator p = end();   // search from end (usual case)
+  while (p != begin()) {
+    iterator q = p;
+    --p;
+    if (static_cast<Entity*>(*p)->Priority >= e->Priority) { p = q; break; }
+  }
+  PredIns(e, p);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Wait --- insert entity and passivate it
+//
+void WaitQueue::Wait(Entity *e)
+{
+  Insert(e);
+  e->Passivate();       // process waits here until released
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Release --- activate first k entities at current time
+//  returns: number of activated entities
+//
+unsigned WaitQueue::Release(unsigned k)
+{
+  Dprintf(("%s.Release(%u)", Name().c_str(), k));
+  unsigned count = 0;
+  batch.clear();
+  while (count < k && !empty()) {
+    Entity *e = static_cast<Entity*>(GetFirst());
+    if (e->Idle())
+      batch.push_back(e);
+    else                // scheduled while waiting: reschedule now
+      e->Activate();
+    ++count;
+  }
+  if (!batch.empty())
+    SQS::ScheduleBatch(batch.data(), batch.size(), Time);
+  return count;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print waiting entities
+//
+void WaitQueue::Output() const
+{
+  WaitQueue *q = const_cast<WaitQueue*>(this);  // List has no const iterator
+  unsigned i = 0;
+  for (iterator p = q->begin(); p != q->end(); ++p, ++i)
+    Print("%3u: %s\n", i, static_cast<Entity*>(*p)->Name().c_str());
+}
+
+} // namespace
+
@@ -36,7 +36,7 @@ SIMLIB_IMPLEMENTATION;
 class WaitUntilList {
     typedef std::list<Process *> container_t;
     container_t l;
-    static WaitUntilList *instance;   // unique list
+    static thread_local WaitUntilList *instance;   // unique list
   public:
     typedef container_t::iterator iterator;
     static iterator begin() { return instance->l.begin(); }
@@ -65,7 +65,7 @@ class WaitUntilList {
     WaitUntilList() { Dprintf(("WaitUntilList::WaitUntilList()")); }
     ~WaitUntilList() { Dprintf(("WaitUntilList::~WaitUntilList()")); }
     // destructor never called ###???
-    static iterator current;
+    static thread_local iterator current;
 #ifndef NDEBUG
     friend void WU_print();
 #endif
@@ -82,11 +82,11 @@ class WaitUntilList {
 #endif
 
 // WaitUntilList single instance
-WaitUntilList *WaitUntilList::instance = 0; // static
-WaitUntilList::iterator WaitUntilList::current; // static
+thread_local WaitUntilList *WaitUntilList::instance = 0; // static
+thread_local WaitUntilList::iterator WaitUntilList::current; // static
 
 ////////////////////////////////////////////////////////////////////////////
-static bool flag = false; // valid iterator in WUList
+static thread_local bool flag = false; // valid iterator in WUList
 ////////////////////////////////////////////////////////////////////////////
 // main WUlist interface function
 void WaitUntilList::WU_hook() { // get ptr to next process in WUlist or 0
@@ -100,17 +100,17 @@ void WaitUntilList::WU_hook() { // get ptr to next process in WUlist or 0
         flag = true;
         // loop_count++;
         // if(loop_count>LIMIT) error("waituntil-loop");
-        SIMLIB_Current = *current;  // always OK
+        Current = *current;  // always OK
         return;
     }
     ++current;  // next waiting process
     if( current != WaitUntilList::end() ) { // not end
-        SIMLIB_Current = *current;
+        Current = *current;
         return;
     }
     flag = false; // no next process --- end of WaitUntil processing
     // loop_count = 0;
-    SIMLIB_Current = 0; // not needed ???###
+    Current = 0; // not needed ???###
     return;
 }
 
@@ -128,7 +128,7 @@ bool Process::_WaitUntil(bool test)
     _wait_until = false;        // not in WUlist
     return false;               // continue checking WaitUntil condition
   } else {                      // false --- wait
-    if (SIMLIB_Current != this) SIMLIB_internal_error();
+    if (Current != this) SIMLIB_internal_error();
     WaitUntilList::InsertCurrent(); // ***** insert into WUList
     _wait_until = true;         // is in WUlist
     Passivate();                // deactivation = wait
@@ -154,7 +154,7 @@ void WaitUntilList::InsertCurrent()
 {
     if(flag) return; // is in WUlist
     //CONDITION: current process is not in WUlist
-    Process *e = static_cast<Process*>(SIMLIB_Current); // TODO: dynamic_cast ?
+    Process *e = static_cast<Process*>(Current); // TODO: dynamic_cast ?
     Dprintf(("WaitUntilList.Insert(Process#%ld)", e->id()));
     if(instance==0)
         create(); // create singleton instance
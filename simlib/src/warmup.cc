@@ -0,0 +1,282 @@
+/////////////////////////////////////////////////////////////////////////////
+//! \file warmup.cc  Warm-up detection and reset of statistics
+//
+// Copyright (c) 2021
+//
+// This library is licensed under GNU Library GPL. See the file COPYING.
+//
+
+//
+//  registry of statistics objects, ResetStatistics(),
+//  class WarmupDetector implementation (MSER-5 rule):
+//
+//    d* = argmin  sum_{i=d}^{n-1} (z_i - mean_d)^2 / (n-d)^2
+//          0<=d<=n/2
+//
+//  where z_i are means of batches of 5 values and mean_d is mean of
+//  z_d..z_{n-1}. The search is limited to the first half of data (MSER
+//  tends to truncate almost all data at the end of series); if d* = n/2,
+//  the warm-up period is probably longer and the run should be extended.
+//
+
+////////////////////////////////////////////////////////////////////////////
+//  interface
+//
+
+#include "simlib.h"
+#include "internal.h"
+
+////////////////////////////////////////////////////////////////////////////
+//  implementation
+//
+
+namespace simlib3 {
+
+SIMLIB_IMPLEMENTATION;
+
+////////////////////////////////////////////////////////////////////////////
+//  registry of statistics objects
+//
+// circular list of links of this thread, the head is not an object
+//
+namespace {
+
+SIMLIB_CONSTINIT thread_local SIMLIB_StatLink *registry = 0; // created at first use
+
+void DeleteRegistry()
+{
+  SIMLIB_StatLink *l = registry->next;
+  while (l != registry) {               // objects stay unregistered
+    SIMLIB_StatLink *next = l->next;
+    l->prev = l->next = 0;
+    l = next;
+  }
+  delete registry;
+  registry = 0;
+}
+
+void Append(SIMLIB_StatLink &l, SimObject *o, void (*reset)(SimObject *))
+{
+  if (!registry) {
+    registry = new SIMLIB_StatLink;
+    registry->prev = registry->next = registry;
+    SIMLIB_atexit(DeleteRegistry);
+  }
+  l.obj = o;
+  l.reset = reset;
+  l.prev = registry->prev;              // append
+  l.next = registry;
+  registry->prev->next = &l;
+  registry->prev = &l;
+}
+
+void ResetStat(SimObject *o)      { static_cast<Stat*>(o)->Clear(); }
+void ResetHistogram(SimObject *o) { static_cast<Histogram*>(o)->Clear(); }
+void ResetLogHisto(SimObject *o)  { static_cast<LogHistogram*>(o)->Clear(); }
+void ResetTStat(SimObject *o)
+{
+  TStat *s = static_cast<TStat*>(o);
+  s->Clear(s->LastValue());             // start with current value
+}
+
+} // local namespace
+
+void SIMLIB_StatRegistry::Register(Stat *s)
+{ Append(s->_reg, s, ResetStat); }
+void SIMLIB_StatRegistry::Register(TStat *s)
+{ Append(s->_reg, s, ResetTStat); }
+void SIMLIB_StatRegistry::Register(Histogram *h)
+{ Append(h->_reg, h, ResetHistogram); }
+void SIMLIB_StatRegistry::Register(LogHistogram *h)
+{ Append(h->_reg, h, ResetLogHisto); }
+
+void SIMLIB_StatRegistry::Unlink(SIMLIB_StatLink &l)
+{
+  if (!l.next)          // not registered or after cleanup of its thread
+    return;
+  l.prev->next = l.next;
+  l.next->prev = l.prev;
+  l.prev = l.next = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ResetStatistics --- clear all registered statistics
+//
+void ResetStatistics()
+{
+  Dprintf(("ResetStatistics()"));
+  if (!registry)
+    return;
+  for (SIMLIB_StatLink *l = registry->next; l != registry; l = l->next)
+    l->reset(l->obj);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  ResetStatisticsAt --- schedule ResetStatistics() at time t
+//
+namespace {
+class StatResetEvent : public Event {
+  virtual void Behavior() override { ResetStatistics(); }
+};
+}
+
+void ResetStatisticsAt(double t)
+{
+  Dprintf(("ResetStatisticsAt(%g)", t));
+  (new StatResetEvent)->Activate(t);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  WarmupDetector constructors
+//
+WarmupDetector::WarmupDetector(unsigned capacity) :
+  z(0), te(0), nz(0), maxz(capacity),
+  bsize(5), bn(0), bsum(0), t0(Time)
+{
+  Dprintf(("WarmupDetector::WarmupDetector(%u)", capacity));
+  Init();
+}
+
+WarmupDetector::WarmupDetector(const char *name, unsigned capacity) :
+  z(0), te(0), nz(0), maxz(capacity),
+  bsize(5), bn(0), bsum(0), t0(Time)
+{
+  Dprintf(("WarmupDetector::WarmupDetector(\"%s\",%u)", name, capacity));
+  SetName(name);
+  Init();
+}
+
+void WarmupDetector::Init()
+{
+  if (maxz < 10)
+    SIMLIB_error(WarmupError);
+  maxz += maxz % 2;     // even number (pairs are merged)
+  z = new double[maxz];
+  te = new double[maxz];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  destructor
+//
+WarmupDetector::~WarmupDetector()
+{
+  Dprintf(("WarmupDetector::~WarmupDetector() // \"%s\" ", Name().c_str()));
+  delete [] z;
+  delete [] te;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Clear --- initialize (series starts at current time)
+//
+void WarmupDetector::Clear()
+{
+  nz = 0;
+  bsize = 5;
+  bn = 0;
+  bsum = 0;
+  t0 = Time;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  operator () --- record next value of output series
+//
+void WarmupDetector::operator () (double x)
+{
+  bsum += x;
+  if (++bn < bsize)
+    return;
+  z[nz] = bsum / bsize;         // batch complete
+  te[nz] = Time;
+  ++nz;
+  bsum = 0;
+  bn = 0;
+  if (nz == maxz) {             // merge pairs, double batch size
+    for (unsigned i = 0; i < maxz / 2; i++) {
+      z[i] = (z[2*i] + z[2*i + 1]) / 2;
+      te[i] = te[2*i + 1];
+    }
+    nz = maxz / 2;
+    bsize *= 2;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Truncate --- MSER truncation point (batch index)
+//
+// statistics of z[d..nz-1] are computed from the end (Welford)
+//
+unsigned WarmupDetector::Truncate() const
+{
+  if (nz < 2)
+    SIMLIB_error(WarmupError);
+  double mean = z[nz-1];
+  double m2 = 0;
+  double best = 0;
+  unsigned bestd = 0;
+  bool first = true;
+  for (unsigned d = nz - 1; d-- > 0; ) {
+    double k = nz - d;          // number of batches after truncation
+    double dd = z[d] - mean;
+    mean += dd / k;
+    m2 += dd * (z[d] - mean);
+    if (d > nz / 2)
+      continue;
+    double mser = m2 / (k * k);
+    if (first || mser <= best) { // prefer shorter truncation
+      best = mser;
+      bestd = d;
+      first = false;
+    }
+  }
+  return bestd;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Detected --- truncation point found inside the first half of data
+//
+bool WarmupDetector::Detected() const
+{
+  return nz >= 10 && Truncate() < nz / 2;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Truncation --- number of values to delete
+//
+unsigned long WarmupDetector::Truncation() const
+{
+  return Truncate() * bsize;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  WarmupTime --- time of truncation point (end of warm-up period)
+//
+double WarmupDetector::WarmupTime() const
+{
+  unsigned d = Truncate();
+  return d == 0 ? t0 : te[d-1];
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Output --- print result of detection
+//
+void WarmupDetector::Output() const
+{
+  char s[100];
+  Print("+----------------------------------------------------------+\n");
+  Print("| WARM-UP DETECTOR (MSER) %-32s |\n", Name().c_str());
+  Print("+----------------------------------------------------------+\n");
+  sprintf(s, " Batches = %u x %lu ", nz, bsize);
+  Print("| %-56s |\n", s);
+  if (nz >= 2) {
+    sprintf(s, " Truncation = %lu values ", Truncation());
+    Print("| %-56s |\n", s);
+    sprintf(s, " Warm-up time = %g ", WarmupTime());
+    Print("| %-56s |\n", s);
+    sprintf(s, " Detected = %s ", Detected() ? "yes" : "no (run longer)");
+    Print("| %-56s |\n", s);
+  }
+  Print("+----------------------------------------------------------+\n");
+}
+
+} // namespace
+
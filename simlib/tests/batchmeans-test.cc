@@ -0,0 +1,48 @@
+// BatchMeans: batch merging, confidence interval half-width and coverage
+#include <simlib.h>
+#include <cmath>
+
+// coverage of true mean 0 by intervals of 1000 runs, n values each
+// (AR(1) series x = phi * x + e, phi=0: independent values)
+void Coverage(double phi, unsigned long n)
+{
+    const unsigned runs = 1000;
+    unsigned bm_in = 0, iid_in = 0;
+    for (unsigned r = 0; r < runs; r++) {
+        BatchMeans b(20);
+        double x = Normal(0, 1) / std::sqrt(1 - phi * phi);   // stationary
+        for (unsigned long i = 0; i < n; i++) {
+            b(x);
+            x = phi * x + Normal(0, 1);
+        }
+        if (std::fabs(b.GrandMean()) <= b.HalfWidth())
+            bm_in++;
+        // interval assuming independent values (n large: normal quantile)
+        double hw = 1.96 * b.StdDev() / std::sqrt(double(n));
+        if (std::fabs(b.MeanValue()) <= hw)
+            iid_in++;
+    }
+    Print("phi %.1f: coverage %.3f (batch means), %.3f (independent values)\n",
+          phi, bm_in / double(runs), iid_in / double(runs));
+}
+
+int main()
+{
+    // values 1..16, 4 batches: batch size 1, 2, 4 after two merges
+    BatchMeans b("b", 4);
+    for (int i = 1; i <= 16; i++)
+        b(i);
+    Print("%u batches of size %lu:", b.Batches(), b.BatchSize());
+    for (unsigned i = 0; i < b.Batches(); i++)
+        Print(" %g", b.BatchMean(i));
+    Print("\n");
+    // means 2.5 6.5 10.5 14.5: s^2 = 80/3, t(0.975,3) = 3.18245
+    double expected = 3.18245 * std::sqrt(80 / 3.0) / 2;
+    double hw = b.HalfWidth();
+    Print("grand mean %g, half-width %.4f (exact %.4f) %s\n", b.GrandMean(),
+          hw, expected, std::fabs(hw - expected) < 0.005 * expected ? "ok" : "WRONG");
+
+    RandomSeed(1234);
+    Coverage(0, 1024);
+    Coverage(0.9, 4096);
+}
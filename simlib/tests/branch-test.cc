@@ -0,0 +1,67 @@
+// Branch: scenarios continue from common history simulated once
+#include <simlib.h>
+#include <cstdio>
+
+Facility F("F");
+Stat Wait("time in system");
+double service = 0.8;           // mean service time (changed by branches)
+
+class Customer : public Process {
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(F);
+        Wait(Exponential(service));
+        Release(F);
+        ::Wait(Time - t0);      // global Stat
+    }
+};
+
+class Generator : public Event {
+    void Behavior(void) {
+        (new Customer)->Activate();
+        Activate(Time + Exponential(1));
+    }
+};
+
+const double speedup[] = { 1.0, 0.9, 0.7 };     // scenario parameters
+char file[40];
+
+void Scenario(unsigned b)
+{
+    service *= speedup[b];
+    Wait.Clear();
+    sprintf(file, "branch-test-%u.dat", b);
+    SetOutput(file);
+}
+
+class BranchPoint : public Event {      // end of common history
+    void Behavior(void) {
+        Print("history: %lu customers until %g\n", Wait.Number(), double(Time));
+        Branch(3, Scenario);
+    }
+};
+
+int main()
+{
+    RandomSeed(12345);
+    Init(0, 2000);
+    (new Generator)->Activate();
+    (new BranchPoint)->Activate(1000);
+    Run();
+    Print("branch %u: service %g, time in system %.6g (%lu customers)\n",
+          BranchNumber(), service, Wait.MeanValue(), Wait.Number());
+    if (BranchNumber() != 0)
+        return 0;
+    SetOutput("");                      // back to stdout
+    Print("failed branches: %u\n", WaitBranches());
+    for (unsigned b = 0; b < 3; b++) {  // print results in fixed order
+        char line[200];
+        sprintf(file, "branch-test-%u.dat", b);
+        FILE *f = fopen(file, "r");
+        while (f && fgets(line, sizeof(line), f))
+            Print("%s", line);
+        if (f)
+            fclose(f);
+        remove(file);
+    }
+}
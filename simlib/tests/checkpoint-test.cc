@@ -0,0 +1,99 @@
+// Event-only checkpoint: run saved in the middle, restored run gives the
+// same results
+#include <simlib.h>
+#include <cstdio>         // remove
+
+const char *FILENAME = "checkpoint-test.dat";
+
+Facility F("F");
+Histogram Times("time in system", 0.0, 2, 10);
+Stat QLen("queue length (samples)");
+RandomStream ServiceStream(77);         // used by customers
+
+void SampleQueue() { QLen(F.QueueLen()); }
+Sampler S(SampleQueue, 50);
+
+// event-based customer: arrival, start of service, end of service
+class Customer : public Event {
+ public:
+    double t0;
+    int phase;
+    Customer() : t0(Time), phase(0) { BindRandomStream(&ServiceStream); }
+    void Behavior(void) {
+        switch (phase) {
+        case 0:                 // arrival
+            phase = 1;
+            F.Seize(this);
+            if (F.In() != this)
+                return;         // waits, activated by Release()
+            // fall through
+        case 1:                 // service
+            phase = 2;
+            Activate(Time + Exponential(0.8));
+            return;
+        default:                // departure
+            F.Release(this);
+            Times(Time - t0);
+        }
+    }
+};
+
+void CustomerData(CheckpointData &d, Customer &c)
+{
+    d.Value(c.t0);
+    d.Value(c.phase);
+}
+
+class Generator : public Event {
+    void Behavior(void) {
+        (new Customer)->Activate();
+        Activate(Time + Exponential(1));
+    }
+} Gen;
+
+class Save : public Event {
+    void Behavior(void) { SaveEventCheckpoint(FILENAME); }
+} Saver;
+
+void Experiment(bool restore)
+{
+    F.Clear();
+    Times.Clear();
+    QLen.Clear();
+    ServiceStream.Seed(restore ? 1 : 77);       // restored from file
+    RandomSeed(restore ? 1 : 12345);
+    Init(0, 1000);
+    Gen.Activate();
+    if (restore) {
+        RestoreEventCheckpoint(FILENAME);    // continue from time 500
+        Print("restored at time %g\n", double(Time));
+    } else
+        Saver.Activate(500);
+    Run();
+}
+
+int main()
+{
+    CheckpointRegister("F", F);
+    CheckpointRegister("times", Times);
+    CheckpointRegister("qlen", QLen);
+    CheckpointRegister("service", ServiceStream);
+    CheckpointRegister("generator", Gen);
+    CheckpointClass<Customer>("customer", CustomerData);
+    double m[2];
+    unsigned long n[2], q[2];
+    for (int i = 0; i < 2; i++) {
+        Experiment(i == 1);
+        m[i] = Times.stat.MeanValue();
+        n[i] = Times.stat.Number();
+        q[i] = QLen.Number();
+    }
+    Print("continuous run: mean %.10g, customers %lu, samples %lu\n", m[0], n[0], q[0]);
+    Print("restored run:   mean %.10g, customers %lu, samples %lu\n", m[1], n[1], q[1]);
+    Print("results are %s\n",
+          m[0] == m[1] && n[0] == n[1] && q[0] == q[1] ? "the same" : "DIFFERENT");
+    Times.Output();
+    QLen.Output();
+    F.Output();
+    remove(FILENAME);
+}
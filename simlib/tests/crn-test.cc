@@ -0,0 +1,59 @@
+// RandomStream: common random numbers by component, antithetic stream
+#include <simlib.h>
+
+RandomStream arrivals(1);
+RandomStream service(1);
+Facility F("F");
+Stat Wait("time in system");
+
+class Customer : public Process {
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(F);
+        Wait(Exponential(0.8));
+        Release(F);
+        ::Wait(Time - t0);      // global Stat
+    }
+};
+
+class Generator : public Event {
+    void Behavior(void) {
+        Customer *c = new Customer;
+        c->BindRandomStream(&service);
+        c->Activate();
+        Activate(Time + Exponential(1));
+    }
+};
+
+// run of one scenario, returns mean time in system
+double Scenario(bool antithetic)
+{
+    RandomSeed(12345);
+    arrivals = RandomStream::ForComponent("arrivals");
+    service = RandomStream::ForComponent("service");
+    arrivals.SetAntithetic(antithetic);
+    service.SetAntithetic(antithetic);
+    Wait.Clear();
+    Init(0, 1000);
+    F.Clear();
+    Generator *g = new Generator;
+    g->BindRandomStream(&arrivals);
+    g->Activate();
+    Run();
+    return Wait.MeanValue();
+}
+
+int main()
+{
+    double a = Scenario(false);
+    double b = Scenario(false);         // the same numbers
+    double c = Scenario(true);          // antithetic run
+    Print("run 1: %g\nrun 2: %g (%s)\n", a, b, a == b ? "same" : "DIFFERENT");
+    Print("antithetic: %g, mean of pair: %g\n", c, (a + c) / 2);
+    RandomStream u(7), v(7);
+    v.SetAntithetic(true);
+    for (int i = 0; i < 3; i++) {
+        double x = u.Random(), y = v.Random();
+        Print("%.6f + %.6f = %.6f\n", x, y, x + y);
+    }
+}
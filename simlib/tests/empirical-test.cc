@@ -0,0 +1,82 @@
+// EmpiricalDiscrete (alias method), EmpiricalContinuous: sorted table,
+// frequencies of values, quantiles of piecewise-linear CDF
+#include <simlib.h>
+#include <cmath>
+#include <cstdio>
+
+const char *FILENAME = "empirical-test.dat";
+const unsigned long N = 1000000;
+
+// relative frequencies of values in N draws, 4 sigma bound
+void Frequencies(EmpiricalDiscrete &d)
+{
+    unsigned long count[10] = { 0 };
+    for (unsigned long k = 0; k < N; k++) {
+        double x = d();
+        for (unsigned i = 0; i < d.Count(); i++)
+            if (x == d.Value(i))
+                count[i]++;
+    }
+    for (unsigned i = 0; i < d.Count(); i++) {
+        double p = d.Probability(i), f = count[i] / double(N);
+        double sigma = std::sqrt(p * (1 - p) / N);
+        Print("  value %g: probability %.4f, frequency %.4f %s\n",
+              d.Value(i), p, f, std::fabs(f - p) <= 4 * sigma ? "ok" : "WRONG");
+    }
+}
+
+int main()
+{
+    RandomSeed(1234);
+    // unsorted values, value 1 twice
+    const double v[] = { 3, 1, 2, 1, 5 };
+    const double w[] = { 5, 1, 3, 1, 0 };
+    EmpiricalDiscrete d(v, w, 5);
+    Print("discrete (values 3 1 2 1 5, weights 5 1 3 1 0): %u values\n",
+          d.Count());
+    Frequencies(d);
+
+    RandomStream s1(99), s2(99);
+    bool same = true;
+    RandomStream *prev = SetRandomStream(&s2);
+    for (int i = 0; i < 1000; i++)
+        same = same && d.Sample(s1) == d();
+    SetRandomStream(prev);
+    Print("  Sample(stream) and operator(): %s\n", same ? "the same" : "DIFFERENT");
+
+    FILE *f = std::fopen(FILENAME, "w");
+    std::fputs("# samples\n4\n2\n4\n4\n", f);
+    std::fclose(f);
+    EmpiricalDiscrete e(FILENAME);
+    Print("discrete from samples 4 2 4 4: %u values\n", e.Count());
+    Frequencies(e);
+
+    // CDF: F(0)=0, F(1)=0.5, F(3)=1, mean 0.5*0.5 + 0.5*2 = 1.25
+    const double x[] = { 0, 1, 3 }, F[] = { 0, 0.5, 1 };
+    EmpiricalContinuous c(x, F, 3);
+    Print("continuous (0 0, 1 0.5, 3 1): quantiles");
+    const double u[] = { 0, 0.25, 0.5, 0.75, 1 };
+    for (int i = 0; i < 5; i++)
+        Print(" %g", c.Quantile(u[i]));
+    Print("\n");
+    Stat st;
+    unsigned long below = 0;
+    for (unsigned long k = 0; k < N; k++) {
+        double y = c();
+        st(y);
+        if (y < 1)
+            below++;
+    }
+    double sigma = 0.5 / std::sqrt(double(N));
+    Print("  P(x<1) %.4f (0.5) %s, mean %.4f (1.25), range %.3f-%.3f\n",
+          below / double(N), std::fabs(below / double(N) - 0.5) <= 4 * sigma
+          ? "ok" : "WRONG", st.MeanValue(), st.Min(), st.Max());
+
+    f = std::fopen(FILENAME, "w");
+    std::fputs("1\n2\n4\n3\n", f);
+    std::fclose(f);
+    EmpiricalContinuous g(FILENAME);
+    Print("continuous from samples 1 2 4 3: median %g, range %g-%g\n",
+          g.Quantile(0.5), g.Low(), g.High());
+    std::remove(FILENAME);
+}
@@ -0,0 +1,101 @@
+// FillUniform/FillNormal/FillExponential: exact mode equals scalar calls,
+// fast mode (SIMD lanes) equals its portable definition, moments
+#include <simlib.h>
+#include <cmath>
+#include <vector>
+
+const unsigned long N = 100000;
+
+enum Dist { UNIFORM, NORMAL, EXPONENTIAL };
+const char *names[] = { "Uniform", "Normal", "Exponential" };
+
+void Fill(Dist d, double *x, unsigned long n, RandomStream *s)
+{
+    switch (d) {
+    case UNIFORM:     FillUniform(x, n, 2, 5, s); break;
+    case NORMAL:      FillNormal(x, n, 1, 3, s); break;
+    case EXPONENTIAL: FillExponential(x, n, 4, s); break;
+    }
+}
+
+double Scalar(Dist d)
+{
+    switch (d) {
+    case UNIFORM:     return Uniform(2, 5);
+    case NORMAL:      return Normal(1, 3);
+    default:          return Exponential(4);
+    }
+}
+
+bool Same(const std::vector<double> &a, const std::vector<double> &b)
+{
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i] != b[i])       // bit-identical
+            return false;
+    return true;
+}
+
+// exact mode and short arrays: the same numbers as scalar generators,
+// from current stream (s=0) or given stream
+void Exact(Dist d, unsigned long n, bool stream)
+{
+    std::vector<double> a(n), b(n);
+    RandomStream s1(1234), s2(1234);
+    RandomSeed(1234);
+    Fill(d, &a[0], n, stream ? &s1 : 0);
+    RandomStream *prev = SetRandomStream(stream ? &s2 : 0);
+    RandomSeed(1234);
+    for (unsigned long i = 0; i < n; i++)
+        b[i] = Scalar(d);
+    SetRandomStream(prev);
+    bool next = stream ? s1.Next() == s2.Next() : true;   // state after
+    Print("  %-11s n=%-6lu %s stream: %s\n", names[d], n,
+          stream ? "given  " : "current", Same(a, b) && next ? "the same" : "DIFFERENT");
+}
+
+int main()
+{
+    Print("exact mode:\n");
+    SetFillExact(true);
+    for (int d = UNIFORM; d <= EXPONENTIAL; d++) {
+        Exact(Dist(d), N, false);
+        Exact(Dist(d), N, true);
+    }
+    SetFillExact(false);
+    Print("fast mode, short arrays:\n");
+    for (int d = UNIFORM; d <= EXPONENTIAL; d++)
+        Exact(Dist(d), 63, true);
+
+    // fast mode: lane k is the stream after k jumps, number i is from
+    // lane i%4, uniform = 53 high bits as Random()
+    Print("fast mode:\n");
+    std::vector<double> a(N), b(N);
+    RandomStream s(1234), t(1234);
+    FillUniform(&a[0], N, 2, 5, &s);
+    std::vector<RandomStream> lane;
+    for (int k = 0; k < 4; k++)
+        lane.push_back(t.Split());
+    for (unsigned long i = 0; i < N; i++)
+        b[i] = 2 + 3 * ((lane[i % 4].Next() >> 11) / 9007199254740992.0);
+    Print("  Uniform     lanes: %s, stream moved by 4 jumps: %s\n",
+          Same(a, b) ? "the same" : "DIFFERENT",
+          s.Next() == t.Next() ? "yes" : "NO");
+
+    // mean and variance of 10^6 numbers (standard error in brackets)
+    const unsigned long M = 1000000;
+    std::vector<double> x(M);
+    const double mean[] = { 3.5, 1, 4 }, var[] = { 0.75, 9, 16 };
+    RandomSeed(1234);
+    for (int d = UNIFORM; d <= EXPONENTIAL; d++) {
+        Fill(Dist(d), &x[0], M, 0);
+        Stat st;
+        for (unsigned long i = 0; i < M; i++)
+            st(x[i]);
+        double v = st.StdDev() * st.StdDev();
+        double se = std::sqrt(var[d] / M);
+        Print("  %-11s mean %.4f (%g +- %.4f), variance %.3f (%g) %s\n",
+              names[d], st.MeanValue(), mean[d], se, v, var[d],
+              std::fabs(st.MeanValue() - mean[d]) < 4 * se &&
+              std::fabs(v - var[d]) < 0.01 * var[d] ? "ok" : "WRONG");
+    }
+}
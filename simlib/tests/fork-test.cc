@@ -0,0 +1,68 @@
+// ForkReplications: replications in child processes, merged statistics,
+// other children of program are not reaped
+#include <simlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+Facility F("F");
+Histogram Times("time in system", 0.0, 2, 10);
+TStat Busy("facility busy");
+Stat Means("mean time in system (replications)");
+
+class Customer : public Process {
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(F);
+        Busy(1);
+        Wait(Exponential(0.8));
+        Busy(0);
+        Release(F);
+        Times(Time - t0);
+    }
+};
+
+class Generator : public Event {
+    void Behavior(void) {
+        (new Customer)->Activate();
+        Activate(Time + Exponential(1));
+    }
+};
+
+// one replication: continues from prepared model
+void Replication(unsigned long)
+{
+    Run();
+    Means(Times.stat.MeanValue());
+}
+
+int main()
+{
+    double m[2];
+    unsigned long n[2];
+    const unsigned workers[2] = { 1, 4 };
+    pid_t other = fork();       // not a replication
+    if (other == 0)
+        _exit(7);
+    for (int i = 0; i < 2; i++) {
+        RandomSeed(12345);
+        Init(0, 1000);          // common prefix of replications
+        F.Clear();
+        Times.Clear();
+        Busy.Clear();
+        Means.Clear();
+        (new Generator)->Activate();
+        ForkReplications(20, workers[i], Replication, { &Times, &Busy, &Means });
+        m[i] = Means.MeanValue();
+        n[i] = Times.stat.Number();
+    }
+    for (int i = 0; i < 2; i++)
+        Print("workers %u: mean %.10g, customers %lu\n", workers[i], m[i], n[i]);
+    Print("results are %s\n", m[0] == m[1] && n[0] == n[1] ? "the same" : "DIFFERENT");
+    int status = 0;
+    Print("other child is %s\n", waitpid(other, &status, 0) == other &&
+          WIFEXITED(status) && WEXITSTATUS(status) == 7 ? "not reaped" : "REAPED");
+    Means.Output();
+    Times.Output();
+    Print("utilization %.6f (time %g, records %lu)\n",
+          Busy.Sum() / Busy.Weight(), Busy.Weight(), Busy.Number());
+}
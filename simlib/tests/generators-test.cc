@@ -0,0 +1,110 @@
+// Fast exact generators: moments and tail probability of ziggurat
+// (Normal, Exponential), Marsaglia-Tsang (Gamma), PTRS (Poisson) and
+// BTPE (Binom) compared with exact values; small parameters test the
+// inversion branches, too
+#include <simlib.h>
+#include <cmath>
+
+const unsigned long M = 1000000;        // sample size
+
+struct Exact {
+    double mean, var, skew;     // moments
+    double q, tail;             // tail probability P(X > q)
+};
+
+// sample moments and tail, ok if within a few standard errors
+void Check(const char *name, double (*gen)(), const Exact &e)
+{
+    double mean = 0, m2 = 0, m3 = 0;
+    unsigned long over = 0;
+    for (unsigned long i = 1; i <= M; i++) {    // one-pass central moments
+        double x = gen();
+        double d = x - mean, dn = d / i;
+        m3 += d * dn * dn * (i - 1.0) * (i - 2.0) - 3 * dn * m2;
+        m2 += d * dn * (i - 1.0);
+        mean += dn;
+        if (x > e.q)
+            ++over;
+    }
+    double var = m2 / (M - 1);
+    double skew = (m3 / M) / std::pow(m2 / M, 1.5);
+    double tail = double(over) / M;
+    bool ok = std::fabs(mean - e.mean) < 4 * std::sqrt(e.var / M)
+        && std::fabs(var - e.var) < 0.01 * e.var
+        && std::fabs(skew - e.skew) < 0.05
+        && std::fabs(tail - e.tail) < 4 * std::sqrt(e.tail * (1 - e.tail) / M);
+    Print("%-16s mean %8.4f (%g)  var %8.4f (%g)  skew %6.3f (%.3f)\n",
+          name, mean, e.mean, var, e.var, skew, e.skew);
+    Print("%-16s P(X>%g) %.5f (%.5f)  %s\n", "", e.q, tail, e.tail,
+          ok ? "ok" : "WRONG");
+}
+
+// exact values of discrete distributions from probabilities p[k]
+Exact Discrete(const double *p, int n, double q)
+{
+    Exact e = { 0, 0, 0, q, 0 };
+    for (int k = 0; k <= n; k++)
+        e.mean += k * p[k];
+    double m3 = 0;
+    for (int k = 0; k <= n; k++) {
+        double d = k - e.mean;
+        e.var += d * d * p[k];
+        m3 += d * d * d * p[k];
+        if (k > q)
+            e.tail += p[k];
+    }
+    e.skew = m3 / std::pow(e.var, 1.5);
+    return e;
+}
+
+Exact PoissonExact(double lambda, double q)
+{
+    const int n = int(lambda + 20 * std::sqrt(lambda) + 20);
+    static double p[400];
+    for (int k = 0; k <= n; k++)
+        p[k] = std::exp(k * std::log(lambda) - lambda - std::lgamma(k + 1.0));
+    return Discrete(p, n, q);
+}
+
+Exact BinomExact(int n, double r, double q)
+{
+    static double p[1001];
+    for (int k = 0; k <= n; k++)
+        p[k] = std::exp(std::lgamma(n + 1.0) - std::lgamma(k + 1.0)
+                        - std::lgamma(n - k + 1.0)
+                        + k * std::log(r) + (n - k) * std::log(1 - r));
+    return Discrete(p, n, q);
+}
+
+double N01()      { return Normal(0, 1); }
+double Exp1()     { return Exponential(1); }
+double Gamma05()  { return Gamma(0.5, 2); }     // alfa < 1 (boost)
+double Gamma3()   { return Gamma(3, 1); }
+double Erlang4()  { return Erlang(0.5, 4); }
+double Poisson4() { return Poisson(4); }        // inversion
+double Poisson50(){ return Poisson(50); }       // PTRS
+double Binom20()  { return Binom(20, 0.3); }    // inversion
+double Binom1000(){ return Binom(1000, 0.4); }  // BTPE
+double Binom200() { return Binom(200, 0.7); }   // BTPE, p > 0.5
+
+int main()
+{
+    RandomSeed(1234);
+    const Exact normal = { 0, 1, 0, 3, 0.5 * std::erfc(3 / std::sqrt(2.0)) };
+    Check("Normal(0,1)", N01, normal);
+    const Exact exponential = { 1, 1, 2, 5, std::exp(-5.0) };
+    Check("Exponential(1)", Exp1, exponential);
+    // Gamma(0.5,2) is chi-square with 1 degree of freedom
+    const Exact gamma05 = { 1, 2, 2 * std::sqrt(2.0), 6, std::erfc(std::sqrt(3.0)) };
+    Check("Gamma(0.5,2)", Gamma05, gamma05);
+    const Exact gamma3 = { 3, 3, 2 / std::sqrt(3.0), 8, 41 * std::exp(-8.0) };
+    Check("Gamma(3,1)", Gamma3, gamma3);
+    // sum of 4 exponentials with mean 0.5: P(X>4) = P(Poisson(8) < 4)
+    const Exact erlang4 = { 2, 1, 1, 4, std::exp(-8.0) * (1 + 8 + 32 + 512 / 6.0) };
+    Check("Erlang(0.5,4)", Erlang4, erlang4);
+    Check("Poisson(4)", Poisson4, PoissonExact(4, 9));
+    Check("Poisson(50)", Poisson50, PoissonExact(50, 65));
+    Check("Binom(20,0.3)", Binom20, BinomExact(20, 0.3, 10));
+    Check("Binom(1000,0.4)", Binom1000, BinomExact(1000, 0.4, 440));
+    Check("Binom(200,0.7)", Binom200, BinomExact(200, 0.7, 155));
+}
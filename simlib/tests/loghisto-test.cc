@@ -0,0 +1,46 @@
+// LogHistogram: quantile error bound, auto-ranging, merge
+#include <simlib.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const double q[] = { 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 };
+
+// relative error of quantiles of n values (exact = ceil(q*n)-th value)
+void Check(unsigned digits)
+{
+    const unsigned long n = 100000;
+    LogHistogram h("h", 0.001, digits);
+    LogHistogram h1("h1", 0.001, digits), h2("h2", 0.001, digits);
+    std::vector<double> x(n);
+    for (unsigned long i = 0; i < n; i++) {
+        x[i] = 1 + Exponential(100);    // 1 .. ~1000: many bucket ranges
+        h(x[i]);
+        if (i % 2) h1(x[i]); else h2(x[i]);
+    }
+    std::sort(x.begin(), x.end());
+    double bound = std::pow(10.0, -double(digits));
+    Print("%u digits: %u bins, bound %g\n", digits, h.Count(), bound);
+    bool ok = true;
+    for (unsigned i = 0; i < sizeof(q) / sizeof(q[0]); i++) {
+        double exact = x[(unsigned long) std::ceil(q[i] * n) - 1];
+        double e = h.Quantile(q[i]);
+        double err = std::fabs(e - exact) / exact;
+        Print("  q %5g: exact %9.4f  estimate %9.4f  error %.2e  %s\n",
+              q[i], exact, e, err, err <= bound ? "ok" : "WRONG");
+        ok = ok && err <= bound;
+    }
+    h1.Merge(h2);
+    bool same = true;           // number of bins depends on growth
+    for (unsigned i = 0; same && i < h.Count() + h1.Count(); i++)
+        same = h1[i] == h[i];
+    Print("  all quantiles within bound: %s\n", ok ? "yes" : "NO");
+    Print("  merged halves: bins are %s\n", same ? "the same" : "DIFFERENT");
+}
+
+int main()
+{
+    RandomSeed(1234);
+    Check(2);
+    Check(3);
+}
@@ -0,0 +1,124 @@
+// Merge: Stat, TStat and Histogram merged from parts of a series equal
+// one object which records the whole series (counts exactly, moments
+// up to rounding); values with large offset (Welford accumulators)
+#include <simlib.h>
+#include <cmath>
+
+const unsigned long N = 100000;         // length of series
+const unsigned PARTS = 7;               // parts of different length
+
+// relative difference of a and b is at rounding level
+bool Near(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-9 * std::fabs(b) + 1e-12;
+}
+
+// part of series which contains value i
+unsigned Part(unsigned long i)
+{
+    return unsigned(i * i / N * PARTS / N);     // growing parts
+}
+
+void Result(const char *name, bool same)
+{
+    Print("  %-10s %s\n", name, same ? "the same" : "DIFFERENT");
+}
+
+void TestStat()
+{
+    RandomSeed(1234);
+    Stat whole, part[PARTS];
+    for (unsigned long i = 0; i < N; i++) {
+        double x = 1e6 + Normal(0, 1);
+        whole(x);
+        part[Part(i)](x);
+    }
+    Stat merged;
+    for (unsigned p = 0; p < PARTS; p++)
+        merged.Merge(part[p]);
+    Print("Stat: mean %.6f, std. deviation %.6f (1)\n",
+          whole.MeanValue(), whole.StdDev());
+    Result("number", merged.Number() == whole.Number());
+    Result("min, max", merged.Min() == whole.Min() && merged.Max() == whole.Max());
+    Result("mean", Near(merged.MeanValue(), whole.MeanValue()));
+    Result("std. dev.", Near(merged.StdDev(), whole.StdDev()));
+}
+
+void TestHistogram()
+{
+    RandomSeed(1234);
+    Histogram whole(0.0, 0.5, 20), *part[PARTS];
+    for (unsigned p = 0; p < PARTS; p++)
+        part[p] = new Histogram(0.0, 0.5, 20);
+    for (unsigned long i = 0; i < N; i++) {
+        double x = Exponential(2);
+        whole(x);
+        (*part[Part(i)])(x);
+    }
+    Histogram merged(0.0, 0.5, 20);
+    for (unsigned p = 0; p < PARTS; p++) {
+        merged.Merge(*part[p]);
+        delete part[p];
+    }
+    bool counts = true;
+    for (unsigned i = 0; i <= whole.Count() + 1; i++)   // with under/overflow
+        if (merged[i] != whole[i])
+            counts = false;
+    Print("Histogram: %lu values\n", whole.stat.Number());
+    Result("counts", counts);
+    Result("mean", Near(merged.stat.MeanValue(), whole.stat.MeanValue()));
+    Result("std. dev.", Near(merged.stat.StdDev(), whole.stat.StdDev()));
+}
+
+// TStat: value changes at random times, part p records from its start
+// to the start of next part
+TStat *Whole, *TPart[PARTS];
+
+class Changes : public Process {
+    void Behavior(void) {
+        unsigned p = 0;
+        for (unsigned long i = 0; i < N; i++) {
+            Wait(Exponential(1));
+            double x = 100 + Uniform(0, 10);
+            if (Part(i) != p) {                 // next part starts now
+                (*TPart[p])(TPart[p]->LastValue()); // close last period
+                p = Part(i);
+                TPart[p]->Clear(Whole->LastValue());
+            }
+            (*Whole)(x);
+            (*TPart[p])(x);
+        }
+        (*TPart[p])(TPart[p]->LastValue());
+        (*Whole)(Whole->LastValue());
+    }
+};
+
+void TestTStat()
+{
+    RandomSeed(1234);
+    Init(0);
+    Whole = new TStat(0.0);
+    for (unsigned p = 0; p < PARTS; p++)
+        TPart[p] = new TStat(0.0);
+    (new Changes)->Activate();
+    Run();
+    TStat merged;
+    for (unsigned p = 0; p < PARTS; p++) {
+        merged.Merge(*TPart[p]);
+        delete TPart[p];
+    }
+    Print("TStat: time %.3f, mean %.6f\n", Whole->Weight(),
+          Whole->Sum() / Whole->Weight());
+    Result("min, max", merged.Min() == Whole->Min() && merged.Max() == Whole->Max());
+    Result("time", Near(merged.Weight(), Whole->Weight()));
+    Result("sum x*t", Near(merged.Sum(), Whole->Sum()));
+    Result("sum x^2*t", Near(merged.SumSquare(), Whole->SumSquare()));
+    delete Whole;
+}
+
+int main()
+{
+    TestStat();
+    TestHistogram();
+    TestTStat();
+}
@@ -0,0 +1,57 @@
+// MultiLink: entity in Queue and in two HookLists at once
+#include <simlib.h>
+#include <multilink.h>
+
+class Order;
+typedef HookList<Order,0> AllOrders;
+typedef HookList<Order,1> UrgentOrders;
+
+AllOrders all;          // all open orders
+UrgentOrders urgent;    // urgent orders (priority)
+Facility F("F");
+
+class Order : public Process, public MultiLink<2> {
+    double service;
+    void Behavior(void) {
+        all.InsLast(this);
+        if (Priority > 0)
+            urgent.Insert(this);
+        Seize(F);       // can wait in queue F.Q1
+        Wait(service);
+        Release(F);
+        Unlink<1>();    // remove from urgent
+        Print("%4g: %s done, open %u, urgent %u\n",
+              Time, Name().c_str(), all.size(), urgent.size());
+    }   // destructor removes order from all
+  public:
+    Order(const char *name, Priority_t p, double t) : Process(p), service(t) {
+        SetName(name);
+    }
+};
+
+class Report : public Event {
+    void Behavior(void) {
+        Print("%4g: queue %u, open:", Time, F.QueueLen());
+        for (AllOrders::iterator i = all.begin(); i != all.end(); ++i)
+            Print(" %s", (*i)->Name().c_str());
+        Print(", urgent:");
+        for (UrgentOrders::iterator i = urgent.begin(); i != urgent.end(); ++i)
+            Print(" %s", (*i)->Name().c_str());
+        Print("\n");
+        Activate(Time + 2.5);
+    }
+};
+
+int main()
+{
+    //DebugON();
+    Init(0, 20);
+    (new Order("o1", 0, 3))->Activate(0);
+    (new Order("o2", 1, 3))->Activate(1);
+    (new Order("o3", 0, 3))->Activate(1);
+    (new Order("o4", 2, 3))->Activate(2);
+    (new Order("o5", 1, 3))->Activate(2);
+    (new Report)->Activate(0.5);
+    Run();
+    Print("open %u, urgent %u\n", all.size(), urgent.size());
+}
@@ -0,0 +1,188 @@
+// Optimization: parallel methods give the same result for any workers,
+// evaluation cache (memory, file of previous session, results of other
+// random numbers not used), other children of program are not reaped by
+// process workers
+#include <simlib.h>
+#include <optimize.h>
+#include <cmath>
+#include <cstdio>               // remove
+#include <sys/wait.h>
+#include <unistd.h>
+
+const char *FILENAME = "optimize-test.cache";
+
+// M/M/1 model created by each run (thread workers)
+struct Model {
+    Facility F;
+    Stat T;
+    double service;
+};
+
+class Customer : public Process {
+    Model *m;
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(m->F);
+        Wait(Exponential(m->service));
+        Release(m->F);
+        m->T(Time - t0);
+    }
+  public:
+    Customer(Model *model) : m(model) {}
+};
+
+class Generator : public Event {
+    Model *m;
+    void Behavior(void) {
+        (new Customer(m))->Activate();
+        Activate(Time + Exponential(1));
+    }
+  public:
+    Generator(Model *model) : m(model) {}
+};
+
+// cost: time in system + price of fast server + penalty of second parameter
+double Cost(const ParameterVector &p)
+{
+    Init(0, 1000);
+    Model m;                    // after Init: facility statistics
+    m.service = p[0];
+    (new Generator(&m))->Activate();
+    Run();
+    double k = p[1] - 0.4;
+    return m.T.MeanValue() + 0.3 / p[0] + 5 * k * k;
+}
+
+double Quadratic(const ParameterVector &p)
+{
+    return (p[0] - 3) * (p[0] - 3) + p[1] * p[1];
+}
+
+double SelectCost(const ParameterVector &p, unsigned long)
+{
+    return Cost(p);
+}
+
+struct Result {
+    double value;
+    double x[2];
+};
+
+Result Make(double v, const ParameterVector &p)
+{
+    Result r = { v, { p[0], p[1] } };
+    return r;
+}
+
+bool Same(const Result &a, const Result &b)
+{
+    return a.value == b.value && a.x[0] == b.x[0] && a.x[1] == b.x[1];
+}
+
+// run method with 1 and 4 threads and with processes
+void Test(const char *name, Result (*method) (const ParallelOptions &))
+{
+    ParallelOptions o;
+    o.threads = 1;
+    Result a = method(o);
+    o.threads = 4;
+    Result b = method(o);
+    o.fork = true;
+    pid_t other = fork();       // not a worker
+    if (other == 0)
+        _exit(7);
+    Result c = method(o);
+    int status = 0;
+    bool reaped = !(waitpid(other, &status, 0) == other &&
+                    WIFEXITED(status) && WEXITSTATUS(status) == 7);
+    Print("%s: f(%.6f, %.6f) = %.6f\n", name, a.x[0], a.x[1], a.value);
+    Print("%s: 4 threads %s, processes %s%s\n", name,
+          Same(a, b) ? "the same" : "DIFFERENT",
+          Same(a, c) ? "the same" : "DIFFERENT",
+          reaped ? " (other child REAPED)" : "");
+}
+
+Param pa[] = { Param("service", 0.1, 0.9), Param("k", 0, 1) };
+
+Result Hooke(const ParallelOptions &o)
+{
+    ParameterVector p(2, pa);
+    p[0] = 0.8;
+    p[1] = 0.9;
+    RandomSeed(1234);
+    double v = Optimize_hooke(Cost, p, 0.5, 1e-3, 30, o);
+    return Make(v, p);
+}
+
+Result Gradient(const ParallelOptions &o)
+{
+    ParameterVector p(2, pa);
+    p[0] = 0.8;
+    p[1] = 0.9;
+    RandomSeed(1234);
+    double v = Optimize_gradient(Cost, p, 30, o);
+    return Make(v, p);
+}
+
+Result Annealing(const ParallelOptions &o)
+{
+    ParameterVector p(2, pa);
+    p[0] = 0.8;
+    p[1] = 0.9;
+    RandomSeed(1234);
+    double v = Optimize_simann(Cost, p, 20, 8, o);
+    return Make(v, p);
+}
+
+int main()
+{
+    Test("hooke", Hooke);
+    Test("gradient", Gradient);
+    Test("simann", Annealing);
+    ParameterVector p(2, pa);   // sequential method
+    p[0] = 0.8;
+    p[1] = 0.9;
+    RandomSeed(1234);
+    double v = Optimize_gradient(Cost, p, 30);
+    Print("sequential gradient: f(%.6f, %.6f) = %.6f\n",
+          double(p[0]), double(p[1]), v);
+    Param pq[] = { Param("x", 0, 10), Param("y", 1, 1) };   // y is fixed
+    ParameterVector q(2, pq);
+    q[0] = 8;
+    q[1] = 1;
+    v = Optimize_gradient(Quadratic, q, 100);
+    Print("gradient, fixed parameter: f(%.3f, %g) = %.4f %s\n",
+          double(q[0]), double(q[1]), v, std::fabs(q[0] - 3) < 0.05 ? "ok" : "WRONG");
+
+    ParallelOptions o;
+    Result a = Hooke(o);
+    for (int session = 1; session <= 2; session++) {
+        EvaluationCache cache(1e-9, FILENAME);  // 2nd: results of 1st
+        SetEvaluationCache(&cache);
+        Result b = Hooke(o);
+        Print("cache session %d: %s, %lu results, %lu hits, %lu misses\n",
+              session, Same(a, b) ? "the same" : "DIFFERENT",
+              cache.Size(), cache.Hits(), cache.Misses());
+        SetEvaluationCache(0);
+    }
+    std::remove(FILENAME);
+
+    // replications of SelectBest() use other random numbers than Hooke()
+    EvaluationCache cache;
+    SetEvaluationCache(&cache);
+    std::vector<ParameterVector> c(2, ParameterVector(2, pa));
+    c[0][0] = 0.8;              // start point of Hooke()
+    c[0][1] = 0.9;
+    c[1][0] = 0.4;
+    c[1][1] = 0.4;
+    Stat s[2];
+    SelectionOptions so;
+    so.initial = 2;
+    so.budget = 4;
+    RandomSeed(1234);
+    SelectBest(SelectCost, c, s, so);
+    Result b = Hooke(o);
+    Print("cache after SelectBest: %s, %lu hits\n",
+          Same(a, b) ? "the same" : "DIFFERENT", cache.Hits());
+    SetEvaluationCache(0);
+}
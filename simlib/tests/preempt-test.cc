@@ -0,0 +1,74 @@
+// PreemptiveFacility: test of resume/restart/discard policies,
+// cancel of interrupted process
+#include <simlib.h>
+#include <preempt.h>
+
+PreemptiveFacility F("F");
+
+class Job : public Process {
+    ServicePriority_t sp;
+    double service;
+    void Behavior(void) {
+        Print("%4g: %s seize (sp=%u)\n", Time, Name().c_str(), (unsigned)sp);
+        Seize(F, sp);
+        Wait(service);
+        Print("%4g: %s release\n", Time, Name().c_str());
+        Release(F);
+    }
+  public:
+    Job(const char *name, ServicePriority_t s, double t) : sp(s), service(t) {
+        SetName(name);
+    }
+};
+
+// cancel process p at activation time
+class Killer : public Event {
+    Process *p;
+    void Behavior(void) {
+        Print("%4g: %s cancelled\n", Time, p->Name().c_str());
+        p->Cancel();
+    }
+  public:
+    Killer(Process *x) : p(x) {}
+};
+
+void Experiment(PreemptiveFacility::Policy_t p)
+{
+    static const char *names[] = { "RESUME", "RESTART", "DISCARD" };
+    Print("\n*** policy %s\n", names[p]);
+    Init(0, 100);
+    F.Clear();
+    F.SetPolicy(p);
+    (new Job("low1", 0, 10))->Activate(0);
+    (new Job("low2", 0, 10))->Activate(1);
+    (new Job("mid", 1, 5))->Activate(2);
+    (new Job("high", 2, 2))->Activate(3);
+    (new Job("mid2", 1, 1))->Activate(4);
+    Run();
+    F.Output();
+}
+
+void CancelTest()
+{
+    Print("\n*** cancel of interrupted process\n");
+    Init(0, 100);
+    F.Clear();
+    F.SetPolicy(PreemptiveFacility::PREEMPT_RESUME);
+    Job *low = new Job("low", 0, 10);
+    low->Activate(0);
+    (new Job("high", 2, 5))->Activate(1);
+    (new Killer(low))->Activate(2);   // interrupted, waits for resumption
+    Run();
+    Print("interrupted waiting: %u %s\n", F.InterruptedLen(),
+          F.InterruptedLen() == 0 ? "ok" : "WRONG");
+    F.Output();
+}
+
+int main()
+{
+    //DebugON();
+    Experiment(PreemptiveFacility::PREEMPT_RESUME);
+    Experiment(PreemptiveFacility::PREEMPT_RESTART);
+    Experiment(PreemptiveFacility::PREEMPT_DISCARD);
+    CancelTest();
+}
@@ -0,0 +1,50 @@
+// QuantileStat: waiting time percentiles of M/M/1 queue, merge of digests,
+// values recorded through Stat&
+#include <simlib.h>
+
+Queue Q("Q");
+Facility F("F", &Q);
+QuantileStat Wait("waiting time");
+QuantileStat Total("waiting time (all runs)");
+
+class Customer : public Process {
+    void Behavior(void) {
+        Seize(F);
+        Wait(Exponential(0.8));
+        Release(F);
+    }
+};
+
+class Generator : public Event {
+    void Behavior(void) {
+        (new Customer)->Activate();
+        Activate(Time + Exponential(1));
+    }
+};
+
+int main()
+{
+    //DebugON();
+    RandomSeed(12345);
+    for (int i = 0; i < 3; i++) {
+        Init(0, 10000);
+        F.Clear();
+        Q.SetWaitQuantiles(&Wait);
+        Q.Clear();              // clears also Wait
+        (new Generator)->Activate();
+        Run();
+        Print("run %d: p50 = %g, p99 = %g\n", i, Wait.Median(), Wait.Quantile(0.99));
+        Total.Merge(Wait);
+    }
+    F.Output();
+    Q.Output();
+    Total.Output();
+
+    // values recorded through Stat& are in digest (virtual operator ())
+    QuantileStat q;
+    Stat &s = q;
+    for (int i = 1; i <= 100; i++)
+        s(i);
+    Print("recorded as Stat: n = %lu, median = %g %s\n", q.Number(),
+          q.Median(), q.Median() > 49 && q.Median() < 52 ? "ok" : "WRONG");
+}
@@ -0,0 +1,65 @@
+// RunReplications: parallel replications, results merged in fixed order
+#include <simlib.h>
+
+Stat Means("mean time in system (replications)");
+Histogram Times("time in system (all customers)", 0.0, 2, 10);
+
+class Customer : public Process {
+    Facility &F;
+    Histogram &H;
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(F);
+        Wait(Exponential(0.8));
+        Release(F);
+        H(Time - t0);
+    }
+  public:
+    Customer(Facility &f, Histogram &h) : F(f), H(h) {}
+};
+
+class Generator : public Event {
+    Facility &F;
+    Histogram &H;
+    void Behavior(void) {
+        (new Customer(F, H))->Activate();
+        Activate(Time + Exponential(1));
+    }
+  public:
+    Generator(Facility &f, Histogram &h) : F(f), H(h) {}
+};
+
+// one replication: model objects are local
+void Replication(unsigned long)
+{
+    Facility F;
+    Histogram *h = new Histogram(0.0, 2, 10);
+    Init(0, 1000);
+    F.Clear();
+    (new Generator(F, *h))->Activate();
+    Run();
+    ReplicationMerge(Means, h->stat.MeanValue());
+    ReplicationMerge(Times, h);
+}
+
+int main()
+{
+    double m[3];
+    unsigned long n[3];
+    const unsigned threads[3] = { 1, 3, 8 };
+    for (int i = 0; i < 3; i++) {
+        Means.Clear();
+        Times.Clear();
+        RandomSeed(12345);
+        RunReplications(20, threads[i], Replication);
+        m[i] = Means.MeanValue();
+        n[i] = Times.stat.Number();
+    }
+    for (int i = 0; i < 3; i++)
+        Print("threads %u: mean %.10g, customers %lu\n", threads[i], m[i], n[i]);
+    Print("results are %s\n",
+          m[0] == m[1] && m[1] == m[2] && n[0] == n[1] && n[1] == n[2] ?
+          "the same" : "DIFFERENT");
+    Means.Output();
+    Times.Output();
+}
@@ -0,0 +1,101 @@
+// Ranking and selection: OCBA allocates replications to close candidates,
+// equal candidates: budget or indifference zone ends selection
+#include <simlib.h>
+#include <optimize.h>
+#include <vector>
+
+// M/M/1 model created by each run (thread workers)
+struct Model {
+    Facility F;
+    Stat T;
+    double service;
+};
+
+class Customer : public Process {
+    Model *m;
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(m->F);
+        Wait(Exponential(m->service));
+        Release(m->F);
+        m->T(Time - t0);
+    }
+  public:
+    Customer(Model *model) : m(model) {}
+};
+
+class Generator : public Event {
+    Model *m;
+    void Behavior(void) {
+        (new Customer(m))->Activate();
+        Activate(Time + Exponential(1));
+    }
+  public:
+    Generator(Model *model) : m(model) {}
+};
+
+// cost: time in system + price of fast server
+double Cost(const ParameterVector &p, unsigned long)
+{
+    Init(0, 200);
+    Model m;                    // after Init: facility statistics
+    m.service = p[0];
+    (new Generator(&m))->Activate();
+    Run();
+    return m.T.MeanValue() + 0.3 / p[0];
+}
+
+const int K = 6;
+const double service[K] = { 0.2, 0.3, 0.35, 0.4, 0.6, 0.8 };
+
+unsigned Select(unsigned threads, Stat *s, double &pcs)
+{
+    Param pa[] = { Param("service", 0.1, 0.9) };
+    std::vector<ParameterVector> c;
+    for (int i = 0; i < K; i++) {
+        ParameterVector p(1, pa);
+        p[0] = service[i];
+        c.push_back(p);
+    }
+    SelectionOptions o;
+    o.pcs = 0.95;
+    o.threads = threads;
+    RandomSeed(1234);
+    return SelectBest(Cost, c, s, o, &pcs);
+}
+
+int main()
+{
+    Stat a[K], b[K];
+    double pa, pb;
+    unsigned ba = Select(1, a, pa);
+    unsigned bb = Select(4, b, pb);
+    Print("best: service %g, PCS %.4f\n", service[ba], pa);
+    unsigned long total = 0;
+    bool same = ba == bb && pa == pb;
+    for (int i = 0; i < K; i++) {
+        Print("  service %4g: %4lu replications, mean %.5f +- %.5f\n",
+              service[i], a[i].Number(), a[i].MeanValue(), a[i].StdDev());
+        total += a[i].Number();
+        same = same && a[i].Number() == b[i].Number()
+                    && a[i].MeanValue() == b[i].MeanValue();
+    }
+    Print("total %lu replications\n", total);
+    Print("4 threads: results are %s\n", same ? "the same" : "DIFFERENT");
+
+    // two equal candidates: PCS stays 0.5 until budget is spent (warning)
+    Param pe[] = { Param("service", 0.1, 0.9) };
+    std::vector<ParameterVector> c(2, ParameterVector(1, pe));
+    c[0][0] = c[1][0] = 0.4;
+    for (int zone = 0; zone < 2; zone++) {
+        SelectionOptions o;
+        o.indifference = zone ? 0.05 : 0;
+        Stat e[2];
+        double pcs;
+        RandomSeed(1234);
+        unsigned best = SelectBest(Cost, c, e, o, &pcs);
+        Print("equal candidates, indifference %g: best %u, PCS %.4f, "
+              "%lu replications\n", o.indifference, best, pcs,
+              e[0].Number() + e[1].Number());
+    }
+}
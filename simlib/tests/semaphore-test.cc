@@ -0,0 +1,82 @@
+// Semaphore: counting semaphore P(k)/V(k), large Barrier with resizing
+#include <simlib.h>
+
+Semaphore S("S", 3, 5);         // initial value 3, limit 5
+Barrier B("B", 2000);
+
+class User : public Process {
+    unsigned k;
+    void Behavior(void) {
+        Print("%4g: %s P(%u)\n", Time, Name().c_str(), k);
+        S.P(k);
+        Print("%4g: %s got %u, value %d\n", Time, Name().c_str(), k, S.Value());
+        Wait(2);
+        S.V(k);
+    }
+  public:
+    User(const char *name, unsigned n) : k(n) { SetName(name); }
+};
+
+// activates waiting process (not by V), it has to wait again
+class Wake : public Event {
+    Process *p;
+    void Behavior(void) {
+        Print("%4g: activate %s\n", Time, p->Name().c_str());
+        p->Activate();
+    }
+  public:
+    Wake(Process *process) : p(process) {}
+};
+
+unsigned passed = 0;            // number of processes after barrier
+
+class Member : public Process {
+    void Behavior(void) {
+        B.Wait();
+        ++passed;
+    }
+};
+
+class Resize : public Event {
+    void Behavior(void) {
+        Print("%4g: waiting %u, change height to 1000\n", Time, B.Waiting());
+        B.ChangeHeight(1000);   // breaks the barrier
+        Print("%4g: waiting %u\n", Time, B.Waiting());
+    }
+};
+
+int main()
+{
+    //DebugON();
+    Init(0, 20);
+    (new User("u1", 2))->Activate(0);
+    (new User("u2", 3))->Activate(1);   // waits for u1
+    (new User("u3", 1))->Activate(1);   // waits (FIFO, no overtaking)
+    (new User("u4", 3))->Activate(2);
+    Run();
+    S.Output();
+
+    Init(0, 20);
+    (new User("u5", 3))->Activate(0);
+    User *u6 = new User("u6", 2);
+    u6->Activate(1);                    // waits for u5
+    (new Wake(u6))->Activate(1.5);
+    Run();
+    S.Output();
+
+    Init(0, 20);                        // woken process keeps its place
+    (new User("u7", 3))->Activate(0);
+    User *u8 = new User("u8", 2);
+    u8->Activate(1);                    // first in queue
+    (new User("u9", 2))->Activate(1);
+    (new Wake(u8))->Activate(1.5);
+    Run();                              // u8 gets units before u9
+    S.Output();
+
+    Init(0, 20);
+    for (unsigned i = 0; i < 1500; ++i)
+        (new Member)->Activate(i * 0.01);
+    (new Resize)->Activate(18);
+    Run();
+    Print("passed %u, waiting %u\n", passed, B.Waiting());
+}
@@ -0,0 +1,174 @@
+// Sweep: designs, parallel jobs (threads, processes), resume from file,
+// evaluation cache (also for parameters with different ranges)
+#include <simlib.h>
+#include <optimize.h>
+#include <cstdio>
+#include <string>
+
+const char *FILENAME = "sweep-test.dat";
+
+// M/M/1 model created by each run (thread workers)
+struct Model {
+    Facility F;
+    Stat T;
+    double service;
+};
+
+class Customer : public Process {
+    Model *m;
+    void Behavior(void) {
+        double t0 = Time;
+        Seize(m->F);
+        Wait(Exponential(m->service));
+        Release(m->F);
+        m->T(Time - t0);
+    }
+  public:
+    Customer(Model *model) : m(model) {}
+};
+
+class Generator : public Event {
+    Model *m;
+    void Behavior(void) {
+        (new Customer(m))->Activate();
+        Activate(Time + Exponential(1));
+    }
+  public:
+    Generator(Model *model) : m(model) {}
+};
+
+// mean time in system for given service time, plus constant cost
+double Run1(const ParameterVector &p, unsigned long)
+{
+    Init(0, 500);
+    Model m;                    // after Init: facility statistics
+    m.service = p[0];
+    (new Generator(&m))->Activate();
+    Run();
+    return m.T.MeanValue() + p[1];
+}
+
+double Half(const ParameterVector &p, unsigned long)
+{
+    return p[0] / 2;
+}
+
+void Print1(const char *title, const std::vector<SweepPoint> &r)
+{
+    Print("%s\n", title);
+    for (size_t i = 0; i < r.size(); i++) {
+        Print("  %8.5f %8.5f :", r[i].x[0], r[i].x[1]);
+        for (size_t k = 0; k < r[i].y.size(); k++)
+            Print(" %9.5f", r[i].y[k]);
+        Print("\n");
+    }
+}
+
+bool Same(const std::vector<SweepPoint> &a, const std::vector<SweepPoint> &b)
+{
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].x != b[i].x || a[i].y != b[i].y)
+            return false;
+    return a.size() == b.size();
+}
+
+int main()
+{
+    Param pa[] = { Param("service", 0.3, 0.9), Param("cost", 0, 1) };
+    ParameterVector p(2, pa);
+
+    std::vector<std::vector<double> > g = SweepPoints(p, SWEEP_SOBOL, 3);
+    for (size_t i = 0; i < g.size(); i++)
+        Print("sobol %lu: %g %g\n", (unsigned long) i, g[i][0], g[i][1]);
+    g = SweepPoints(p, SWEEP_GRID, 3);
+    Print("grid: %lu points, last %g %g\n", (unsigned long) g.size(),
+          g.back()[0], g.back()[1]);
+
+    SweepOptions o;
+    o.design = SWEEP_SOBOL;
+    o.points = 8;
+    o.replications = 3;
+    o.threads = 4;
+    o.file = FILENAME;
+    RandomSeed(1234);
+    std::vector<SweepPoint> a = Sweep(Run1, p, o);
+    Print1("sobol design, 4 threads", a);
+
+    o.threads = 1;
+    o.file = 0;
+    RandomSeed(1234);
+    std::vector<SweepPoint> b = Sweep(Run1, p, o);
+    Print("1 thread: results are %s\n", Same(a, b) ? "the same" : "DIFFERENT");
+
+    // interrupted sweep: header + 10 jobs + incomplete line
+    FILE *f = std::fopen(FILENAME, "r");
+    std::string s;
+    int c, lines = 0;
+    while ((c = std::fgetc(f)) != EOF && lines < 12) {
+        s += char(c);
+        if (c == '\n')
+            lines++;
+    }
+    std::fclose(f);
+    f = std::fopen(FILENAME, "w");
+    std::fputs((s + "3\t1\t0.5").c_str(), f);
+    std::fclose(f);
+    o.file = FILENAME;
+    o.resume = true;
+    o.threads = 2;
+    RandomSeed(1234);
+    std::vector<SweepPoint> r = Sweep(Run1, p, o);
+    Print("resumed: results are %s\n", Same(a, r) ? "the same" : "DIFFERENT");
+    // old lines kept, incomplete line removed, 14 lines appended
+    f = std::fopen(FILENAME, "r");
+    std::string t;
+    lines = 0;
+    while ((c = std::fgetc(f)) != EOF) {
+        t += char(c);
+        if (c == '\n')
+            lines++;
+    }
+    std::fclose(f);
+    Print("resumed: file %s, %d lines\n",
+          t.compare(0, s.size(), s) == 0 ? "appended" : "REWRITTEN", lines);
+
+    o.fork = true;
+    o.file = 0;
+    o.resume = false;
+    RandomSeed(1234);
+    std::vector<SweepPoint> k = Sweep(Run1, p, o);
+    Print("processes: results are %s\n", Same(a, k) ? "the same" : "DIFFERENT");
+    std::remove(FILENAME);
+
+    EvaluationCache cache;      // the second sweep is not run
+    SetEvaluationCache(&cache);
+    o.fork = false;
+    for (int i = 0; i < 2; i++) {
+        RandomSeed(1234);
+        std::vector<SweepPoint> c = Sweep(Run1, p, o);
+        Print("cached: results are %s, %lu hits, %lu misses\n",
+              Same(a, c) ? "the same" : "DIFFERENT",
+              cache.Hits(), cache.Misses());
+    }
+    SetEvaluationCache(0);
+
+    // the same x in ranges 0..10 and 0..20: points 0 5 10, then 0 10 20
+    EvaluationCache c2;
+    SetEvaluationCache(&c2);
+    SweepOptions h;
+    h.points = 3;
+    h.threads = 1;
+    const double max[2] = { 10, 20 };
+    for (int i = 0; i < 2; i++) {
+        Param ph[] = { Param("x", 0, max[i]) };
+        ParameterVector q(1, ph);
+        RandomSeed(1234);
+        std::vector<SweepPoint> r = Sweep(Half, q, h);
+        bool ok = true;
+        for (size_t j = 0; j < r.size(); j++)
+            ok = ok && r[j].y[0] == r[j].x[0] / 2;
+        Print("range 0..%g: f(x)=x/2 %s, %lu hits\n", max[i],
+              ok ? "ok" : "WRONG", c2.Hits());
+    }
+    SetEvaluationCache(0);
+}
@@ -0,0 +1,121 @@
+// TStatRecorder: windows of known piecewise constant value, file output,
+// partial window written in the middle of run
+#include <simlib.h>
+#include <cmath>
+#include <cstdio>
+
+const char *FILENAME = "tstat-recorder-test.dat";
+
+// value: 2 (0-5), 4 (5-15), 0 (15-27), 6 (27-31), 1 (31-44), 3 (44-50)
+const double change[][2] = { {5, 4}, {15, 0}, {27, 6}, {31, 1}, {44, 3} };
+
+// expected windows of width 10: start mean min max
+const TStatRecorder::Window expected[] = {
+    {  0, 3.0, 2, 4 },
+    { 10, 2.0, 0, 4 },
+    { 20, 1.8, 0, 6 },
+    { 30, 1.5, 1, 6 },
+    { 40, 2.2, 1, 3 },
+};
+
+// expected file after Flush(true) at time 25
+const TStatRecorder::Window expected_partial[] = {
+    {  0, 3.0, 2, 4 },
+    { 10, 2.0, 0, 4 },
+    { 20, 0.0, 0, 0 },
+    { 25, 3.6, 0, 6 },          // rest of window is not repeated
+    { 30, 1.5, 1, 6 },
+    { 40, 2.2, 1, 3 },
+};
+
+class Changes : public Process {
+    TStat *s;
+    void Behavior(void) {
+        for (unsigned i = 0; i < sizeof(change) / sizeof(change[0]); i++) {
+            Wait(change[i][0] - Time);
+            (*s)(change[i][1]);
+        }
+    }
+  public:
+    Changes(TStat *stat) : s(stat) {}
+};
+
+bool Same(const TStatRecorder::Window &a, const TStatRecorder::Window &b)
+{
+    return std::fabs(a.start - b.start) < 1e-9 && std::fabs(a.mean - b.mean) < 1e-9
+        && a.min == b.min && a.max == b.max;
+}
+
+void Check(const char *title, const TStatRecorder::Window &w,
+           const TStatRecorder::Window &e)
+{
+    Print("  %s: %g %g %g %g  %s\n", title, w.start, w.mean, w.min, w.max,
+          Same(w, e) ? "ok" : "WRONG");
+}
+
+// write partial window at activation time
+class PartialFlush : public Event {
+    TStatRecorder *r;
+    void Behavior(void) { r->Flush(true); }
+  public:
+    PartialFlush(TStatRecorder *x) : r(x) {}
+};
+
+// run model with recorder attached to value
+void Experiment(TStatRecorder &r, double flush = -1)
+{
+    Init(0, 50);
+    TStat T("value", 2);        // after Init: starts at time 0
+    T.SetRecorder(&r);
+    (new Changes(&T))->Activate();
+    if (flush > 0)
+        (new PartialFlush(&r))->Activate(flush);
+    Run();
+    r.Flush(true);              // close the last window at time 50
+    T.SetRecorder(0);
+}
+
+// check lines of output file
+void ReadFile(const TStatRecorder::Window *e, unsigned lines)
+{
+    FILE *f = std::fopen(FILENAME, "r");
+    TStatRecorder::Window w;
+    unsigned n = 0;
+    while (f && n < lines && std::fscanf(f, "%lg %lg %lg %lg", &w.start,
+                                         &w.mean, &w.min, &w.max) == 4) {
+        Check("file", w, e[n]);
+        n++;
+    }
+    Print("  %u lines\n", n);
+    if (f)
+        std::fclose(f);
+    std::remove(FILENAME);
+}
+
+int main()
+{
+    Print("buffer of 3 windows, no file:\n");
+    TStatRecorder a("a", 10, 3);
+    a.SetOutput(0);             // the same as ""
+    Experiment(a);
+    Print("  %u windows\n", a.Count());
+    for (unsigned i = 0; i < a.Count(); i++)
+        Check("window", a[i], expected[i + 2]); // the oldest are overwritten
+
+    Print("buffer of 2 windows, output file:\n");
+    {
+        TStatRecorder b("b", 10, 2);
+        b.SetOutput(FILENAME);
+        Experiment(b);
+        Print("  %u windows in buffer\n", b.Count());
+    }                           // closes the file
+    ReadFile(expected, 5);
+
+    Print("output file, Flush(true) at time 25:\n");
+    {
+        TStatRecorder c("c", 10, 2);
+        c.SetOutput(FILENAME);
+        Experiment(c, 25);
+    }
+    ReadFile(expected_partial, 6);
+}
@@ -0,0 +1,85 @@
+// WarmupDetector: MSER-5 truncation point of known transient,
+// ResetStatistics at the end of warm-up period
+#include <simlib.h>
+#include <cmath>
+#include <thread>
+
+const unsigned long N = 2000;   // length of series
+const unsigned long W = 200;    // length of initial transient
+
+WarmupDetector *D;
+Stat *S;
+double reset_time = -1;         // ResetStatistics after value at this time
+
+// step: 10 during warm-up, then 0 (value i recorded at time i+1)
+class Series : public Process {
+    void Behavior(void) {
+        for (unsigned long i = 0; i < N; i++) {
+            Wait(1);
+            double x = i < W ? 10 : 0;
+            (*D)(x);
+            (*S)(x);
+            if (Time == reset_time)
+                ResetStatistics();
+        }
+    }
+};
+
+void Experiment()
+{
+    Init(0, N + 1);
+    D->Clear();
+    (new Series)->Activate();
+    Run();
+}
+
+int main()
+{
+    D = new WarmupDetector("step", 1000);
+    S = new Stat("series");
+    Experiment();
+    Print("step at %lu: truncation %lu, warm-up time %g, detected %s\n",
+          W, D->Truncation(), D->WarmupTime(), D->Detected() ? "yes" : "no");
+    Print("  truncation is %s\n", D->Truncation() == W ? "exact" : "WRONG");
+
+    reset_time = D->WarmupTime();
+    Experiment();
+    Print("reset at %g: %lu values, mean %g, max %g\n", reset_time,
+          S->Number(), S->MeanValue(), S->Max());
+
+    // decaying transient 10*exp(-i/100) with noise, batches are merged
+    RandomSeed(1234);
+    WarmupDetector d("exp", 100);
+    Stat all, rest;
+    double x[5000];
+    for (unsigned long i = 0; i < 5000; i++) {
+        x[i] = 10 * std::exp(-(i / 100.0)) + Normal(0, 1);
+        d(x[i]);
+        all(x[i]);
+    }
+    for (unsigned long i = d.Truncation(); i < 5000; i++)
+        rest(x[i]);
+    Print("exponential transient: %u batches of %lu, truncation %lu %s\n",
+          d.Batches(), d.BatchSize(), d.Truncation(),
+          d.Truncation() >= 200 && d.Truncation() <= 800 ? "ok" : "WRONG");
+    Print("  mean %.4f (all values), %.4f (after truncation)\n",
+          all.MeanValue(), rest.MeanValue());
+    delete S;
+    delete D;
+
+    // registry: ResetStatistics clears objects of its thread only,
+    // object can be deleted by other thread
+    Stat *other = 0;
+    std::thread([&other] { other = new Stat("other"); (*other)(1); }).join();
+    Stat a("a");
+    a(1);
+    {
+        Stat b("b");            // unlinked from the middle of list
+        b(2);
+    }
+    ResetStatistics();
+    Print("registry: this thread %s, other thread %s\n",
+          a.Number() == 0 ? "ok" : "WRONG",
+          other->Number() == 1 ? "ok" : "WRONG");
+    delete other;
+}